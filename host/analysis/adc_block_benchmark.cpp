@@ -0,0 +1,365 @@
+/*
+ * Throughput of the block entry points against the per-sample loop, on oversampled raw ADC frames.
+ *
+ * A DMA half-buffer holds one PWM period of interleaved uint16_t phase current frames (A, B, C). Each case processes
+ * the same buffers with the per-sample API called in a loop, as an application does today, and with the block API:
+ * - calibration and Clarke transform;
+ * - first-order low-pass filter on alpha and beta;
+ * - decimation to one calibrated frame per period, float mean of the calibrated samples against the moving-average
+ *   decimator on the raw counts;
+ * - third-order CIC decimation, the calibrated samples convolved with three cascaded boxcars (the CIC impulse response)
+ *   at every output against the CIC decimator on the raw counts. Their start-up transients differ (zero calibrated
+ *   current against zero counts), so the error is taken once the 3 * FRAMES - 2 frame window is full;
+ * - the whole chain, calibration, Clarke transform and low-pass filters.
+ * Both versions of a case are checked against each other before timing. Each half-buffer is processed by a
+ * non-inlined function, as it would be from the DMA interrupt.
+ *
+ * Usage: zspinlab_adc_block_benchmark [half-buffers]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "math/adc/adc_block.hpp"
+#include "math/filter/decimator/cic_decimator.hpp"
+#include "math/math_core.hpp"
+
+#define NOINLINE __attribute__((noinline))
+
+using namespace zspinlab::math;
+
+// Frames per half-buffer, 16x oversampling of the PWM period
+constexpr size_t FRAMES = 16;
+
+// Phase current sensor calibration: mid-scale offset, 10 mA per count, a few counts of mismatch between phases
+static const type::AbcCalibration CAL = {{2047.0f, 0.0100f}, {2049.5f, 0.0101f}, {2046.0f, 0.0099f}};
+
+// Work buffers of one case
+struct Buffers
+{
+    float alpha[FRAMES];
+    float beta[FRAMES];
+    float decimated[3 * FRAMES];
+};
+
+/**
+ * @brief Calibrate and Clarke transform, per-sample loop
+ *
+ * @return None
+ **/
+static NOINLINE void clarke_per_sample(const uint16_t *raw, size_t frames, Buffers &buf)
+{
+    for (size_t i = 0; i < frames; i++) {
+        const float iA = (raw[3 * i + 0] - CAL.a.offset) * CAL.a.gain;
+        const float iB = (raw[3 * i + 1] - CAL.b.offset) * CAL.b.gain;
+        const float iC = (raw[3 * i + 2] - CAL.c.offset) * CAL.c.gain;
+
+        function::clarke_transform<true>(iA, iB, iC, buf.alpha[i], buf.beta[i]);
+    }
+}
+
+static NOINLINE void clarke_block(const uint16_t *raw, size_t frames, Buffers &buf)
+{
+    function::adc_clarke_transform_block<true>(raw, frames, CAL, buf.alpha, buf.beta);
+}
+
+/**
+ * @brief Low-pass filter alpha and beta in place, per-sample loop
+ *
+ * @return None
+ **/
+static NOINLINE void lpf_per_sample(modules::LowPassFirstOrder (&lpf)[2], size_t frames, Buffers &buf)
+{
+    for (size_t i = 0; i < frames; i++) {
+        buf.alpha[i] = lpf[0].run(buf.alpha[i]);
+        buf.beta[i] = lpf[1].run(buf.beta[i]);
+    }
+}
+
+static NOINLINE void lpf_block(modules::LowPassFirstOrder (&lpf)[2], size_t frames, Buffers &buf)
+{
+    modules::LowPassFirstOrder::run_block(lpf, {buf.alpha, buf.beta}, {buf.alpha, buf.beta}, frames);
+}
+
+/**
+ * @brief Decimate to one calibrated frame, mean of the calibrated samples
+ *
+ * @return None
+ **/
+static NOINLINE void decimate_per_sample(const uint16_t *raw, size_t frames, Buffers &buf)
+{
+    const type::AdcCalibration cal[3] = {CAL.a, CAL.b, CAL.c};
+    float sum[3] = {};
+
+    for (size_t i = 0; i < frames; i++) {
+        for (size_t ch = 0; ch < 3; ch++) {
+            sum[ch] += (raw[3 * i + ch] - cal[ch].offset) * cal[ch].gain;
+        }
+    }
+    for (size_t ch = 0; ch < 3; ch++) {
+        buf.decimated[ch] = sum[ch] / frames;
+    }
+}
+
+// Per-sample third-order CIC, three cascaded FRAMES long boxcars
+struct Cic3Reference
+{
+    static constexpr size_t TAPS = 3 * FRAMES - 2;
+
+    float weight[TAPS];         // Impulse response normalized by FRAMES^3, weight[0] on the oldest sample
+    float history[3][2 * TAPS]; // Calibrated samples of each channel, circular and mirrored so a window is contiguous
+    size_t oldest = 0;          // Index of the oldest sample in history
+    size_t phase = 0;           // Input frames since the last output
+
+    Cic3Reference(void) : history()
+    {
+        // Convolve the boxcar with itself twice
+        float box2[2 * FRAMES - 1] = {};
+
+        for (size_t i = 0; i < FRAMES; i++) {
+            for (size_t j = 0; j < FRAMES; j++) {
+                box2[i + j] += 1.0f;
+            }
+        }
+        for (size_t i = 0; i < TAPS; i++) {
+            weight[i] = 0.0f;
+        }
+        for (size_t i = 0; i < 2 * FRAMES - 1; i++) {
+            for (size_t j = 0; j < FRAMES; j++) {
+                weight[i + j] += box2[i] / (FRAMES * FRAMES * FRAMES);
+            }
+        }
+    }
+};
+
+/**
+ * @brief Third-order CIC decimation, per-sample loop: calibrate every sample, convolve at every output
+ *
+ * @return None
+ **/
+static NOINLINE void cic3_per_sample(Cic3Reference &cic, const uint16_t *raw, size_t frames, Buffers &buf)
+{
+    const type::AdcCalibration cal[3] = {CAL.a, CAL.b, CAL.c};
+    size_t outputs = 0;
+
+    for (size_t i = 0; i < frames; i++) {
+        for (size_t ch = 0; ch < 3; ch++) {
+            const float sample = (raw[3 * i + ch] - cal[ch].offset) * cal[ch].gain;
+
+            cic.history[ch][cic.oldest] = sample;
+            cic.history[ch][cic.oldest + Cic3Reference::TAPS] = sample;
+        }
+        cic.oldest = (cic.oldest + 1 < Cic3Reference::TAPS) ? cic.oldest + 1 : 0;
+
+        if (++cic.phase < FRAMES) {
+            continue;
+        }
+        cic.phase = 0;
+
+        for (size_t ch = 0; ch < 3; ch++) {
+            const float *window = &cic.history[ch][cic.oldest];
+            float sum = 0.0f;
+
+            for (size_t j = 0; j < Cic3Reference::TAPS; j++) {
+                sum += cic.weight[j] * window[j];
+            }
+            buf.decimated[3 * outputs + ch] = sum;
+        }
+        outputs++;
+    }
+}
+
+template <class Decimator>
+static NOINLINE void decimate_block(Decimator &decimator, const uint16_t *raw, size_t frames, Buffers &buf)
+{
+    decimator.run_block(raw, frames, buf.decimated);
+}
+
+/**
+ * @brief Whole chain, calibration, Clarke transform and low-pass filters, per-sample loop
+ *
+ * @return None
+ **/
+static NOINLINE void chain_per_sample(modules::LowPassFirstOrder (&lpf)[2],
+                                      const uint16_t *raw,
+                                      size_t frames,
+                                      Buffers &buf)
+{
+    for (size_t i = 0; i < frames; i++) {
+        const float iA = (raw[3 * i + 0] - CAL.a.offset) * CAL.a.gain;
+        const float iB = (raw[3 * i + 1] - CAL.b.offset) * CAL.b.gain;
+        const float iC = (raw[3 * i + 2] - CAL.c.offset) * CAL.c.gain;
+        float i_alpha, i_beta;
+
+        function::clarke_transform<true>(iA, iB, iC, i_alpha, i_beta);
+        buf.alpha[i] = lpf[0].run(i_alpha);
+        buf.beta[i] = lpf[1].run(i_beta);
+    }
+}
+
+static NOINLINE void chain_block(modules::LowPassFirstOrder (&lpf)[2], const uint16_t *raw, size_t frames, Buffers &buf)
+{
+    function::adc_clarke_transform_block<true>(raw, frames, CAL, buf.alpha, buf.beta);
+    modules::LowPassFirstOrder::run_block(lpf, {buf.alpha, buf.beta}, {buf.alpha, buf.beta}, frames);
+}
+
+/**
+ * @brief Time a half-buffer function over all the half-buffers, best of a few runs
+ * @param[in] raw     Raw half-buffers, back to back
+ * @param[in] buffers Number of half-buffers
+ * @param[in] process Half-buffer function
+ *
+ * @return Million frames per second
+ */
+template <class Process>
+static double throughput(const std::vector<uint16_t> &raw, size_t buffers, Process process)
+{
+    double best = 0.0;
+
+    for (int run = 0; run < 5; run++) {
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t k = 0; k < buffers; k++) {
+            process(raw.data() + 3 * FRAMES * k);
+        }
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        best = std::max(best, FRAMES * buffers / elapsed.count() * 1e-6);
+    }
+    return best;
+}
+
+/**
+ * @brief Max absolute difference of the alpha and beta outputs of two versions
+ *
+ * @return Max difference
+ */
+static float max_difference(const Buffers &ref, const Buffers &out, size_t frames)
+{
+    float error = 0.0f;
+
+    for (size_t i = 0; i < frames; i++) {
+        error = std::max({error, std::fabs(ref.alpha[i] - out.alpha[i]), std::fabs(ref.beta[i] - out.beta[i])});
+    }
+    return error;
+}
+
+/**
+ * @brief Print one case
+ *
+ * @return None
+ */
+static void print(const char *name, double per_sample, double block, float error)
+{
+    printf("%-22s %10.1f %10.1f %7.2fx %10.2e\n", name, per_sample, block, block / per_sample, static_cast<double>(error));
+}
+
+int main(int argc, char **argv)
+{
+    const size_t buffers = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 200000;
+
+    // 12-bit phase currents, 10 A amplitude, 20 PWM periods per electrical period, a few counts of noise
+    std::vector<uint16_t> raw(3 * FRAMES * buffers);
+    std::mt19937 rng(1);
+    std::normal_distribution<float> noise(0.0f, 3.0f);
+
+    for (size_t n = 0; n < FRAMES * buffers; n++) {
+        const float theta = 2.0f * static_cast<float>(M_PI) * 0.05f * n / FRAMES;
+
+        for (size_t ch = 0; ch < 3; ch++) {
+            const float current = 10.0f * std::cos(theta - 2.0f * static_cast<float>(M_PI) / 3.0f * ch);
+            const float count = 2048.0f + current / 0.01f + noise(rng);
+
+            raw[3 * n + ch] = static_cast<uint16_t>(std::clamp(count, 0.0f, 4095.0f));
+        }
+    }
+
+    const type::AdcCalibration cal[3] = {CAL.a, CAL.b, CAL.c};
+    const type::FirstOrderCoefficients<float> coeffs = function::lowpass_first_order(2000.0f, 320000.0f);
+
+    modules::MovingAverageDecimator<FRAMES, 3> average;
+    modules::CicDecimator<3, FRAMES, 3> cic;
+
+    for (size_t ch = 0; ch < 3; ch++) {
+        average.set_calibration(ch, cal[ch]);
+        cic.set_calibration(ch, cal[ch]);
+    }
+
+    // Equivalence checks on every half-buffer, max absolute difference in A
+    Buffers ref, out;
+    float error[5] = {};
+    {
+        Cic3Reference cic_ref;
+        modules::LowPassFirstOrder lpf_ref[2] = {coeffs, coeffs};
+        modules::LowPassFirstOrder lpf_out[2] = {coeffs, coeffs};
+        modules::LowPassFirstOrder chain_ref[2] = {coeffs, coeffs};
+        modules::LowPassFirstOrder chain_out[2] = {coeffs, coeffs};
+
+        for (size_t k = 0; k < buffers; k++) {
+            const uint16_t *half = raw.data() + 3 * FRAMES * k;
+
+            clarke_per_sample(half, FRAMES, ref);
+            clarke_block(half, FRAMES, out);
+            error[0] = std::max(error[0], max_difference(ref, out, FRAMES));
+
+            // Same input to both filters, the block filter must match bit for bit
+            out = ref;
+            lpf_per_sample(lpf_ref, FRAMES, ref);
+            lpf_block(lpf_out, FRAMES, out);
+            error[1] = std::max(error[1], max_difference(ref, out, FRAMES));
+
+            decimate_per_sample(half, FRAMES, ref);
+            decimate_block(average, half, FRAMES, out);
+            for (size_t ch = 0; ch < 3; ch++) {
+                error[2] = std::max(error[2], std::fabs(ref.decimated[ch] - out.decimated[ch]));
+            }
+
+            cic3_per_sample(cic_ref, half, FRAMES, ref);
+            decimate_block(cic, half, FRAMES, out);
+            for (size_t ch = 0; (ch < 3) && (k >= 2); ch++) {
+                error[4] = std::max(error[4], std::fabs(ref.decimated[ch] - out.decimated[ch]));
+            }
+
+            chain_per_sample(chain_ref, half, FRAMES, ref);
+            chain_block(chain_out, half, FRAMES, out);
+            error[3] = std::max(error[3], max_difference(ref, out, FRAMES));
+        }
+    }
+
+    modules::LowPassFirstOrder lpf[2] = {coeffs, coeffs};
+    Cic3Reference cic_ref;
+
+    printf("Million frames (3 phase samples) per second, %zu frames per half-buffer, %zu half-buffers\n", FRAMES, buffers);
+    printf("%-22s %10s %10s %8s %10s\n", "case", "per-sample", "block", "speedup", "max error");
+    print("calibration + Clarke",
+          throughput(raw, buffers, [&](const uint16_t *half) { clarke_per_sample(half, FRAMES, out); }),
+          throughput(raw, buffers, [&](const uint16_t *half) { clarke_block(half, FRAMES, out); }),
+          error[0]);
+    print("low-pass alpha, beta",
+          throughput(raw, buffers, [&](const uint16_t *) { lpf_per_sample(lpf, FRAMES, out); }),
+          throughput(raw, buffers, [&](const uint16_t *) { lpf_block(lpf, FRAMES, out); }),
+          error[1]);
+
+    print("decimate, average",
+          throughput(raw, buffers, [&](const uint16_t *half) { decimate_per_sample(half, FRAMES, out); }),
+          throughput(raw, buffers, [&](const uint16_t *half) { decimate_block(average, half, FRAMES, out); }),
+          error[2]);
+    print("decimate, CIC3",
+          throughput(raw, buffers, [&](const uint16_t *half) { cic3_per_sample(cic_ref, half, FRAMES, out); }),
+          throughput(raw, buffers, [&](const uint16_t *half) { decimate_block(cic, half, FRAMES, out); }),
+          error[4]);
+    print("whole chain",
+          throughput(raw, buffers, [&](const uint16_t *half) { chain_per_sample(lpf, half, FRAMES, out); }),
+          throughput(raw, buffers, [&](const uint16_t *half) { chain_block(lpf, half, FRAMES, out); }),
+          error[3]);
+
+    // The filters must match exactly, the fused calibration only differs by rounding (a count is 10 mA)
+    const bool failed = (error[1] != 0.0f) || (error[0] > 1e-4f) || (error[2] > 1e-4f) || (error[3] > 1e-4f) ||
+                        (error[4] > 1e-4f);
+
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
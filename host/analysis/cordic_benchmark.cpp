@@ -0,0 +1,269 @@
+/*
+ * Accuracy and cost of the CORDIC engine and of the polynomial atan2, against libm.
+ *
+ * Accuracy: max errors over random vectors of magnitude 0.05 to 1 at every angle, compared in double precision. The
+ * CORDIC polar conversion is checked for the angle, the relative magnitude and the sine/cosine of the input angle, the
+ * rotation mode for the sine/cosine of an angle.
+ *
+ * Cost: median of single timed calls on the host with the TSC (nanoseconds elsewhere), timer overhead included, against
+ * atan2f, sqrtf and sinf/cosf from libm and the generic sine/cosine table of basic::fsincosf_pu. The CMSIS-DSP paths of
+ * math::basic only build for the target, run this tool there (or time the same calls with the profiler) to compare with
+ * them.
+ *
+ * Usage: zspinlab_cordic_benchmark [vectors] [calls]
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "math/math_core.hpp"
+#include "host_timer.hpp"
+
+using namespace zspinlab::math;
+
+// Max errors of one implementation
+struct Accuracy
+{
+    double angle = 0.0;      // [rad]
+    double magnitude = 0.0;  // Relative
+    double sincos = 0.0;     // Sine/cosine of the input angle (polar) or of the angle (rotation)
+};
+
+// Random test vectors, with their exact polar form
+struct Vectors
+{
+    std::vector<double> x, y, magnitude, angle;
+};
+
+/**
+ * @brief Draw random vectors of magnitude 0.05 to 1 at every angle, a few on the axes
+ * @param[in] count Number of vectors
+ *
+ * @return Vectors
+ */
+static Vectors make_vectors(uint32_t count)
+{
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<double> magnitude(0.05, 1.0);
+    std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+    Vectors v;
+
+    for (uint32_t i = 0; i < count; i++) {
+        const double r = magnitude(rng);
+        double theta = angle(rng);
+
+        if ((i & 15) == 0) {
+            theta = M_PI / 2.0 * static_cast<double>(static_cast<int>(i / 16 % 4) - 1);
+        }
+        // Float inputs, exact in Q31 too, the reference is computed from them
+        v.x.push_back(static_cast<float>(0.999 * r * std::cos(theta)));
+        v.y.push_back(static_cast<float>(0.999 * r * std::sin(theta)));
+        v.magnitude.push_back(std::hypot(v.x.back(), v.y.back()));
+        v.angle.push_back(std::atan2(v.y.back(), v.x.back()));
+    }
+    return v;
+}
+
+// Angle difference wrapped to [-pi, pi]
+static double angle_error(double a, double b)
+{
+    return std::fabs(std::remainder(a - b, 2.0 * M_PI));
+}
+
+/**
+ * @brief Max errors of a float or Q31 CORDIC
+ * @param[in] v Test vectors
+ *
+ * @return Max errors
+ */
+template <typename T, size_t Iterations>
+static Accuracy cordic_accuracy(const Vectors &v)
+{
+    using Cordic = basic::Cordic_T<T, Iterations>;
+
+    // Angle unit of T in radian, half-turns for Q31
+    constexpr double unit = std::is_same_v<T, float> ? 1.0 : M_PI;
+    Accuracy e;
+
+    for (size_t i = 0; i < v.x.size(); i++) {
+        const typename Cordic::Polar p = Cordic::polar(T(static_cast<float>(v.x[i])), T(static_cast<float>(v.y[i])));
+        const double theta = v.angle[i];
+        T s, c;
+
+        e.angle = std::max(e.angle, angle_error(static_cast<float>(p.angle) * unit, theta));
+        e.magnitude = std::max(e.magnitude, std::fabs(static_cast<float>(p.magnitude) / v.magnitude[i] - 1.0));
+        e.sincos = std::max({e.sincos,
+                             std::fabs(static_cast<float>(p.sin) - std::sin(theta)),
+                             std::fabs(static_cast<float>(p.cos) - std::cos(theta))});
+
+        Cordic::sincos(T(static_cast<float>(theta / unit)), s, c);
+        e.sincos = std::max({e.sincos,
+                             std::fabs(static_cast<float>(s) - std::sin(theta)),
+                             std::fabs(static_cast<float>(c) - std::cos(theta))});
+    }
+    return e;
+}
+
+/**
+ * @brief Max angle error of a float atan2
+ * @param[in] v      Test vectors
+ * @param[in] atan2f Implementation
+ *
+ * @return Max errors, the angle only
+ */
+template <class Atan2>
+static Accuracy atan2_accuracy(const Vectors &v, Atan2 atan2f)
+{
+    Accuracy e;
+
+    for (size_t i = 0; i < v.x.size(); i++) {
+        const float angle = atan2f(static_cast<float>(v.y[i]), static_cast<float>(v.x[i]));
+
+        e.angle = std::max(e.angle, angle_error(angle, v.angle[i]));
+    }
+    return e;
+}
+
+/**
+ * @brief Print one accuracy row, a zero error is not computed
+ *
+ * @return None
+ */
+static void print(const char *name, const Accuracy &e)
+{
+    printf("%-24s", name);
+    for (double error : {e.angle, e.magnitude, e.sincos}) {
+        if (error > 0.0) {
+            printf(" %12.1e", error);
+        } else {
+            printf(" %12s", "-");
+        }
+    }
+    printf("\n");
+}
+
+/**
+ * @brief Time a function, median of single calls
+ * @param[in] calls Number of calls
+ * @param[in] f     Function, called with the call index
+ *
+ * @return Median
+ */
+template <class F>
+static uint32_t time_calls(uint32_t calls, F f)
+{
+    std::vector<uint32_t> samples(calls);
+
+    for (uint32_t k = 0; k < calls; k++) {
+        const uint32_t start = cycles();
+        f(k);
+        samples[k] = cycles() - start;
+    }
+    std::nth_element(samples.begin(), samples.begin() + calls / 2, samples.end());
+
+    return samples[calls / 2];
+}
+
+int main(int argc, char **argv)
+{
+    const uint32_t count = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+    const uint32_t calls = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 1000000;
+    const Vectors v = make_vectors(count);
+
+    printf("Max error over %u random vectors\n", count);
+    printf("%-24s %12s %12s %12s\n", "", "angle [rad]", "magnitude", "sin/cos");
+    print("CORDIC float, 12 iter.", cordic_accuracy<float, 12>(v));
+    print("CORDIC float, 16 iter.", cordic_accuracy<float, 16>(v));
+    print("CORDIC float, 24 iter.", cordic_accuracy<float, 24>(v));
+    print("CORDIC Q31, 16 iter.", cordic_accuracy<type::Q31, 16>(v));
+    print("CORDIC Q31, 30 iter.", cordic_accuracy<type::Q31, 30>(v));
+    print("atan2_poly FAST", atan2_accuracy(v, basic::atan2_poly<basic::AtanPrecision::FAST>));
+    print("atan2_poly ACCURATE", atan2_accuracy(v, basic::atan2_poly<basic::AtanPrecision::ACCURATE>));
+    print("libm atan2f", atan2_accuracy(v, [](float y, float x) { return std::atan2(y, x); }));
+
+    // Float and Q31 copies of the test vectors, so that the timed calls only load their inputs
+    const size_t n = v.x.size();
+    std::vector<float> xf(n), yf(n), af(n);
+    std::vector<type::Q31> xq(n), yq(n), aq(n);
+
+    for (size_t i = 0; i < n; i++) {
+        xf[i] = static_cast<float>(v.x[i]);
+        yf[i] = static_cast<float>(v.y[i]);
+        af[i] = static_cast<float>(v.angle[i]);
+        xq[i] = type::Q31(xf[i]);
+        yq[i] = type::Q31(yf[i]);
+        aq[i] = type::Q31(static_cast<float>(v.angle[i] / M_PI));
+    }
+
+    volatile float sink;
+    volatile int32_t sink_q;
+
+    struct
+    {
+        const char *name;
+        uint32_t cycles;
+    } costs[] = {
+        {"timer only", time_calls(calls, [&](uint32_t k) { sink = xf[k % n]; })},
+        {"CORDIC float polar", time_calls(calls, [&](uint32_t k) {
+             const basic::Cordic::Polar p = basic::Cordic::polar(xf[k % n], yf[k % n]);
+             sink = p.magnitude + p.angle + p.sin + p.cos;
+         })},
+        {"CORDIC float atan2", time_calls(calls, [&](uint32_t k) { sink = basic::Cordic::atan2(yf[k % n], xf[k % n]); })},
+        {"CORDIC float sincos", time_calls(calls, [&](uint32_t k) {
+             float s, c;
+             basic::Cordic::sincos(af[k % n], s, c);
+             sink = s + c;
+         })},
+        {"CORDIC Q31 polar", time_calls(calls, [&](uint32_t k) {
+             const basic::Cordic_Q31::Polar p = basic::Cordic_Q31::polar(xq[k % n], yq[k % n]);
+             sink_q = p.magnitude.raw() + p.angle.raw() + p.sin.raw() + p.cos.raw();
+         })},
+        {"CORDIC Q31 atan2", time_calls(calls, [&](uint32_t k) {
+             sink_q = basic::Cordic_Q31::atan2(yq[k % n], xq[k % n]).raw();
+         })},
+        {"CORDIC Q31 magnitude", time_calls(calls, [&](uint32_t k) {
+             sink_q = basic::Cordic_Q31::magnitude(xq[k % n], yq[k % n]).raw();
+         })},
+        {"CORDIC Q31 sincos", time_calls(calls, [&](uint32_t k) {
+             type::Q31 s, c;
+             basic::Cordic_Q31::sincos(aq[k % n], s, c);
+             sink_q = s.raw() + c.raw();
+         })},
+        {"atan2_poly FAST", time_calls(calls, [&](uint32_t k) {
+             sink = basic::atan2_poly<basic::AtanPrecision::FAST>(yf[k % n], xf[k % n]);
+         })},
+        {"atan2_poly ACCURATE", time_calls(calls, [&](uint32_t k) {
+             sink = basic::atan2_poly<basic::AtanPrecision::ACCURATE>(yf[k % n], xf[k % n]);
+         })},
+        {"libm atan2f", time_calls(calls, [&](uint32_t k) { sink = std::atan2(yf[k % n], xf[k % n]); })},
+        {"sqrtf(x^2 + y^2)", time_calls(calls, [&](uint32_t k) {
+             sink = basic::fsqrtf(xf[k % n] * xf[k % n] + yf[k % n] * yf[k % n]);
+         })},
+        {"libm sinf + cosf", time_calls(calls, [&](uint32_t k) {
+             sink = std::sin(af[k % n]) + std::cos(af[k % n]);
+         })},
+        {"fsincosf_pu (table)", time_calls(calls, [&](uint32_t k) {
+             float s, c;
+             basic::fsincosf_pu(af[k % n] * MATH_1_BY_2PI, s, c);
+             sink = s + c;
+         })},
+    };
+    (void)sink;
+    (void)sink_q;
+
+#if defined(__x86_64__) || defined(__i386__)
+    const char *unit = "cycles";
+#else
+    const char *unit = "ns";
+#endif
+    printf("\nCost per call, median of %u calls, %s, timer overhead included\n", calls, unit);
+    for (const auto &c : costs) {
+        printf("%-24s %8u\n", c.name, c.cycles);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,280 @@
+/*
+ * Accuracy and cost of the MTPA / field-weakening reference table against the exact solution, per table size.
+ *
+ * A 48 V interior PMSM (saliency Lq / Ld = 2.5) is tabulated up to its MTPA torque at the current limit and four times
+ * its base speed. Random (torque, speed / Vdc) points are compared with the iterative solver the table is built from:
+ * current error, torque error and voltage limit excess of the interpolated references. The cost of a lookup is then
+ * timed against the solver, on the host with the TSC (nanoseconds elsewhere), timer overhead included.
+ *
+ * With --emit the tool prints a table of the given size as a C++ initializer, to be pasted in a source file as a const
+ * object so that it stays in flash.
+ *
+ * Usage: zspinlab_current_reference_benchmark [points] | --emit <torque points> <speed points>
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "control/reference/current_reference.hpp"
+#include "host_timer.hpp"
+
+using namespace zspinlab;
+
+// 48 V interior PMSM, 50 A peak, 0.95 of the linear SVPWM voltage
+static const controller::CurrentReferenceMotor MOTOR = {0.012f, 0.18e-3f, 0.45e-3f, 4, 50.0f, 0.95f / 1.7320508f};
+constexpr float VDC = 48.0f;
+
+// Table range: MTPA torque at the current limit, four times the base speed
+struct Range
+{
+    float torque_max;        // [Nm]
+    float speed_by_vdc_max;  // [rad/s/V]
+};
+
+/**
+ * @brief Compute the table range of the motor
+ *
+ * @return Table range
+ */
+static Range motor_range(void)
+{
+    const float torque_max =
+        controller::current_reference_torque(MOTOR, controller::solve_current_reference(MOTOR, 1e6f, 0.0f));
+
+    // Base speed: the largest speed at which the MTPA point of the torque max is within the voltage limit
+    float lo = 0.0f, hi = 1e3f;
+
+    for (int step = 0; step < 60; step++) {
+        const float mid = 0.5f * (lo + hi);
+        const math::type::Dq i_dq = controller::solve_current_reference(MOTOR, torque_max, mid);
+
+        if (controller::current_reference_torque(MOTOR, i_dq) >= 0.9999f * torque_max) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    return {torque_max, 4.0f * lo};
+}
+
+// Errors of one table size
+struct TableResult
+{
+    float current;  // Max current vector error [A]
+    float torque;   // Max torque error [% of torque max]
+    float voltage;  // Max voltage limit excess [%]
+    uint32_t lookup_cycles;
+};
+
+/**
+ * @brief Build a table and compare it with the solver on random points
+ * @param[in] range  Table range
+ * @param[in] points Number of random points
+ *
+ * @return Errors and lookup cost
+ */
+template <size_t TorquePoints, size_t SpeedPoints>
+static TableResult evaluate(const Range &range, uint32_t points)
+{
+    static controller::CurrentReferenceTable<TorquePoints, SpeedPoints> table;
+
+    controller::build_current_reference_table(MOTOR, range.torque_max, range.speed_by_vdc_max, table);
+
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> torque(-range.torque_max, range.torque_max);
+    std::uniform_real_distribution<float> speed(0.0f, range.speed_by_vdc_max);
+    std::vector<float> t(points), s(points);
+    TableResult r = {};
+
+    for (uint32_t k = 0; k < points; k++) {
+        t[k] = torque(rng);
+        s[k] = speed(rng);
+
+        const math::type::Dq exact = controller::solve_current_reference(MOTOR, t[k], s[k]);
+        const math::type::Dq table_dq = table.lookup(t[k], s[k]);
+
+        const float flux_d = MOTOR.psi_m + MOTOR.ld * table_dq.d;
+        const float flux_q = MOTOR.lq * table_dq.q;
+        const float voltage = s[k] * std::sqrt(flux_d * flux_d + flux_q * flux_q) / MOTOR.voltage_ratio;
+
+        r.current = std::max(r.current, std::hypot(table_dq.d - exact.d, table_dq.q - exact.q));
+        r.torque = std::max(r.torque,
+                            std::fabs(controller::current_reference_torque(MOTOR, table_dq) -
+                                      controller::current_reference_torque(MOTOR, exact)) /
+                                range.torque_max * 100.0f);
+        r.voltage = std::max(r.voltage, (voltage - 1.0f) * 100.0f);
+    }
+
+    std::vector<uint32_t> samples(points);
+    volatile float sink;
+
+    for (uint32_t k = 0; k < points; k++) {
+        const uint32_t start = cycles();
+        const math::type::Dq i_dq = table.lookup(t[k], s[k]);
+        sink = i_dq.d + i_dq.q;
+        samples[k] = cycles() - start;
+    }
+    (void)sink;
+
+    std::nth_element(samples.begin(), samples.begin() + points / 2, samples.end());
+    r.lookup_cycles = samples[points / 2];
+
+    return r;
+}
+
+/**
+ * @brief Print one table size
+ *
+ * @return None
+ */
+template <size_t TorquePoints, size_t SpeedPoints>
+static void print(const Range &range, uint32_t points)
+{
+    const TableResult r = evaluate<TorquePoints, SpeedPoints>(range, points);
+    char name[16];
+
+    snprintf(name, sizeof(name), "%zu x %zu", TorquePoints, SpeedPoints);
+    printf("%-10s %8zu %12.3f %12.3f %12.3f %10u\n",
+           name,
+           sizeof(controller::CurrentReferenceTable<TorquePoints, SpeedPoints>),
+           static_cast<double>(r.current),
+           static_cast<double>(r.torque),
+           static_cast<double>(r.voltage),
+           r.lookup_cycles);
+}
+
+/**
+ * @brief Print a table as a C++ initializer
+ * @param[in] range Table range
+ *
+ * @return None
+ */
+template <size_t TorquePoints, size_t SpeedPoints>
+static void emit(const Range &range)
+{
+    static controller::CurrentReferenceTable<TorquePoints, SpeedPoints> table;
+
+    controller::build_current_reference_table(MOTOR, range.torque_max, range.speed_by_vdc_max, table);
+
+    printf("// Torque max %.6g Nm, speed / Vdc max %.6g rad/s/V\n",
+           static_cast<double>(range.torque_max),
+           static_cast<double>(range.speed_by_vdc_max));
+    printf("const zspinlab::controller::CurrentReferenceTable<%zu, %zu> current_reference_table = {\n",
+           TorquePoints,
+           SpeedPoints);
+    printf("    %.9gf, %.9gf, %.9gf,\n",
+           static_cast<double>(table.torque_scale),
+           static_cast<double>(table.speed_scale),
+           static_cast<double>(table.current_scale));
+    printf("    {\n");
+    for (size_t j = 0; j < SpeedPoints; j++) {
+        printf("        {");
+        for (size_t i = 0; i < TorquePoints; i++) {
+            printf("%s{%d, %d}", (i == 0) ? "" : ", ", table.nodes[j][i].id, table.nodes[j][i].iq);
+        }
+        printf("},\n");
+    }
+    printf("    },\n};\n");
+}
+
+/**
+ * @brief Parse a positive count
+ * @param[in] text Command line argument
+ * @param[out] out Parsed count
+ *
+ * @return True if the whole argument is a count above zero
+ */
+static bool parse_count(const char *text, uint32_t &out)
+{
+    char *end;
+    const unsigned long value = std::strtoul(text, &end, 10);
+
+    out = static_cast<uint32_t>(value);
+    return (end != text) && (*end == '\0') && (value > 0) && (value <= UINT32_MAX);
+}
+
+int main(int argc, char **argv)
+{
+    const char *usage = "usage: %s [points] | --emit <torque points> <speed points>\n";
+    uint32_t points = 200000;
+
+    if ((argc > 1) && (strcmp(argv[1], "--emit") == 0)) {
+        uint32_t t, s;
+
+        if ((argc != 4) || !parse_count(argv[2], t) || !parse_count(argv[3], s)) {
+            fprintf(stderr, usage, argv[0]);
+            return EXIT_FAILURE;
+        }
+
+        const Range range = motor_range();
+
+        // Table sizes are compile time parameters, emit the sizes the benchmark covers
+        if ((t == 8) && (s == 8)) {
+            emit<8, 8>(range);
+        } else if ((t == 16) && (s == 16)) {
+            emit<16, 16>(range);
+        } else if ((t == 32) && (s == 16)) {
+            emit<32, 16>(range);
+        } else if ((t == 32) && (s == 32)) {
+            emit<32, 32>(range);
+        } else if ((t == 64) && (s == 64)) {
+            emit<64, 64>(range);
+        } else {
+            fprintf(stderr, "%s: supported sizes are 8 8, 16 16, 32 16, 32 32 and 64 64\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+        return EXIT_SUCCESS;
+    }
+
+    if ((argc > 2) || ((argc == 2) && !parse_count(argv[1], points))) {
+        fprintf(stderr, usage, argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    const Range range = motor_range();
+
+    printf("Interior PMSM, %.0f V, %.0f A: torque max %.3f Nm, speed / Vdc max %.1f rad/s/V (4x base speed)\n",
+           static_cast<double>(VDC),
+           static_cast<double>(MOTOR.i_max),
+           static_cast<double>(range.torque_max),
+           static_cast<double>(range.speed_by_vdc_max));
+    printf("Max errors of the table against the solver over %u random points\n", points);
+    printf("%-10s %8s %12s %12s %12s %10s\n", "size", "bytes", "current [A]", "torque [%]", "voltage [%]", "lookup");
+    print<8, 8>(range, points);
+    print<16, 16>(range, points);
+    print<32, 16>(range, points);
+    print<32, 32>(range, points);
+    print<64, 64>(range, points);
+
+    // Cost of the exact solution, per call
+    std::mt19937 rng(2);
+    std::uniform_real_distribution<float> torque(-range.torque_max, range.torque_max);
+    std::uniform_real_distribution<float> speed(0.0f, range.speed_by_vdc_max);
+    std::vector<uint32_t> samples(std::max<uint32_t>(points / 10, 1));
+    volatile float sink;
+
+    for (uint32_t &sample : samples) {
+        const float t = torque(rng);
+        const float s = speed(rng);
+        const uint32_t start = cycles();
+        const math::type::Dq i_dq = controller::solve_current_reference(MOTOR, t, s);
+        sink = i_dq.d + i_dq.q;
+        sample = cycles() - start;
+    }
+    (void)sink;
+    std::nth_element(samples.begin(), samples.begin() + samples.size() / 2, samples.end());
+
+#if defined(__x86_64__) || defined(__i386__)
+    const char *unit = "cycles";
+#else
+    const char *unit = "ns";
+#endif
+    printf("\nMedian cost per call, %s: solver %u, lookup in the last column\n", unit, samples[samples.size() / 2]);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,128 @@
+/*
+ * Switching event analysis of the discontinuous modulators against SVPWM_ARS.
+ *
+ * Rotates a reference of constant amplitude through one fundamental cycle, builds the center-aligned PWM waveform of
+ * each leg and counts its edges, including the ones between periods. Each edge is also weighted by the magnitude of
+ * the phase current at that instant (sinusoidal, lagging the voltage by the power factor angle), a first-order proxy of
+ * the switching losses.
+ *
+ * Usage: zspinlab_dpwm_switching [periods per fundamental cycle] [modulation amplitude]
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+#include "modulation/svpwm/svpwm_ars.hpp"
+#include "modulation/svpwm/svpwm_dpwm.hpp"
+
+using namespace zspinlab::modulation;
+
+// Switching statistics of one modulator over one fundamental cycle
+struct SwitchingStats
+{
+    unsigned events;    // Leg edges, all three legs
+    double loss;        // Sum of |phase current| at the edges
+};
+
+/**
+ * @brief Run a modulator over one fundamental cycle and count its edges
+ * @param[in] periods     PWM periods per fundamental cycle
+ * @param[in] amplitude   Reference amplitude, normalized (sqrt(3)/2 is the linear limit)
+ * @param[in] phi         Current lag behind the voltage [rad]
+ * @param[in] active_low  The modulator duty cycles are low-side on times (SVPWM_ARS)
+ *
+ * @return Switching statistics
+ */
+template <class Modulator>
+static SwitchingStats analyze(unsigned periods, double amplitude, double phi, bool active_low)
+{
+    Modulator modulator;
+    SwitchingStats stats = {0, 0.0};
+    bool level[3];
+
+    modulator.init();
+
+    // Run two cycles, only count the second one so that the first period edges are counted against the previous one
+    for (unsigned k = 0; k < 2 * periods; k++) {
+        const double theta = 2.0 * M_PI * (k % periods) / periods;
+        const double current[3] = {
+            std::cos(theta - phi),
+            std::cos(theta - phi - 2.0 * M_PI / 3.0),
+            std::cos(theta - phi + 2.0 * M_PI / 3.0),
+        };
+
+        if constexpr (std::is_same_v<Modulator, SVPWM_DPWM_Current>) {
+            modulator.set_current_ab(static_cast<float>(std::cos(theta - phi)), static_cast<float>(std::sin(theta - phi)));
+        }
+        modulator.set_vref_ab(static_cast<float>(amplitude * std::cos(theta)),
+                              static_cast<float>(amplitude * std::sin(theta)));
+        modulator.run();
+
+        const float duty[3] = {modulator.get_phase_duty_a(), modulator.get_phase_duty_b(), modulator.get_phase_duty_c()};
+
+        for (unsigned leg = 0; leg < 3; leg++) {
+            const float d = active_low ? 1.0f - duty[leg] : duty[leg];
+            unsigned edges = 0;
+
+            // Center-aligned period: low, high, low. A leg at 0 or 1 stays at one level for the whole period
+            if (d <= 0.0f) {
+                edges = (k > 0 && level[leg]) ? 1 : 0;
+                level[leg] = false;
+            } else if (d >= 1.0f) {
+                edges = (k > 0 && !level[leg]) ? 1 : 0;
+                level[leg] = true;
+            } else {
+                edges = ((k > 0 && level[leg]) ? 1 : 0) + 2;
+                level[leg] = false;
+            }
+
+            if (k >= periods) {
+                stats.events += edges;
+                stats.loss += edges * std::fabs(current[leg]);
+            }
+        }
+    }
+
+    return stats;
+}
+
+/**
+ * @brief Print one modulator line
+ * @param[in] name      Modulator name
+ * @param[in] stats     Modulator statistics
+ * @param[in] reference SVPWM_ARS statistics
+ *
+ * @return None
+ */
+static void print(const char *name, const SwitchingStats &stats, const SwitchingStats &reference)
+{
+    printf("  %-14s %8u  %7.1f%%  %9.1f%%\n",
+           name, stats.events, 100.0 * stats.events / reference.events, 100.0 * stats.loss / reference.loss);
+}
+
+int main(int argc, char **argv)
+{
+    const unsigned periods = (argc > 1) ? static_cast<unsigned>(strtoul(argv[1], nullptr, 0)) : 200U;
+    const double amplitude = (argc > 2) ? strtod(argv[2], nullptr) : 0.8;
+
+    for (double phi_deg : {0.0, 30.0, -30.0, 60.0}) {
+        const double phi = phi_deg * M_PI / 180.0;
+        const SwitchingStats ars = analyze<SVPWM_ARS>(periods, amplitude, phi, true);
+
+        printf("%u periods per cycle, amplitude %.3f, current lagging by %.0f deg\n", periods, amplitude, phi_deg);
+        printf("  %-14s %8s  %8s  %10s\n", "modulator", "events", "vs ARS", "loss vs ARS");
+
+        print("SVPWM_ARS", ars, ars);
+        print("DPWM0", analyze<SVPWM_DPWM0>(periods, amplitude, phi, false), ars);
+        print("DPWM1", analyze<SVPWM_DPWM1>(periods, amplitude, phi, false), ars);
+        print("DPWM2", analyze<SVPWM_DPWM2>(periods, amplitude, phi, false), ars);
+        print("DPWM3", analyze<SVPWM_DPWM3>(periods, amplitude, phi, false), ars);
+        print("DPWMMIN", analyze<SVPWM_DPWMMIN>(periods, amplitude, phi, false), ars);
+        print("DPWMMAX", analyze<SVPWM_DPWMMAX>(periods, amplitude, phi, false), ars);
+        print("DPWM_Current", analyze<SVPWM_DPWM_Current>(periods, amplitude, phi, false), ars);
+        printf("\n");
+    }
+
+    return EXIT_SUCCESS;
+}
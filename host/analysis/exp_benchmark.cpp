@@ -0,0 +1,110 @@
+/*
+ * Accuracy and cost of the basic::fexpf accuracy tiers.
+ *
+ * Accuracy: max relative error against exp() in double precision, over the whole input range of the approximations
+ * ([-87, 88]) and over [-10, 10], the range of thermal model and soft-start ramp exponents.
+ *
+ * Cost: nanoseconds per call over an array of inputs in [-10, 10], best of a few runs. Each result is written to a
+ * volatile, one call at a time, so that the loop is not vectorized, as on target.
+ *
+ * Usage: zspinlab_exp_benchmark [points] [calls]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "math/math_core.hpp"
+
+using namespace zspinlab::math;
+
+/**
+ * @brief Max relative error of a tier over an input range
+ * @param[in] lo     Lower bound of the input range
+ * @param[in] hi     Upper bound of the input range
+ * @param[in] points Number of evenly spaced inputs
+ *
+ * @return Max relative error
+ */
+template <basic::ExpPrecision precision>
+static double max_relative_error(float lo, float hi, uint32_t points)
+{
+    double error = 0.0;
+
+    for (uint32_t i = 0; i < points; i++) {
+        const float x = lo + (hi - lo) * static_cast<float>(i) / static_cast<float>(points - 1);
+        const double exact = std::exp(static_cast<double>(x));
+
+        error = std::max(error, std::fabs(basic::fexpf<precision>(x) / exact - 1.0));
+    }
+    return error;
+}
+
+/**
+ * @brief Time a tier over an array of inputs
+ * @param[in] in    Inputs
+ * @param[in] calls Number of calls, cycling over the inputs
+ *
+ * @return Nanoseconds per call
+ */
+template <basic::ExpPrecision precision>
+static double ns_per_call(const std::vector<float> &in, uint32_t calls)
+{
+    volatile float sink;
+    double best = INFINITY;
+
+    for (int run = 0; run < 5; run++) {
+        const auto start = std::chrono::steady_clock::now();
+        for (uint32_t k = 0; k < calls; k++) {
+            sink = basic::fexpf<precision>(in[k % in.size()]);
+        }
+        const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+        best = std::min(best, elapsed.count() / calls);
+    }
+    (void)sink;
+
+    return best;
+}
+
+/**
+ * @brief Print one tier
+ *
+ * @return None
+ */
+template <basic::ExpPrecision precision>
+static void print(const char *name, const std::vector<float> &in, uint32_t points, uint32_t calls)
+{
+    printf("%-14s %14.2e %14.2e %10.2f\n",
+           name,
+           max_relative_error<precision>(-87.0f, 88.0f, points),
+           max_relative_error<precision>(-10.0f, 10.0f, points),
+           ns_per_call<precision>(in, calls));
+}
+
+int main(int argc, char **argv)
+{
+    const uint32_t points = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 10000000;
+    const uint32_t calls = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 10000000;
+
+    std::vector<float> in(4096);
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> uniform(-10.0f, 10.0f);
+
+    for (float &x : in) {
+        x = uniform(rng);
+    }
+
+    printf("Max relative error over %u points, cost over %u calls\n", points, calls);
+    printf("%-14s %14s %14s %10s\n", "tier", "[-87, 88]", "[-10, 10]", "ns/call");
+    print<basic::ExpPrecision::SCHRAUDOLPH>("SCHRAUDOLPH", in, points, calls);
+    print<basic::ExpPrecision::POLY3>("POLY3", in, points, calls);
+    print<basic::ExpPrecision::POLY5>("POLY5", in, points, calls);
+    print<basic::ExpPrecision::FULL>("FULL (expf)", in, points, calls);
+
+    return EXIT_SUCCESS;
+}
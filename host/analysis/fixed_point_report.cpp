@@ -0,0 +1,390 @@
+/*
+ * Error bounds and cost of the Q15/Q31 transforms, PI, low-pass filters and modulators against the float versions.
+ *
+ * Accuracy: every fixed-point block runs on the same random inputs as its float version, in the operating range of the
+ * block (per-unit currents and voltages, references inside the linear circle of the modulators). The max absolute error
+ * of each block must stay within its bound: a few LSB of the format for the one-shot blocks and more for the PI and
+ * the filters, whose state accumulates the rounding of every tick, plus a few roundings of the float reference itself,
+ * which dominate the Q31 error. The tool fails if a bound is exceeded.
+ *
+ * Cost: nanoseconds per call over an array of inputs, best of 5 runs, for float with the host FPU, Q15 and Q31. The
+ * "soft float" column emulates a core without FPU (Cortex-M0+/M23): the same float template runs on SoftFloat, whose
+ * arithmetic goes through the libgcc software floating point routines. x86-64 only has them in quad precision, so the
+ * column overestimates the single precision __aeabi_f* calls of the target, it shows the order of magnitude. The
+ * transforms are float functions, not templates, so they have no soft float column. Q31 multiplies are 64-bit on
+ * the host; on a Cortex-M0+ they are __aeabi_lmul calls, time them there with the profiler for target numbers.
+ *
+ * Usage: zspinlab_fixed_point_report [samples]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "math/math_core.hpp"
+#include "modulation/svpwm/svpwm_ars.hpp"
+#include "modulation/svpwm/svpwm_svgen.hpp"
+
+using namespace zspinlab::math;
+using namespace zspinlab::modulation;
+
+using type::Q15;
+using type::Q31;
+
+// Single precision value whose arithmetic runs in software floating point, as on a core without FPU
+class SoftFloat
+{
+public:
+    SoftFloat(void) = default;
+    constexpr SoftFloat(float value) : value(value) {}
+
+    template <typename U>
+    explicit operator U(void) const
+    {
+        return static_cast<U>(value);
+    }
+
+    friend SoftFloat operator+(SoftFloat a, SoftFloat b) { return narrow(widen(a) + widen(b)); }
+    friend SoftFloat operator-(SoftFloat a, SoftFloat b) { return narrow(widen(a) - widen(b)); }
+    friend SoftFloat operator*(SoftFloat a, SoftFloat b) { return narrow(widen(a) * widen(b)); }
+    friend SoftFloat operator/(SoftFloat a, SoftFloat b) { return narrow(widen(a) / widen(b)); }
+    friend SoftFloat operator-(SoftFloat a) { return narrow(-widen(a)); }
+
+    friend bool operator<(SoftFloat a, SoftFloat b) { return widen(a) < widen(b); }
+    friend bool operator>(SoftFloat a, SoftFloat b) { return widen(a) > widen(b); }
+    friend bool operator<=(SoftFloat a, SoftFloat b) { return widen(a) <= widen(b); }
+    friend bool operator>=(SoftFloat a, SoftFloat b) { return widen(a) >= widen(b); }
+
+    // Only reached by references beyond the linear circle, which the benchmark does not use
+    friend SoftFloat sqrt(SoftFloat a) { return SoftFloat(std::sqrt(a.value)); }
+
+private:
+    // Hide the extension from the optimizer, which would otherwise narrow the quad operation back to a float one
+    static __float128 widen(SoftFloat a)
+    {
+        __float128 wide = a.value;
+        __asm__("" : "+x"(wide));
+        return wide;
+    }
+
+    static SoftFloat narrow(__float128 a) { return SoftFloat(static_cast<float>(a)); }
+
+    float value;
+};
+
+// Max absolute error of every block against its float version
+struct Errors
+{
+    double clarke = 0.0, park = 0.0, inverse_park = 0.0;
+    double pi = 0.0, lpf1 = 0.0, lpf2 = 0.0;
+    double svgen = 0.0, ars = 0.0;
+};
+
+// Random inputs of every block
+struct Inputs
+{
+    std::vector<float> a, b, c;             // Phase currents, alpha/beta or dq values, per-unit
+    std::vector<float> sin_theta, cos_theta;
+    std::vector<float> va, vb;              // Modulator references inside the linear circle
+};
+
+/**
+ * @brief Draw random inputs
+ * @param[in] count Number of samples
+ *
+ * @return Inputs
+ */
+static Inputs make_inputs(uint32_t count)
+{
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> value(-0.45f, 0.45f);
+    std::uniform_real_distribution<float> angle(0.0f, 1.0f);
+    std::uniform_real_distribution<float> amplitude(0.0f, 0.85f);
+    Inputs in;
+
+    for (uint32_t i = 0; i < count; i++) {
+        float s, c;
+
+        in.a.push_back(value(rng));
+        in.b.push_back(value(rng));
+        in.c.push_back(-in.a.back() - in.b.back());
+
+        basic::fsincosf_pu(angle(rng), s, c);
+        in.sin_theta.push_back(s);
+        in.cos_theta.push_back(c);
+
+        const float m = amplitude(rng);
+        basic::fsincosf_pu(angle(rng), s, c);
+        in.va.push_back(m * c);
+        in.vb.push_back(m * s);
+    }
+    return in;
+}
+
+// Absolute difference of a fixed-point result and a float one
+template <typename T>
+static double error(T fixed, float ref)
+{
+    return std::fabs(static_cast<double>(static_cast<float>(fixed)) - ref);
+}
+
+/**
+ * @brief Max errors of one fixed-point format
+ * @param[in] in Inputs
+ *
+ * @return Max errors
+ */
+template <typename T>
+static Errors accuracy(const Inputs &in)
+{
+    const auto lpf1_coeffs = function::lowpass_first_order(2000.0f, 20000.0f);
+    const auto lpf2_coeffs = function::lowpass_butterworth(2000.0f, 20000.0f);
+
+    modules::PI pi_ref(0.5f, 0.05f, -0.9f, 0.9f);
+    modules::PI_T<T> pi(T(0.5f), T(0.05f), T(-0.9f), T(0.9f));
+    modules::LowPassFirstOrder lpf1_ref(lpf1_coeffs);
+    modules::LowPassFirstOrder_T<T> lpf1(lpf1_coeffs.cast<type::coeff_t<T>>());
+    modules::LowPassSecondOrder lpf2_ref(lpf2_coeffs);
+    modules::LowPassSecondOrder_T<T> lpf2(lpf2_coeffs.cast<type::coeff_t<T>>());
+    SVPWM_SVGen svgen_ref;
+    SVPWM_SVGen_T<T> svgen;
+    SVPWM_ARS ars_ref;
+    SVPWM_ARS_T<T> ars;
+    Errors e;
+
+    for (size_t i = 0; i < in.a.size(); i++) {
+        const T a(in.a[i]), b(in.b[i]), c(in.c[i]), s(in.sin_theta[i]), co(in.cos_theta[i]);
+        float x_ref, y_ref;
+        T x, y;
+
+        function::clarke_transform<true>(in.a[i], in.b[i], in.c[i], x_ref, y_ref);
+        function::clarke_transform<true>(a, b, c, x, y);
+        e.clarke = std::max({e.clarke, error(x, x_ref), error(y, y_ref)});
+
+        function::park_transform(in.a[i], in.b[i], in.sin_theta[i], in.cos_theta[i], x_ref, y_ref);
+        function::park_transform(a, b, s, co, x, y);
+        e.park = std::max({e.park, error(x, x_ref), error(y, y_ref)});
+
+        function::inverse_park_transform(in.a[i], in.b[i], in.sin_theta[i], in.cos_theta[i], x_ref, y_ref);
+        function::inverse_park_transform(a, b, s, co, x, y);
+        e.inverse_park = std::max({e.inverse_park, error(x, x_ref), error(y, y_ref)});
+
+        // Setpoint changing every 64 samples, as a current reference stepping between ticks
+        const float sp = in.b[i & ~size_t(63)];
+        e.pi = std::max(e.pi, error(pi.run(T(sp), a, T()), pi_ref.run(sp, in.a[i], 0.0f)));
+
+        e.lpf1 = std::max(e.lpf1, error(lpf1.run(a), lpf1_ref.run(in.a[i])));
+        e.lpf2 = std::max(e.lpf2, error(lpf2.run(a), lpf2_ref.run(in.a[i])));
+
+        svgen_ref.set_vref_ab(in.va[i], in.vb[i]);
+        svgen_ref.run();
+        svgen.set_vref_ab(T(in.va[i]), T(in.vb[i]));
+        svgen.run();
+        e.svgen = std::max({e.svgen,
+                            error(svgen.get_phase_duty_a(), svgen_ref.get_phase_duty_a()),
+                            error(svgen.get_phase_duty_b(), svgen_ref.get_phase_duty_b()),
+                            error(svgen.get_phase_duty_c(), svgen_ref.get_phase_duty_c())});
+
+        ars_ref.set_vref_ab(in.va[i], in.vb[i]);
+        ars_ref.run();
+        ars.set_vref_ab(T(in.va[i]), T(in.vb[i]));
+        ars.run();
+        e.ars = std::max({e.ars,
+                          error(ars.get_phase_duty_a(), ars_ref.get_phase_duty_a()),
+                          error(ars.get_phase_duty_b(), ars_ref.get_phase_duty_b()),
+                          error(ars.get_phase_duty_c(), ars_ref.get_phase_duty_c())});
+    }
+    return e;
+}
+
+/**
+ * @brief Time a block over all the inputs, best of 5 runs
+ * @param[in] count Number of calls per run
+ * @param[in] call  Block call (index), returns a value of the result
+ *
+ * @return Nanoseconds per call
+ */
+template <class Call>
+static double throughput(size_t count, Call call)
+{
+    double best = INFINITY;
+    volatile float sink;
+
+    for (int run = 0; run < 5; run++) {
+        float sum = 0.0f;
+
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < count; i++) {
+            sum += call(i);
+        }
+        const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+        sink = sum;
+        best = std::min(best, elapsed.count() / count);
+    }
+    (void)sink;
+    return best;
+}
+
+// Cost of every block in one sample type, nanoseconds per call, NAN where the type does not apply
+struct Costs
+{
+    double clarke = NAN, park = NAN, inverse_park = NAN;
+    double pi = NAN, lpf1 = NAN, lpf2 = NAN;
+    double svgen = NAN, ars = NAN;
+};
+
+/**
+ * @brief Time the template blocks (PI, filters, modulators) in one sample type
+ * @param[in] in Inputs, converted to T before timing
+ * @param[in,out] c Costs
+ *
+ * @return None
+ */
+template <typename T>
+static void time_templates(const Inputs &in, Costs &c)
+{
+    const size_t n = in.a.size();
+    std::vector<T> a(n), b(n), va(n), vb(n);
+
+    for (size_t i = 0; i < n; i++) {
+        a[i] = T(in.a[i]);
+        b[i] = T(in.b[i]);
+        va[i] = T(in.va[i]);
+        vb[i] = T(in.vb[i]);
+    }
+
+    modules::PI_T<T> pi(T(0.5f), T(0.05f), T(-0.9f), T(0.9f));
+    modules::LowPassFirstOrder_T<T> lpf1(function::lowpass_first_order(2000.0f, 20000.0f).cast<type::coeff_t<T>>());
+    modules::LowPassSecondOrder_T<T> lpf2(function::lowpass_butterworth(2000.0f, 20000.0f).cast<type::coeff_t<T>>());
+    SVPWM_SVGen_T<T> svgen;
+    SVPWM_ARS_T<T> ars;
+
+    c.pi = throughput(n, [&](size_t i) { return static_cast<float>(pi.run(b[i], a[i], T())); });
+    c.lpf1 = throughput(n, [&](size_t i) { return static_cast<float>(lpf1.run(a[i])); });
+    c.lpf2 = throughput(n, [&](size_t i) { return static_cast<float>(lpf2.run(a[i])); });
+    c.svgen = throughput(n, [&](size_t i) {
+        svgen.set_vref_ab(va[i], vb[i]);
+        svgen.run();
+        return static_cast<float>(svgen.get_phase_duty_a());
+    });
+    c.ars = throughput(n, [&](size_t i) {
+        ars.set_vref_ab(va[i], vb[i]);
+        ars.run();
+        return static_cast<float>(ars.get_phase_duty_a());
+    });
+}
+
+/**
+ * @brief Time the transforms in one sample type
+ * @param[in] in Inputs, converted to T before timing
+ * @param[in,out] c Costs
+ *
+ * @return None
+ */
+template <typename T>
+static void time_transforms(const Inputs &in, Costs &c)
+{
+    const size_t n = in.a.size();
+    std::vector<T> a(n), b(n), ph_c(n), s(n), co(n);
+
+    for (size_t i = 0; i < n; i++) {
+        a[i] = T(in.a[i]);
+        b[i] = T(in.b[i]);
+        ph_c[i] = T(in.c[i]);
+        s[i] = T(in.sin_theta[i]);
+        co[i] = T(in.cos_theta[i]);
+    }
+
+    c.clarke = throughput(n, [&](size_t i) {
+        T x, y;
+        function::clarke_transform<true>(a[i], b[i], ph_c[i], x, y);
+        return static_cast<float>(x) + static_cast<float>(y);
+    });
+    c.park = throughput(n, [&](size_t i) {
+        T x, y;
+        function::park_transform(a[i], b[i], s[i], co[i], x, y);
+        return static_cast<float>(x) + static_cast<float>(y);
+    });
+    c.inverse_park = throughput(n, [&](size_t i) {
+        T x, y;
+        function::inverse_park_transform(a[i], b[i], s[i], co[i], x, y);
+        return static_cast<float>(x) + static_cast<float>(y);
+    });
+}
+
+/**
+ * @brief Print one block, check its bounds
+ * @param[in] name Block name
+ * @param[in] e15  Q15 max error
+ * @param[in] e31  Q31 max error
+ * @param[in] lsb  Bound in LSB of the format
+ * @param[in] ulp  Rounding of the float reference, in units of 2^-24 (float epsilon at 1.0)
+ * @param[in] cost Nanoseconds per call: float, soft float, Q15, Q31
+ *
+ * @return True if both errors are within their bounds
+ */
+static bool print(const char *name, double e15, double e31, double lsb, double ulp, const double (&cost)[4])
+{
+    const double bound15 = lsb * std::ldexp(1.0, -15) + ulp * std::ldexp(1.0, -24);
+    const double bound31 = lsb * std::ldexp(1.0, -31) + ulp * std::ldexp(1.0, -24);
+    const bool passed = (e15 <= bound15) && (e31 <= bound31);
+
+    printf("%-13s %9.2e %9.2e %9.2e %9.2e %-4s |", name, e15, bound15, e31, bound31, passed ? "ok" : "FAIL");
+    for (double ns : cost) {
+        if (std::isnan(ns)) {
+            printf(" %9s", "-");
+        } else {
+            printf(" %9.2f", ns);
+        }
+    }
+    printf("\n");
+    return passed;
+}
+
+int main(int argc, char **argv)
+{
+    const uint32_t samples = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 200000;
+
+    if (samples == 0) {
+        fprintf(stderr, "Usage: zspinlab_fixed_point_report [samples]\n");
+        return EXIT_FAILURE;
+    }
+
+    const Inputs in = make_inputs(samples);
+    const Errors e15 = accuracy<Q15>(in);
+    const Errors e31 = accuracy<Q31>(in);
+    Costs c_float, c_soft, c15, c31;
+    bool passed = true;
+
+    time_transforms<float>(in, c_float);
+    time_transforms<Q15>(in, c15);
+    time_transforms<Q31>(in, c31);
+    time_templates<float>(in, c_float);
+    time_templates<SoftFloat>(in, c_soft);
+    time_templates<Q15>(in, c15);
+    time_templates<Q31>(in, c31);
+
+    printf("Max |error| against float over %u random samples, and its bound; nanoseconds per call\n", samples);
+    printf("%-13s %9s %9s %9s %9s %-4s | %9s %9s %9s %9s\n", "block", "Q15", "bound", "Q31", "bound", "",
+           "float", "soft", "Q15", "Q31");
+
+    // Bounds: the rounding of each product of the block and the input quantization, a few LSB, and for the PI and the
+    // filters the rounding and the gain quantization accumulated in their state. The float reference rounds too, which
+    // dominates the Q31 error
+    passed &= print("Clarke", e15.clarke, e31.clarke, 3, 4, {c_float.clarke, c_soft.clarke, c15.clarke, c31.clarke});
+    passed &= print("Park", e15.park, e31.park, 3, 4, {c_float.park, c_soft.park, c15.park, c31.park});
+    passed &= print("inverse Park", e15.inverse_park, e31.inverse_park, 3, 4,
+                    {c_float.inverse_park, c_soft.inverse_park, c15.inverse_park, c31.inverse_park});
+    passed &= print("PI", e15.pi, e31.pi, 64, 32, {c_float.pi, c_soft.pi, c15.pi, c31.pi});
+    passed &= print("low-pass 1st", e15.lpf1, e31.lpf1, 8, 4, {c_float.lpf1, c_soft.lpf1, c15.lpf1, c31.lpf1});
+    passed &= print("low-pass 2nd", e15.lpf2, e31.lpf2, 32, 4, {c_float.lpf2, c_soft.lpf2, c15.lpf2, c31.lpf2});
+    passed &= print("SVGen", e15.svgen, e31.svgen, 4, 4, {c_float.svgen, c_soft.svgen, c15.svgen, c31.svgen});
+    passed &= print("ARS", e15.ars, e31.ars, 4, 4, {c_float.ars, c_soft.ars, c15.ars, c31.ars});
+
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,265 @@
+/*
+ * Sensorless closed-loop accuracy and cycle budget of the active flux observer.
+ *
+ * The current loop runs on the observer angle only (no encoder) on the simulated 24 V servo motor of the tuning tool,
+ * held at a constant speed by a dynamometer. The observer starts a quarter of an electrical turn off, at zero speed.
+ * For each case the tool reports the lock time (from which on the angle error stays below 5 degrees), then the
+ * steady-state angle error and speed estimate error over the second half of the run. Two cases run with a wrong
+ * resistance or q inductance in the observer, one sets the PLL bandwidth before the sample time.
+ *
+ * The cycle budget of FluxObserver::run() is then measured on the host with the TSC (nanoseconds elsewhere), next to
+ * CurrentController::run() and to the sine/cosine computation an angle based observer would need on top.
+ *
+ * Usage: zspinlab_flux_observer_benchmark [calls]
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "control/current/current_controller.hpp"
+#include "control/observer/flux_observer.hpp"
+#include "math/math_core.hpp"
+#include "modulation/svpwm/svpwm_ars.hpp"
+#include "sim/pmsm_plant.hpp"
+#include "host_timer.hpp"
+
+using namespace zspinlab;
+
+// Small 24 V servo motor at 20 kHz, same as the tuning tool
+static const sim::PmsmParameters MOTOR = {0.5, 1.0e-3, 1.2e-3, 0.01, 4, 1.0e-5, 1.0e-5};
+constexpr double VDC = 24.0;
+constexpr double PWM_PERIOD = 50.0e-6;
+constexpr float IQ_REF = 2.0f;
+constexpr float LOCK_DEGREES = 5.0f;
+
+/**
+ * @brief Measure the stator volts per unit of the modulator reference, on the inverter model
+ *
+ * @return Voltage scale [V]
+ */
+static float voltage_scale(void)
+{
+    modulation::SVPWM_ARS modulator;
+    sim::Inverter inverter(VDC);
+    double v_alpha, v_beta;
+
+    modulator.init();
+    modulator.set_vref_ab(0.5f, 0.0f);
+    modulator.run();
+    inverter.run(modulator, 0.0, 0.0, 0.0, VDC, v_alpha, v_beta);
+
+    return static_cast<float>(v_alpha / 0.5);
+}
+
+// Observer parameter error of a case, relative
+struct Mismatch
+{
+    float rs;
+    float lq;
+};
+
+// Order in which the observer is configured
+enum class SetupOrder
+{
+    SAMPLE_TIME_FIRST,  // set_sample_time() then set_pll_bandwidth()
+    GAINS_FIRST,        // set_pll_bandwidth() then set_sample_time(), the gains must not depend on the call order
+};
+
+// Result of one closed-loop case
+struct CaseResult
+{
+    float lock_time;    // [ms], infinite if never locked
+    float angle_rms;    // [deg]
+    float angle_max;    // [deg]
+    float speed_error;  // Mean speed estimate error [%]
+};
+
+/**
+ * @brief Run the current loop on the observer angle at a held speed
+ * @param[in] omega_e  Electrical angular speed [rad/s]
+ * @param[in] mismatch Observer parameter error
+ * @param[in] order    Observer configuration order
+ * @param[in] duration Simulated time [s]
+ *
+ * @return Case result
+ */
+static CaseResult run_case(float omega_e, Mismatch mismatch, SetupOrder order, double duration)
+{
+    sim::PmsmPlant plant(MOTOR, VDC, PWM_PERIOD);
+    controller::CurrentController current;
+    controller::FluxObserver observer;
+    modulation::SVPWM_ARS modulator;
+
+    plant.get_motor().set_speed(omega_e / MOTOR.pole_pairs);
+    plant.get_motor().hold_speed(true);
+
+    current.set_Id_pi_params(0.1f, 0.005f, -0.8f, 0.8f);
+    current.set_Iq_pi_params(0.1f, 0.005f, -0.8f, 0.8f);
+    current.set_Iq_ref(IQ_REF);
+    modulator.init();
+
+    observer.set_motor_params(static_cast<float>(MOTOR.rs) * (1.0f + mismatch.rs),
+                              static_cast<float>(MOTOR.ld),
+                              static_cast<float>(MOTOR.lq) * (1.0f + mismatch.lq),
+                              static_cast<float>(MOTOR.psi_m));
+    if (order == SetupOrder::GAINS_FIRST) {
+        observer.set_flux_correction(100.0f);
+        observer.set_pll_bandwidth(600.0f);
+        observer.set_sample_time(static_cast<float>(PWM_PERIOD));
+    } else {
+        observer.set_sample_time(static_cast<float>(PWM_PERIOD));
+        observer.set_flux_correction(100.0f);
+        observer.set_pll_bandwidth(600.0f);
+    }
+    observer.set_voltage_scale(voltage_scale());
+    observer.reset_state(0.25f, 0.0f);
+
+    const size_t periods = static_cast<size_t>(duration / PWM_PERIOD);
+    size_t last_unlocked = 0;
+    double angle_sq = 0.0, speed_sum = 0.0;
+    float angle_max = 0.0f;
+
+    for (size_t k = 0; k < periods; k++) {
+        float iA, iB, iC, s, c;
+
+        plant.get_phase_currents(iA, iB, iC);
+
+        const math::type::AlphaBeta i_ab = math::function::clarke_transform<true>(math::type::Abc{iA, iB, iC});
+
+        observer.run(i_ab, current.get_vab());
+        current.run(math::function::park_transform(i_ab, observer.get_sincos()), observer.get_sincos());
+        modulator.set_vref_ab(current.get_vab());
+        modulator.run();
+        plant.run(modulator);
+
+        // The observer angle is predicted for the next tick, compare with the rotor angle there
+        plant.get_sincos(s, c);
+        const float error = std::atan2(observer.get_sin() * c - observer.get_cos() * s,
+                                       observer.get_cos() * c + observer.get_sin() * s) *
+                            (180.0f / static_cast<float>(M_PI));
+
+        if (!(std::fabs(error) < LOCK_DEGREES)) {
+            last_unlocked = k + 1;
+        }
+        if (k >= periods / 2) {
+            angle_sq += static_cast<double>(error) * error;
+            angle_max = std::max(angle_max, std::fabs(error));
+            speed_sum += observer.get_speed();
+        }
+    }
+
+    const size_t steady = periods - periods / 2;
+
+    return {(last_unlocked < periods) ? static_cast<float>(last_unlocked * PWM_PERIOD * 1e3) : INFINITY,
+            static_cast<float>(std::sqrt(angle_sq / steady)),
+            angle_max,
+            static_cast<float>((speed_sum / steady - omega_e) / omega_e * 100.0)};
+}
+
+/**
+ * @brief Time a function, median and 99th percentile of single calls
+ * @param[in] calls Number of calls
+ * @param[in] f     Function, called with the call index
+ * @param[out] p99  99th percentile
+ *
+ * @return Median
+ */
+template <class F>
+static uint32_t time_calls(uint32_t calls, F f, uint32_t &p99)
+{
+    std::vector<uint32_t> samples(calls);
+
+    for (uint32_t k = 0; k < calls; k++) {
+        const uint32_t start = cycles();
+        f(k);
+        samples[k] = cycles() - start;
+    }
+    std::sort(samples.begin(), samples.end());
+
+    p99 = samples[calls * 99 / 100];
+    return samples[calls / 2];
+}
+
+int main(int argc, char **argv)
+{
+    const uint32_t calls = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+
+    struct
+    {
+        const char *name;
+        float omega_e;
+        Mismatch mismatch;
+        SetupOrder order;
+    } cases[] = {
+        {"100 rad/s", 100.0f, {0.0f, 0.0f}, SetupOrder::SAMPLE_TIME_FIRST},
+        {"400 rad/s", 400.0f, {0.0f, 0.0f}, SetupOrder::SAMPLE_TIME_FIRST},
+        {"1200 rad/s", 1200.0f, {0.0f, 0.0f}, SetupOrder::SAMPLE_TIME_FIRST},
+        {"-400 rad/s", -400.0f, {0.0f, 0.0f}, SetupOrder::SAMPLE_TIME_FIRST},
+        {"400 rad/s, Rs +30%", 400.0f, {0.3f, 0.0f}, SetupOrder::SAMPLE_TIME_FIRST},
+        {"400 rad/s, Lq -20%", 400.0f, {0.0f, -0.2f}, SetupOrder::SAMPLE_TIME_FIRST},
+        {"400 rad/s, gains first", 400.0f, {0.0f, 0.0f}, SetupOrder::GAINS_FIRST},
+    };
+    bool failed = false;
+
+    printf("Sensorless current loop at held speed, Iq %.1f A, 0.25 turn initial angle error, voltage scale %.2f V\n",
+           static_cast<double>(IQ_REF), static_cast<double>(voltage_scale()));
+    printf("%-22s %10s %10s %10s %10s\n", "electrical speed", "lock [ms]", "rms [deg]", "max [deg]", "speed [%]");
+    for (const auto &c : cases) {
+        const CaseResult r = run_case(c.omega_e, c.mismatch, c.order, 0.5);
+
+        printf("%-22s %10.1f %10.2f %10.2f %10.3f\n", c.name, static_cast<double>(r.lock_time),
+               static_cast<double>(r.angle_rms), static_cast<double>(r.angle_max), static_cast<double>(r.speed_error));
+        failed |= !std::isfinite(r.lock_time) || !(std::fabs(r.speed_error) < 5.0f);
+    }
+
+    // Cycle budget, on a rotating input so that the numbers are not those of a constant
+    controller::FluxObserver observer;
+    controller::CurrentController current;
+    std::vector<float> sin_table(1024), cos_table(1024);
+    volatile float sink;
+    uint32_t p99_observer, p99_current, p99_sincos;
+
+    for (size_t i = 0; i < 1024; i++) {
+        sin_table[i] = std::sin(2.0f * static_cast<float>(M_PI) * i / 1024);
+        cos_table[i] = std::cos(2.0f * static_cast<float>(M_PI) * i / 1024);
+    }
+    observer.set_motor_params(0.5f, 1.0e-3f, 1.2e-3f, 0.01f);
+    observer.set_sample_time(static_cast<float>(PWM_PERIOD));
+    observer.set_voltage_scale(voltage_scale());
+    observer.set_flux_correction(100.0f);
+    observer.set_pll_bandwidth(600.0f);
+    current.set_Id_pi_params(0.1f, 0.005f, -0.8f, 0.8f);
+    current.set_Iq_pi_params(0.1f, 0.005f, -0.8f, 0.8f);
+
+    const uint32_t observer_cycles = time_calls(calls, [&](uint32_t k) {
+        observer.run(2.0f * cos_table[k & 1023], 2.0f * sin_table[k & 1023], 0.1f * cos_table[(k + 200) & 1023],
+                     0.1f * sin_table[(k + 200) & 1023]);
+        sink = observer.get_sin();
+    }, p99_observer);
+    const uint32_t current_cycles = time_calls(calls, [&](uint32_t k) {
+        current.run(0.1f * cos_table[k & 1023], 2.0f, sin_table[k & 1023], cos_table[k & 1023]);
+        sink = current.get_va();
+    }, p99_current);
+    const uint32_t sincos_cycles = time_calls(calls, [&](uint32_t k) {
+        float s, c;
+        math::basic::fsincosf_pu(static_cast<float>(k & 1023) / 1024.0f, s, c);
+        sink = s + c;
+    }, p99_sincos);
+    (void)sink;
+
+#if defined(__x86_64__) || defined(__i386__)
+    const char *unit = "cycles";
+#else
+    const char *unit = "ns";
+#endif
+    printf("\nCost per call, %u calls, %s, timer overhead included\n", calls, unit);
+    printf("%-34s %8s %8s\n", "", "median", "p99");
+    printf("%-34s %8u %8u\n", "FluxObserver::run", observer_cycles, p99_observer);
+    printf("%-34s %8u %8u\n", "CurrentController::run", current_cycles, p99_current);
+    printf("%-34s %8u %8u\n", "fsincosf_pu (angle based observer)", sincos_cycles, p99_sincos);
+
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
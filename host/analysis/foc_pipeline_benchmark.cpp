@@ -0,0 +1,298 @@
+/*
+ * PWM ISR cycle benchmark of the fused FocPipeline against the chained current-loop calls.
+ *
+ * One tick goes from three phase currents and the sine/cosine of the electrical angle to three duty cycles, in three
+ * ways, each in its own non-inlined function as it would run from the PWM interrupt:
+ * - chained: clarke_transform, park_transform, CurrentController::run, then set_vref_ab, run and the three
+ *   get_phase_duty_* of a separate modulator object, all in one translation unit so that the compiler may inline them;
+ * - chained, calls: the same stages, each behind a call, as when they are built in separate translation units or the
+ *   inliner gives up (-Os);
+ * - fused: FocPipeline::run.
+ * Every variant runs on the same rotating current vector with a few percent of noise and is checked bit for bit against
+ * the chained one. Each tick is timed with the TSC on x86 hosts, a nanosecond clock elsewhere. The variants run
+ * alternately for a few rounds and keep their lowest median and highest p99, so host clock drift does not show up as a
+ * difference between them.
+ *
+ * Usage: zspinlab_foc_pipeline_benchmark [ticks]
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "control/current/current_controller.hpp"
+#include "control/foc/foc_pipeline.hpp"
+#include "modulation/svpwm/svpwm_ars.hpp"
+#include "modulation/svpwm/svpwm_odtv_1n.hpp"
+#include "modulation/svpwm/svpwm_svgen.hpp"
+#include "modulation/svpwm/svpwm_zspinner.hpp"
+#include "host_timer.hpp"
+
+#define NOINLINE __attribute__((noinline))
+
+using namespace zspinlab;
+using namespace zspinlab::controller;
+
+// Measured inputs of every tick
+struct Ticks
+{
+    std::vector<float> iA, iB, iC, sin_theta, cos_theta;
+};
+
+/**
+ * @brief Rotating current vector, 50 PWM periods per electrical period, with noise
+ * @param[in] count Number of ticks
+ *
+ * @return Inputs of every tick
+ */
+static Ticks make_ticks(uint32_t count)
+{
+    std::mt19937 rng(1);
+    std::normal_distribution<float> noise(0.0f, 0.02f);
+    Ticks t;
+
+    for (uint32_t k = 0; k < count; k++) {
+        const float theta = static_cast<float>(k % 50) / 50.0f;
+        float s, c;
+
+        math::basic::fsincosf_pu(theta, s, c);
+        t.iA.push_back(0.6f * std::cos(2.0f * static_cast<float>(M_PI) * theta + 0.3f) + noise(rng));
+        t.iB.push_back(0.6f * std::cos(2.0f * static_cast<float>(M_PI) * (theta - 1.0f / 3.0f) + 0.3f) + noise(rng));
+        t.iC.push_back(0.6f * std::cos(2.0f * static_cast<float>(M_PI) * (theta + 1.0f / 3.0f) + 0.3f) + noise(rng));
+        t.sin_theta.push_back(s);
+        t.cos_theta.push_back(c);
+    }
+    return t;
+}
+
+// Chained current loop, the blocks an application wires together today
+template <class Modulator>
+struct Chained
+{
+    CurrentController current;
+    Modulator modulator;
+};
+
+/**
+ * @brief Chained current-loop tick, the compiler may inline every stage
+ *
+ * @return None
+ **/
+template <class Modulator>
+static NOINLINE void chained_tick(Chained<Modulator> &loop, const float *i, float s, float c, float *duty)
+{
+    float i_alpha, i_beta, i_d, i_q;
+
+    math::function::clarke_transform<true>(i[0], i[1], i[2], i_alpha, i_beta);
+    math::function::park_transform(i_alpha, i_beta, s, c, i_d, i_q);
+    loop.current.run(i_d, i_q, s, c);
+
+    loop.modulator.set_vref_ab(loop.current.get_va(), loop.current.get_vb());
+    loop.modulator.run();
+    duty[0] = loop.modulator.get_phase_duty_a();
+    duty[1] = loop.modulator.get_phase_duty_b();
+    duty[2] = loop.modulator.get_phase_duty_c();
+}
+
+// Stages of the chained tick behind calls, as from separate translation units
+static NOINLINE void clarke_call(float iA, float iB, float iC, float &i_alpha, float &i_beta)
+{
+    math::function::clarke_transform<true>(iA, iB, iC, i_alpha, i_beta);
+}
+
+static NOINLINE void park_call(float i_alpha, float i_beta, float s, float c, float &i_d, float &i_q)
+{
+    math::function::park_transform(i_alpha, i_beta, s, c, i_d, i_q);
+}
+
+static NOINLINE void current_call(CurrentController &current, float i_d, float i_q, float s, float c)
+{
+    current.run(i_d, i_q, s, c);
+}
+
+template <class Modulator>
+static NOINLINE void modulator_call(Modulator &modulator, float v_a, float v_b)
+{
+    modulator.set_vref_ab(v_a, v_b);
+    modulator.run();
+}
+
+/**
+ * @brief Chained current-loop tick, every stage behind a call
+ *
+ * @return None
+ **/
+template <class Modulator>
+static NOINLINE void chained_calls_tick(Chained<Modulator> &loop, const float *i, float s, float c, float *duty)
+{
+    float i_alpha, i_beta, i_d, i_q;
+
+    clarke_call(i[0], i[1], i[2], i_alpha, i_beta);
+    park_call(i_alpha, i_beta, s, c, i_d, i_q);
+    current_call(loop.current, i_d, i_q, s, c);
+
+    modulator_call(loop.modulator, loop.current.get_va(), loop.current.get_vb());
+    duty[0] = loop.modulator.get_phase_duty_a();
+    duty[1] = loop.modulator.get_phase_duty_b();
+    duty[2] = loop.modulator.get_phase_duty_c();
+}
+
+/**
+ * @brief Fused current-loop tick
+ *
+ * @return None
+ **/
+template <class Modulator>
+static NOINLINE void fused_tick(FocPipeline<Modulator> &foc, const float *i, float s, float c, float *duty)
+{
+    foc.run(i[0], i[1], i[2], s, c, duty[0], duty[1], duty[2]);
+}
+
+// The three variants of one modulator, with the same gains and references
+template <class Modulator>
+struct Variants
+{
+    Chained<Modulator> chained, chained_calls;
+    FocPipeline<Modulator> fused;
+
+    Variants()
+    {
+        for (Chained<Modulator> *loop : {&chained, &chained_calls}) {
+            loop->current.set_Id_pi_params(0.5f, 0.05f, -0.8f, 0.8f);
+            loop->current.set_Iq_pi_params(0.5f, 0.05f, -0.8f, 0.8f);
+            loop->current.set_Iq_ref(0.6f);
+        }
+        fused.set_Id_pi_params(0.5f, 0.05f, -0.8f, 0.8f);
+        fused.set_Iq_pi_params(0.5f, 0.05f, -0.8f, 0.8f);
+        fused.set_Iq_ref(0.6f);
+    }
+};
+
+// Median and p99 of the tick time of one variant
+struct Timing
+{
+    uint32_t median = UINT32_MAX;
+    uint32_t p99 = 0;
+};
+
+/**
+ * @brief Time one variant over all the ticks and merge into the best timing so far
+ * @param[in] t      Inputs of every tick
+ * @param[in] tick   Tick function (index, duty)
+ * @param[in,out] best Lowest median and highest p99 over the rounds
+ *
+ * @return None
+ */
+template <class Tick>
+static void time_round(const Ticks &t, Tick tick, Timing &best)
+{
+    std::vector<uint32_t> samples(t.iA.size());
+    float duty[3];
+
+    for (size_t k = 0; k < samples.size(); k++) {
+        const uint32_t start = cycles();
+        tick(k, duty);
+        samples[k] = cycles() - start;
+    }
+
+    std::sort(samples.begin(), samples.end());
+    best.median = std::min(best.median, samples[samples.size() / 2]);
+    best.p99 = std::max(best.p99, samples[samples.size() * 99 / 100]);
+}
+
+/**
+ * @brief Check, time and print the three variants of one modulator
+ * @param[in] name Modulator name
+ * @param[in] t    Inputs of every tick
+ *
+ * @return Number of ticks where a variant differs from the chained one
+ */
+template <class Modulator>
+static uint32_t report(const char *name, const Ticks &t)
+{
+    uint32_t mismatches = 0;
+
+    {
+        Variants<Modulator> v;
+
+        for (size_t k = 0; k < t.iA.size(); k++) {
+            const float i[3] = {t.iA[k], t.iB[k], t.iC[k]};
+            float ref[3], calls[3], fused[3];
+
+            chained_tick(v.chained, i, t.sin_theta[k], t.cos_theta[k], ref);
+            chained_calls_tick(v.chained_calls, i, t.sin_theta[k], t.cos_theta[k], calls);
+            fused_tick(v.fused, i, t.sin_theta[k], t.cos_theta[k], fused);
+
+            mismatches += (std::memcmp(ref, calls, sizeof(ref)) != 0) || (std::memcmp(ref, fused, sizeof(ref)) != 0);
+        }
+    }
+
+    Variants<Modulator> v;
+    Timing chained, chained_calls, fused;
+
+    for (int round = 0; round < 5; round++) {
+        time_round(
+            t,
+            [&](size_t k, float *duty) {
+                const float i[3] = {t.iA[k], t.iB[k], t.iC[k]};
+                chained_tick(v.chained, i, t.sin_theta[k], t.cos_theta[k], duty);
+            },
+            chained);
+        time_round(
+            t,
+            [&](size_t k, float *duty) {
+                const float i[3] = {t.iA[k], t.iB[k], t.iC[k]};
+                chained_calls_tick(v.chained_calls, i, t.sin_theta[k], t.cos_theta[k], duty);
+            },
+            chained_calls);
+        time_round(
+            t,
+            [&](size_t k, float *duty) {
+                const float i[3] = {t.iA[k], t.iB[k], t.iC[k]};
+                fused_tick(v.fused, i, t.sin_theta[k], t.cos_theta[k], duty);
+            },
+            fused);
+    }
+
+    printf("%-10s %8u %8u %8u %8u %8u %8u %+8.0f%% %+8.0f%%\n",
+           name,
+           chained.median,
+           chained.p99,
+           chained_calls.median,
+           chained_calls.p99,
+           fused.median,
+           fused.p99,
+           100.0 * (static_cast<double>(fused.median) / chained.median - 1.0),
+           100.0 * (static_cast<double>(fused.median) / chained_calls.median - 1.0));
+    return mismatches;
+}
+
+int main(int argc, char **argv)
+{
+    const uint32_t ticks = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 200000;
+
+    if (ticks < 100) {
+        fprintf(stderr, "Usage: zspinlab_foc_pipeline_benchmark [ticks >= 100]\n");
+        return EXIT_FAILURE;
+    }
+
+    const Ticks t = make_ticks(ticks);
+    uint32_t mismatches = 0;
+
+    printf("Cycles per current-loop tick, %u ticks, lowest median and highest p99 of 5 alternating rounds\n", ticks);
+    printf("%-10s %17s %17s %17s %19s\n", "", "chained", "chained, calls", "fused", "fused median vs");
+    printf("%-10s %8s %8s %8s %8s %8s %8s %9s %9s\n", "modulator", "median", "p99", "median", "p99", "median", "p99",
+           "chained", "calls");
+    mismatches += report<modulation::SVPWM_SVGen>("SVGen", t);
+    mismatches += report<modulation::SVPWM_ODTV_1N>("ODTV_1N", t);
+    mismatches += report<modulation::SVPWM_ZSpinner>("ZSpinner", t);
+    mismatches += report<modulation::SVPWM_ARS>("ARS", t);
+
+    printf("\nTicks where a variant differs from the chained duties: %u\n", mismatches);
+
+    return (mismatches != 0) ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,126 @@
+/*
+ * Out-parameter against by-value frame transforms.
+ *
+ * Runs the current loop frame chain (Clarke, Park, a proportional dq stage, inverse Park) over a buffer of samples in
+ * both styles. Each stage is kept out of line, as when the stages live in separate translation units or are too large
+ * to inline: the out-parameter stages then go through memory, while the by-value ones pass and return the frame values
+ * in registers.
+ *
+ * Usage: zspinlab_frame_types_benchmark [samples] [repeats]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "math/math_core.hpp"
+
+using namespace zspinlab::math;
+
+#define NOINLINE __attribute__((noinline))
+
+// Out-parameter stages
+NOINLINE static void clarke_out(float iA, float iB, float iC, float &i_alpha, float &i_beta)
+{
+    function::clarke_transform<true>(iA, iB, iC, i_alpha, i_beta);
+}
+
+NOINLINE static void park_out(float i_alpha, float i_beta, float sin_theta, float cos_theta, float &id, float &iq)
+{
+    function::park_transform(i_alpha, i_beta, sin_theta, cos_theta, id, iq);
+}
+
+NOINLINE static void control_out(float id, float iq, float &vd, float &vq)
+{
+    vd = 0.5f * (0.0f - id);
+    vq = 0.5f * (1.0f - iq);
+}
+
+NOINLINE static void inverse_park_out(float vd, float vq, float sin_theta, float cos_theta, float &v_alpha, float &v_beta)
+{
+    function::inverse_park_transform(vd, vq, sin_theta, cos_theta, v_alpha, v_beta);
+}
+
+// By-value stages
+NOINLINE static type::AlphaBeta clarke_value(type::Abc i_abc) { return function::clarke_transform<true>(i_abc); }
+
+NOINLINE static type::Dq park_value(type::AlphaBeta i_ab, type::SinCos theta)
+{
+    return function::park_transform(i_ab, theta);
+}
+
+NOINLINE static type::Dq control_value(type::Dq i_dq) { return {0.5f * (0.0f - i_dq.d), 0.5f * (1.0f - i_dq.q)}; }
+
+NOINLINE static type::AlphaBeta inverse_park_value(type::Dq v_dq, type::SinCos theta)
+{
+    return function::inverse_park_transform(v_dq, theta);
+}
+
+/**
+ * @brief Time a frame chain over the sample buffer
+ * @param[in] samples Buffer length
+ * @param[in] repeats Passes over the buffer
+ * @param[in] chain   Frame chain, called with the sample index
+ *
+ * @return Best nanoseconds per sample over the passes
+ */
+template <class Chain>
+static double measure(uint32_t samples, uint32_t repeats, Chain chain)
+{
+    double best = 1e30;
+
+    for (uint32_t r = 0; r < repeats; r++) {
+        const auto start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < samples; i++) {
+            chain(i);
+        }
+        const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        best = std::min(best, elapsed.count() / samples);
+    }
+    return best;
+}
+
+int main(int argc, char **argv)
+{
+    const uint32_t samples = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 4096;
+    const uint32_t repeats = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 2000;
+
+    std::vector<type::Abc> i_abc(samples);
+    std::vector<type::SinCos> theta(samples);
+    std::vector<type::AlphaBeta> out_param(samples), out_value(samples);
+
+    for (uint32_t i = 0; i < samples; i++) {
+        const float angle = 2.0f * static_cast<float>(M_PI) * i / samples;
+
+        i_abc[i] = {std::cos(angle), std::cos(angle - 2.0944f), std::cos(angle + 2.0944f)};
+        theta[i] = {std::sin(angle), std::cos(angle)};
+    }
+
+    const double ns_param = measure(samples, repeats, [&](uint32_t i) {
+        float i_alpha, i_beta, id, iq, vd, vq;
+
+        clarke_out(i_abc[i].a, i_abc[i].b, i_abc[i].c, i_alpha, i_beta);
+        park_out(i_alpha, i_beta, theta[i].sin, theta[i].cos, id, iq);
+        control_out(id, iq, vd, vq);
+        inverse_park_out(vd, vq, theta[i].sin, theta[i].cos, out_param[i].alpha, out_param[i].beta);
+    });
+
+    const double ns_value = measure(samples, repeats, [&](uint32_t i) {
+        out_value[i] = inverse_park_value(control_value(park_value(clarke_value(i_abc[i]), theta[i])), theta[i]);
+    });
+
+    uint32_t mismatches = 0;
+    for (uint32_t i = 0; i < samples; i++) {
+        mismatches += (out_param[i].alpha != out_value[i].alpha) || (out_param[i].beta != out_value[i].beta);
+    }
+
+    printf("Frame chain, %u samples, best of %u passes\n", samples, repeats);
+    printf("  out-parameter  %6.2f ns/sample\n", ns_param);
+    printf("  by-value       %6.2f ns/sample\n", ns_value);
+    printf("  mismatching outputs %u\n", mismatches);
+
+    return (mismatches != 0) ? EXIT_FAILURE : EXIT_SUCCESS;
+}
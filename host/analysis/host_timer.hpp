@@ -0,0 +1,25 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+/*
+ * Cycle counter shared by the host timing programs: the TSC on x86 hosts, a nanosecond clock elsewhere. Only the
+ * difference of two readings means something, it wraps around at 32 bits like a Cortex-M DWT cycle counter.
+ */
+
+// Read the host cycle counter
+static inline uint32_t cycles(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return static_cast<uint32_t>(__rdtsc());
+#else
+    return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now().time_since_epoch())
+                                     .count());
+#endif
+}
@@ -0,0 +1,206 @@
+/*
+ * Per-call cost of the runtime selectable ModulatorSet against calling the modulator directly.
+ *
+ * One call is set_vref_ab(), run() and the three get_phase_duty_*(), in its own non-inlined function as it would run
+ * from the PWM interrupt, on a rotating reference in the linear range. Each of these functions is flattened, so that
+ * run() is inlined in every variant as in firmware where the ISR is its only caller, instead of depending on how many
+ * callers it has in this program. For SVGen, ODTV_1N and ZSpinner:
+ * - direct: the modulator object itself;
+ * - set of 1: ModulatorSet with only this modulator, where the dispatch folds away;
+ * - set of 3: ModulatorSet<SVPWM_SVGen, SVPWM_ODTV_1N, SVPWM_ZSpinner> with this modulator selected;
+ * - std::visit: a plain std::variant of the same three modulators, every call through std::visit, for comparison.
+ * Every variant is checked bit for bit against the direct duties. Nanoseconds per call over all the ticks, the variants
+ * run alternately for 41 rounds and keep their best time, so host clock drift does not show up as a difference
+ * between them. Object sizes are printed below the table.
+ *
+ * Usage: zspinlab_modulator_set_benchmark [ticks]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <variant>
+#include <vector>
+
+#include "modulation/modulator_set.hpp"
+#include "modulation/svpwm/svpwm_odtv_1n.hpp"
+#include "modulation/svpwm/svpwm_svgen.hpp"
+#include "modulation/svpwm/svpwm_zspinner.hpp"
+
+// Not inlined into the caller, everything it calls inlined into it
+#define ISR_ENTRY __attribute__((noinline, flatten))
+
+using namespace zspinlab::modulation;
+
+using Set3 = ModulatorSet<SVPWM_SVGen, SVPWM_ODTV_1N, SVPWM_ZSpinner>;
+using Variant3 = std::variant<SVPWM_SVGen, SVPWM_ODTV_1N, SVPWM_ZSpinner>;
+
+// References of every tick
+struct Ticks
+{
+    std::vector<float> va, vb;
+};
+
+/**
+ * @brief Rotating reference in the linear range, 50 PWM periods per electrical period, slowly varying amplitude
+ * @param[in] count Number of ticks
+ *
+ * @return References of every tick
+ */
+static Ticks make_ticks(uint32_t count)
+{
+    Ticks t;
+
+    for (uint32_t k = 0; k < count; k++) {
+        const float theta = 2.0f * static_cast<float>(M_PI) * static_cast<float>(k % 50) / 50.0f;
+        const float amplitude = 0.45f + 0.4f * static_cast<float>(k % 997) / 997.0f;
+
+        t.va.push_back(amplitude * std::cos(theta));
+        t.vb.push_back(amplitude * std::sin(theta));
+    }
+    return t;
+}
+
+/**
+ * @brief One PWM period through a modulator or a ModulatorSet
+ *
+ * @return None
+ **/
+template <class Modulator>
+static ISR_ENTRY void tick(Modulator &m, float va, float vb, float *duty)
+{
+    m.set_vref_ab(va, vb);
+    m.run();
+    duty[0] = m.get_phase_duty_a();
+    duty[1] = m.get_phase_duty_b();
+    duty[2] = m.get_phase_duty_c();
+}
+
+/**
+ * @brief One PWM period through std::visit on a plain variant
+ *
+ * @return None
+ **/
+static ISR_ENTRY void visit_tick(Variant3 &v, float va, float vb, float *duty)
+{
+    std::visit(
+        [&](auto &m) {
+            m.set_vref_ab(va, vb);
+            m.run();
+            duty[0] = m.get_phase_duty_a();
+            duty[1] = m.get_phase_duty_b();
+            duty[2] = m.get_phase_duty_c();
+        },
+        v);
+}
+
+/**
+ * @brief Time one variant over all the ticks
+ * @param[in] t       References of every tick
+ * @param[in] process Tick function (va, vb, duty)
+ *
+ * @return Nanoseconds per call
+ */
+template <class Process>
+static double time_round(const Ticks &t, Process process)
+{
+    volatile float sink;
+    float duty[3];
+    float sum = 0.0f;
+
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t k = 0; k < t.va.size(); k++) {
+        process(t.va[k], t.vb[k], duty);
+        sum += duty[0];
+    }
+    const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+    sink = sum;
+    (void)sink;
+    return elapsed.count() / t.va.size();
+}
+
+/**
+ * @brief Check, time and print one modulator through the four call paths
+ * @param[in] name Modulator name
+ * @param[in] t    References of every tick
+ *
+ * @return Number of ticks where a call path differs from the direct duties
+ */
+template <class Modulator>
+static uint32_t report(const char *name, const Ticks &t)
+{
+    Modulator direct;
+    ModulatorSet<Modulator> set1;
+    Set3 set3;
+    Variant3 variant(std::in_place_type<Modulator>);
+    uint32_t mismatches = 0;
+
+    // Changeover happens on the first run()
+    set3.select<Modulator>();
+
+    for (size_t k = 0; k < t.va.size(); k++) {
+        float ref[3], d1[3], d3[3], dv[3];
+
+        tick(direct, t.va[k], t.vb[k], ref);
+        tick(set1, t.va[k], t.vb[k], d1);
+        tick(set3, t.va[k], t.vb[k], d3);
+        visit_tick(variant, t.va[k], t.vb[k], dv);
+
+        mismatches += (std::memcmp(ref, d1, sizeof(ref)) != 0) || (std::memcmp(ref, d3, sizeof(ref)) != 0) ||
+                      (std::memcmp(ref, dv, sizeof(ref)) != 0);
+    }
+
+    double ns_direct = INFINITY, ns_set1 = INFINITY, ns_set3 = INFINITY, ns_visit = INFINITY;
+
+    for (int round = 0; round < 41; round++) {
+        ns_direct = std::min(ns_direct, time_round(t, [&](float va, float vb, float *d) { tick(direct, va, vb, d); }));
+        ns_set1 = std::min(ns_set1, time_round(t, [&](float va, float vb, float *d) { tick(set1, va, vb, d); }));
+        ns_set3 = std::min(ns_set3, time_round(t, [&](float va, float vb, float *d) { tick(set3, va, vb, d); }));
+        ns_visit =
+            std::min(ns_visit, time_round(t, [&](float va, float vb, float *d) { visit_tick(variant, va, vb, d); }));
+    }
+
+    printf("%-10s %10.2f %10.2f %10.2f %10.2f %+9.1f%% %+9.1f%%\n",
+           name,
+           ns_direct,
+           ns_set1,
+           ns_set3,
+           ns_visit,
+           100.0 * (ns_set1 / ns_direct - 1.0),
+           100.0 * (ns_set3 / ns_direct - 1.0));
+    return mismatches;
+}
+
+int main(int argc, char **argv)
+{
+    const uint32_t ticks = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+
+    if (ticks == 0) {
+        fprintf(stderr, "Usage: zspinlab_modulator_set_benchmark [ticks]\n");
+        return EXIT_FAILURE;
+    }
+
+    const Ticks t = make_ticks(ticks);
+    uint32_t mismatches = 0;
+
+    printf("Nanoseconds per call, %u ticks, best of 41 alternating rounds\n", ticks);
+    printf("%-10s %10s %10s %10s %10s %21s\n", "modulator", "direct", "set of 1", "set of 3", "std::visit",
+           "vs direct: set of 1, 3");
+    mismatches += report<SVPWM_SVGen>("SVGen", t);
+    mismatches += report<SVPWM_ODTV_1N>("ODTV_1N", t);
+    mismatches += report<SVPWM_ZSpinner>("ZSpinner", t);
+
+    printf("\nBytes: SVGen %zu, ODTV_1N %zu, ZSpinner %zu, set of 1 (SVGen) %zu, set of 3 %zu\n",
+           sizeof(SVPWM_SVGen),
+           sizeof(SVPWM_ODTV_1N),
+           sizeof(SVPWM_ZSpinner),
+           sizeof(ModulatorSet<SVPWM_SVGen>),
+           sizeof(Set3));
+    printf("Ticks where a call path differs from the direct duties: %u\n", mismatches);
+
+    return (mismatches != 0) ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,217 @@
+/*
+ * PWM ISR cycle benchmark of the multi-rate control loops.
+ *
+ * Runs the current loop on every tick, the speed loop at 1/10 and the position loop at 1/20 of the PWM rate, in two ways:
+ * - naive: each slow loop runs as a whole on the ticks where the tick count is a multiple of its divider, so every
+ *   20th tick runs both of them;
+ * - scheduled: MultiRateScheduler, speed loop split in two stages, at most one stage per tick.
+ *
+ * Each tick is timed with the TSC on x86 hosts, a nanosecond clock elsewhere. The profiling probes are left out on
+ * purpose, their own overhead would dominate the slow loops. The statistics are taken per tick slot of the 20-tick
+ * period, the median of a slot is robust against the host interrupts and shows the ISR time profile, the flatter the
+ * better. The two schemes run alternately for a few rounds and each slot keeps its lowest median, so that host clock
+ * drift between the runs does not show up as a profile difference.
+ *
+ * The scheduled profile cannot be flatter than its largest stage: the ticks running a stage cost the current loop plus
+ * that stage, the spread is reported in cycles for that reason.
+ *
+ * Usage: zspinlab_multirate_isr_timing [periods]
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "control/foc/foc_pipeline.hpp"
+#include "control/position/position_controller.hpp"
+#include "control/scheduler/multirate_scheduler.hpp"
+#include "control/speed/speed_controller.hpp"
+#include "modulation/svpwm/svpwm_ars.hpp"
+#include "host_timer.hpp"
+
+using namespace zspinlab::controller;
+
+constexpr uint16_t SPEED_DIVIDER = 10;
+constexpr uint16_t POSITION_DIVIDER = 20;
+constexpr float PWM_PERIOD = 50e-6f;
+
+// Control loops and their measured inputs, shared by both schemes
+struct Loops
+{
+    FocPipeline<zspinlab::modulation::SVPWM_ARS> foc;
+    SpeedController speed;
+    PositionController position;
+
+    float theta = 0.0f;
+    float prev_theta = 0.0f;
+    float duty[3];
+
+    Loops()
+    {
+        foc.set_Id_pi_params(0.5f, 0.05f, -0.8f, 0.8f);
+        foc.set_Iq_pi_params(0.5f, 0.05f, -0.8f, 0.8f);
+        speed.set_pi_params(0.02f, 0.001f, -1.0f, 1.0f);
+        speed.set_feedback_filter(
+            zspinlab::math::function::lowpass_first_order(200.0f, 1.0f / (SPEED_DIVIDER * PWM_PERIOD)));
+        position.set_pid_params(20.0f, 0.0f, 0.0f, -300.0f, 300.0f);
+        position.set_position_ref(1.0f);
+    }
+
+    // Current loop, every tick
+    void current_loop(void)
+    {
+        const float s = std::sin(theta);
+        const float c = std::cos(theta);
+
+        theta += 0.01f;
+        foc.set_Iq_ref(speed.get_Iq_ref());
+        foc.run(0.1f * s, 0.1f * c, -0.1f * (s + c), s, c, duty[0], duty[1], duty[2]);
+    }
+
+    // Speed loop feedback, differentiates the position
+    void speed_feedback(void)
+    {
+        speed.filter_feedback((theta - prev_theta) / (SPEED_DIVIDER * PWM_PERIOD));
+        prev_theta = theta;
+    }
+
+    void speed_loop(void)
+    {
+        speed.set_speed_ref(position.get_speed_ref());
+        speed.run();
+    }
+
+    void position_loop(void) { position.run(theta); }
+};
+
+// Per tick slot statistics
+struct SlotStats
+{
+    uint32_t median;
+    uint32_t p99;
+};
+
+/**
+ * @brief Time each ISR tick and reduce the samples per tick slot
+ * @param[in] periods Number of 20-tick periods
+ * @param[in] isr     ISR body, called with the tick count
+ *
+ * @return Statistics of each slot
+ */
+template <class Isr>
+static std::vector<SlotStats> benchmark(uint32_t periods, Isr isr)
+{
+    std::vector<std::vector<uint32_t>> samples(POSITION_DIVIDER);
+    std::vector<SlotStats> stats(POSITION_DIVIDER);
+
+    for (auto &slot : samples) {
+        slot.reserve(periods);
+    }
+
+    for (uint32_t k = 0; k < periods * POSITION_DIVIDER; k++) {
+        const uint32_t start = cycles();
+        isr(k);
+        samples[k % POSITION_DIVIDER].push_back(cycles() - start);
+    }
+
+    for (uint16_t i = 0; i < POSITION_DIVIDER; i++) {
+        std::vector<uint32_t> &slot = samples[i];
+        std::sort(slot.begin(), slot.end());
+        stats[i] = {slot[slot.size() / 2], slot[slot.size() * 99 / 100]};
+    }
+    return stats;
+}
+
+/**
+ * @brief Print the slot profile and its flatness
+ * @param[in] name  Scheme name
+ * @param[in] stats Slot statistics
+ *
+ * @return None
+ */
+static void print(const char *name, const std::vector<SlotStats> &stats)
+{
+    uint32_t min = UINT32_MAX, max = 0, p99 = 0;
+
+    printf("%-10s", name);
+    for (const SlotStats &slot : stats) {
+        printf(" %5u", slot.median);
+        min = std::min(min, slot.median);
+        max = std::max(max, slot.median);
+        p99 = std::max(p99, slot.p99);
+    }
+    printf("\n%-10s median min %u, max %u (+%u cycles, %+.0f%%), worst slot p99 %u\n", "", min, max, max - min,
+           100.0 * (max - min) / min, p99);
+}
+
+/**
+ * @brief Keep the lowest median and the highest p99 of each slot over the rounds
+ * @param[in,out] best  Statistics kept so far, empty before the first round
+ * @param[in] round     Statistics of this round
+ *
+ * @return None
+ */
+static void merge(std::vector<SlotStats> &best, const std::vector<SlotStats> &round)
+{
+    if (best.empty()) {
+        best = round;
+        return;
+    }
+    for (size_t i = 0; i < best.size(); i++) {
+        best[i].median = std::min(best[i].median, round[i].median);
+        best[i].p99 = std::max(best[i].p99, round[i].p99);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    const uint32_t periods = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 100000;
+    constexpr int ROUNDS = 5;
+
+    Loops naive_loops;
+    Loops scheduled_loops;
+
+    MultiRateScheduler scheduler(make_rate_task<SPEED_DIVIDER, 2>([&](uint8_t stage) {
+                                     if (stage == 0) {
+                                         scheduled_loops.speed_feedback();
+                                     } else {
+                                         scheduled_loops.speed_loop();
+                                     }
+                                 }),
+                                 make_rate_task<POSITION_DIVIDER>([&]() { scheduled_loops.position_loop(); }));
+
+    std::vector<SlotStats> naive, scheduled;
+
+    for (int round = 0; round < ROUNDS; round++) {
+        merge(naive, benchmark(periods, [&](uint32_t k) {
+            naive_loops.current_loop();
+            if (k % SPEED_DIVIDER == 0) {
+                naive_loops.speed_feedback();
+                naive_loops.speed_loop();
+            }
+            if (k % POSITION_DIVIDER == 0) {
+                naive_loops.position_loop();
+            }
+        }));
+
+        // The scheduler keeps its phase across rounds, each round runs whole periods
+        merge(scheduled, benchmark(periods, [&](uint32_t) {
+            scheduled_loops.current_loop();
+            scheduler.tick();
+        }));
+    }
+
+    printf("Cycles per ISR tick slot, best of %d rounds of %u periods of %u ticks\n", ROUNDS, periods,
+           POSITION_DIVIDER);
+    printf("%-10s", "slot");
+    for (uint16_t i = 0; i < POSITION_DIVIDER; i++) {
+        printf(" %5u", i);
+    }
+    printf("\n");
+    print("naive", naive);
+    print("scheduled", scheduled);
+
+    return 0;
+}
@@ -0,0 +1,169 @@
+/*
+ * Stress test of the parameter publication between a tuning thread and the control loop.
+ *
+ * A writer thread publishes parameter sets back to back, every field of set n derived from n, while the main thread runs
+ * the control loop as fast as it can and checks after each tick that all the parameters in use belong to the same set.
+ * Three cases:
+ * - CurrentController, through set_Id_pi_params / set_Iq_pi_params;
+ * - PID with a ParamBlock, through publish / update_params;
+ * - baseline: the same PID gains written field by field, the tearing the parameter block removes.
+ *
+ * Usage: zspinlab_param_block_stress [ticks per case]
+ */
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+#include "control/current/current_controller.hpp"
+#include "math/math_core.hpp"
+
+using namespace zspinlab;
+
+// Field values of set n, exact in single precision
+static float field(uint32_t n, uint32_t i) { return static_cast<float>((n & 0xFFFFF) * 8 + i); }
+
+// Result of one case
+struct StressResult
+{
+    uint32_t ticks;     // Control loop ticks
+    uint32_t sets;      // Distinct sets seen by the control loop
+    uint32_t torn;      // Ticks that ran with fields of different sets
+};
+
+/**
+ * @brief Run a writer thread against the control loop and count the torn parameter sets
+ * @param[in] ticks  Control loop ticks
+ * @param[in] write  Writer, publishes set n
+ * @param[in] tick   Control loop tick, returns the set of each parameter in use
+ *
+ * @return Case result
+ */
+template <size_t Fields, class Write, class Tick>
+static StressResult stress(uint32_t ticks, Write write, Tick tick)
+{
+    std::atomic<bool> stop(false);
+    StressResult result = {ticks, 0, 0};
+    uint32_t last = UINT32_MAX;
+    float fields[Fields];
+
+    // Start from a complete set
+    write(0);
+    tick(fields);
+
+    std::thread writer([&]() {
+        for (uint32_t n = 1; !stop.load(std::memory_order_relaxed); n++) {
+            write(n);
+        }
+    });
+
+    for (uint32_t k = 0; k < ticks; k++) {
+        tick(fields);
+
+        const uint32_t n = static_cast<uint32_t>(fields[0]) / 8;
+        for (uint32_t i = 0; i < Fields; i++) {
+            if (fields[i] != field(n, i)) {
+                result.torn++;
+                break;
+            }
+        }
+        if (n != last) {
+            result.sets++;
+            last = n;
+        }
+    }
+
+    stop.store(true, std::memory_order_relaxed);
+    writer.join();
+
+    return result;
+}
+
+/**
+ * @brief Print the result of one case
+ * @param[in] name   Case name
+ * @param[in] result Case result
+ *
+ * @return None
+ */
+static void print(const char *name, const StressResult &result)
+{
+    printf("%-24s %10u ticks %10u sets %10u torn\n", name, result.ticks, result.sets, result.torn);
+}
+
+int main(int argc, char **argv)
+{
+    const uint32_t ticks = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 10000000;
+    bool failed = false;
+
+    // CurrentController, both PI units published as one set
+    {
+        controller::CurrentController current;
+
+        const StressResult result = stress<8>(
+            ticks,
+            [&](uint32_t n) {
+                current.publish_params({{field(n, 0), field(n, 1), field(n, 2), field(n, 3)},
+                                        {field(n, 4), field(n, 5), field(n, 6), field(n, 7)}});
+            },
+            [&](float *fields) {
+                current.run(0.1f, 0.2f, 0.0f, 1.0f);
+
+                const controller::CurrentController::Params params = current.get_params();
+                const float in_use[8] = {params.id.kP, params.id.kI, params.id.outMin, params.id.outMax,
+                                         params.iq.kP, params.iq.kI, params.iq.outMin, params.iq.outMax};
+                for (uint32_t i = 0; i < 8; i++) {
+                    fields[i] = in_use[i];
+                }
+            });
+        print("CurrentController", result);
+        failed |= (result.torn != 0);
+    }
+
+    // Bare PID with a parameter block
+    {
+        math::modules::PID pid;
+        math::type::ParamBlock<math::modules::PID::Params> block;
+
+        const StressResult result = stress<5>(
+            ticks,
+            [&](uint32_t n) { block.publish({field(n, 0), field(n, 1), field(n, 2), field(n, 3), field(n, 4)}); },
+            [&](float *fields) {
+                pid.update_params(block);
+                pid.run(1.0f, 0.5f, 0.0f);
+
+                const math::modules::PID::Params params = pid.get_params();
+                const float in_use[5] = {params.kP, params.kI, params.kD, params.outMin, params.outMax};
+                for (uint32_t i = 0; i < 5; i++) {
+                    fields[i] = in_use[i];
+                }
+            });
+        print("PID + ParamBlock", result);
+        failed |= (result.torn != 0);
+    }
+
+    // Baseline, field by field (relaxed atomics, so that the race stays well defined)
+    {
+        std::atomic<float> gains[5];
+        for (std::atomic<float> &gain : gains) {
+            gain.store(0.0f, std::memory_order_relaxed);
+        }
+
+        const StressResult result = stress<5>(
+            ticks,
+            [&](uint32_t n) {
+                for (uint32_t i = 0; i < 5; i++) {
+                    gains[i].store(field(n, i), std::memory_order_relaxed);
+                }
+            },
+            [&](float *fields) {
+                for (uint32_t i = 0; i < 5; i++) {
+                    fields[i] = gains[i].load(std::memory_order_relaxed);
+                }
+            });
+        print("field by field", result);
+    }
+
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
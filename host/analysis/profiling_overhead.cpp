@@ -0,0 +1,243 @@
+/*
+ * Check that the profiling probes add no code when CONFIG_ZSPINLAB_PROFILING is not set.
+ *
+ * A small translation unit calls every instrumented stage from its own function: both clarke_transform and
+ * inverse_park_transform overloads, PI::run (float and Q15) and the run() of every SVPWM modulator, which also covers
+ * limit_vref_ab. It is compiled with the host compiler against three source trees:
+ * - disabled: the library as is, without CONFIG_ZSPINLAB_PROFILING;
+ * - stripped: a copy of the library with every ZSPINLAB_PROFILE_* line removed, the code as if the probes never existed;
+ * - enabled: the library as is, with CONFIG_ZSPINLAB_PROFILING.
+ * The disabled and stripped objects must disassemble to the same instructions, and the disabled one must not reference
+ * any profiling symbol. The enabled object must differ, so that the check is known to cover the probes. The code size of
+ * each object (every function in it, also the out-of-line copies of inline library functions) is printed for the three
+ * builds, at -O2 and -Os.
+ *
+ * Usage: zspinlab_profiling_overhead [repository root] [compiler]
+ */
+
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace fs = std::filesystem;
+
+// Translation unit calling every instrumented stage, one function each
+static const char *const wrapper_source = R"(
+#include "math/math_core.hpp"
+#include "math/pi/pi.hpp"
+#include "modulation/svpwm/svpwm_ars.hpp"
+#include "modulation/svpwm/svpwm_dpwm.hpp"
+#include "modulation/svpwm/svpwm_odtv_1n.hpp"
+#include "modulation/svpwm/svpwm_svgen.hpp"
+#include "modulation/svpwm/svpwm_zspinner.hpp"
+
+using namespace zspinlab;
+using math::type::Q15;
+
+extern "C" {
+void probed_clarke(float a, float b, float c, float *al, float *be)
+{
+    math::function::clarke_transform<true>(a, b, c, *al, *be);
+}
+void probed_clarke_q15(Q15 a, Q15 b, Q15 c, Q15 *al, Q15 *be)
+{
+    math::function::clarke_transform<true>(a, b, c, *al, *be);
+}
+void probed_inverse_park(float d, float q, float s, float c, float *al, float *be)
+{
+    math::function::inverse_park_transform(d, q, s, c, *al, *be);
+}
+void probed_inverse_park_q15(Q15 d, Q15 q, Q15 s, Q15 c, Q15 *al, Q15 *be)
+{
+    math::function::inverse_park_transform(d, q, s, c, *al, *be);
+}
+float probed_pi(math::modules::PI *pi, float sp, float pv) { return pi->run(sp, pv, 0.0f); }
+Q15 probed_pi_q15(math::modules::PI_Q15 *pi, Q15 sp, Q15 pv) { return pi->run(sp, pv, Q15(0.0f)); }
+void probed_ars(modulation::SVPWM_ARS *m) { m->run(); }
+void probed_odtv_1n(modulation::SVPWM_ODTV_1N *m) { m->run(); }
+void probed_svgen(modulation::SVPWM_SVGen *m) { m->run(); }
+void probed_svgen_q15(modulation::SVPWM_SVGen_Q15 *m) { m->run(); }
+void probed_zspinner(modulation::SVPWM_ZSpinner *m) { m->run(); }
+void probed_dpwm1(modulation::SVPWM_DPWM1 *m) { m->run(); }
+}
+)";
+
+/**
+ * @brief Run a command and capture its standard output
+ * @param[in]  command Shell command
+ * @param[out] output  Standard output
+ *
+ * @return True if the command exited with status 0
+ */
+static bool run(const std::string &command, std::string &output)
+{
+    FILE *pipe = popen(command.c_str(), "r");
+    std::array<char, 4096> chunk;
+
+    output.clear();
+    if (pipe == nullptr) {
+        return false;
+    }
+    while (fgets(chunk.data(), chunk.size(), pipe) != nullptr) {
+        output += chunk.data();
+    }
+    return pclose(pipe) == 0;
+}
+
+/**
+ * @brief Copy the library sources without the probe lines
+ * @param[in] from Library source directory
+ * @param[in] to   Destination directory
+ *
+ * @return Number of probe lines removed
+ */
+static uint32_t strip_probes(const fs::path &from, const fs::path &to)
+{
+    uint32_t removed = 0;
+
+    for (const fs::directory_entry &entry : fs::recursive_directory_iterator(from)) {
+        const fs::path target = to / fs::relative(entry.path(), from);
+
+        if (entry.is_directory()) {
+            fs::create_directories(target);
+            continue;
+        }
+
+        std::ifstream in(entry.path());
+        std::ofstream out(target);
+        const bool profiler = (entry.path().filename() == "profiler.hpp");
+        std::string line;
+
+        while (std::getline(in, line)) {
+            if (!profiler && (line.find("ZSPINLAB_PROFILE_") != std::string::npos)) {
+                removed++;
+                continue;
+            }
+            out << line << '\n';
+        }
+    }
+    return removed;
+}
+
+// One compiled build of the wrapper
+struct Build
+{
+    bool ok = false;
+    std::string disassembly;            // Instructions and relocations, without the file name
+    uint32_t code = 0;                  // Bytes of all the functions in the object
+    bool references_profiling = false;  // Defines or uses a zspinlab::profiling symbol
+};
+
+/**
+ * @brief Compile the wrapper and read back its code
+ * @param[in] compiler Host C++ compiler
+ * @param[in] flags    Optimization, include and configuration flags
+ * @param[in] wrapper  Wrapper source file
+ * @param[in] object   Object file to write
+ *
+ * @return Build
+ */
+static Build compile(const std::string &compiler, const std::string &flags, const fs::path &wrapper,
+                     const fs::path &object)
+{
+    Build build;
+    std::string output;
+
+    if (!run(compiler + " -std=c++17 -c " + flags + " " + wrapper.string() + " -o " + object.string(), output)) {
+        return build;
+    }
+    if (!run("objdump -d -r --no-show-raw-insn " + object.string(), output)) {
+        return build;
+    }
+    build.disassembly = output.substr(output.find("Disassembly"));
+
+    if (!run("nm -C -S " + object.string(), output)) {
+        return build;
+    }
+
+    std::istringstream symbols(output);
+    std::string line;
+
+    while (std::getline(symbols, line)) {
+        char name[256];
+        unsigned long address, size;
+        char type;
+
+        build.references_profiling |= (line.find("profiling::") != std::string::npos);
+        if ((sscanf(line.c_str(), "%lx %lx %c %255s", &address, &size, &type, name) == 4) &&
+            ((type == 'T') || (type == 't') || (type == 'W') || (type == 'w'))) {
+            build.code += static_cast<uint32_t>(size);
+        }
+    }
+
+    build.ok = (build.code != 0);
+    return build;
+}
+
+int main(int argc, char **argv)
+{
+    const fs::path root = (argc > 1) ? argv[1] : ".";
+    const std::string compiler = (argc > 2) ? argv[2] : "c++";
+
+    if (!fs::exists(root / "src/profiling/profiler.hpp")) {
+        fprintf(stderr, "Usage: zspinlab_profiling_overhead [repository root] [compiler]\n");
+        return EXIT_FAILURE;
+    }
+
+    const fs::path work = fs::temp_directory_path() / "zspinlab_profiling_overhead";
+    const fs::path wrapper = work / "probed.cpp";
+
+    fs::remove_all(work);
+    fs::create_directories(work / "stripped");
+    std::ofstream(wrapper) << wrapper_source;
+
+    const uint32_t removed = strip_probes(root / "src", work / "stripped");
+    const std::string host_include = " -I" + (root / "host/include").string();
+    bool failed = (removed == 0);
+
+    printf("%u probe lines stripped\n", removed);
+    printf("%-6s %10s %10s %10s  %s\n", "", "stripped", "disabled", "enabled", "code bytes");
+
+    for (const char *level : {"-O2", "-Os"}) {
+        const Build stripped = compile(compiler,
+                                       std::string(level) + " -I" + (work / "stripped").string() + host_include,
+                                       wrapper,
+                                       work / "stripped.o");
+        const Build disabled = compile(compiler,
+                                       std::string(level) + " -I" + (root / "src").string() + host_include,
+                                       wrapper,
+                                       work / "disabled.o");
+        const Build enabled = compile(compiler,
+                                      std::string(level) + " -DCONFIG_ZSPINLAB_PROFILING -I" +
+                                          (root / "src").string() + host_include,
+                                      wrapper,
+                                      work / "enabled.o");
+
+        if (!stripped.ok || !disabled.ok || !enabled.ok) {
+            fprintf(stderr, "%s: the wrapper did not build with %s\n", level, compiler.c_str());
+            return EXIT_FAILURE;
+        }
+
+        const bool identical = (disabled.disassembly == stripped.disassembly);
+        const bool covered = (enabled.disassembly != stripped.disassembly) && enabled.references_profiling;
+
+        printf("%-6s %10u %10u %10u  disabled %s stripped, %s, enabled %s\n",
+               level,
+               stripped.code,
+               disabled.code,
+               enabled.code,
+               identical ? "identical to" : "DIFFERS from",
+               disabled.references_profiling ? "REFERENCES profiling" : "no profiling symbols",
+               covered ? "instrumented" : "NOT instrumented");
+
+        failed |= !identical || disabled.references_profiling || !covered;
+    }
+
+    fs::remove_all(work);
+
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
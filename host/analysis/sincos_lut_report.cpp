@@ -0,0 +1,245 @@
+/*
+ * Accuracy and throughput of the sine/cosine lookup tables, against libm.
+ *
+ * Accuracy: max absolute error of sine and cosine against double precision libm, for the three angle inputs of
+ * SinCosTable: per-unit turns on a dense grid over one turn, degrees at random over +/-1460 (four turns each way, as an
+ * unwrapped electrical angle) and radians at random over +/-2 pi. The reference is computed from the same float input,
+ * so only the table and its wrap are measured. sinf/cosf of the radian input are shown for comparison. The per-unit
+ * error of every table must stay within the interpolation bound of SinCosPrecision plus float rounding.
+ *
+ * Throughput: nanoseconds per sine/cosine pair, best of 5 runs, against sinf + cosf and sincosf. Over random angles,
+ * where a branch on the quadrant would mispredict, and over a rotating angle as in the current loop. basic::fsincosf and fsincosf_pu use the table picked by CONFIG_ZSPINLAB_SINCOS_LUT_SIZE and
+ * CONFIG_ZSPINLAB_SINCOS_LUT_QUADRATIC, the configuration rows below are the same code.
+ *
+ * Usage: zspinlab_sincos_lut_report [grid points] [angles]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "math/math_core.hpp"
+
+using namespace zspinlab::math;
+
+// Max absolute errors of one implementation, sine and cosine together
+struct Accuracy
+{
+    double pu = 0.0;
+    double deg = 0.0;
+    double rad = 0.0;
+};
+
+// Test angles, random and rotating
+struct Angles
+{
+    std::vector<float> deg, rad, pu;
+    std::vector<float> rotating_deg, rotating_rad, rotating_pu;
+};
+
+/**
+ * @brief Draw random angles in degree, radian and per-unit turn, and the same units for a rotating angle
+ * @param[in] count Number of angles
+ *
+ * @return Angles
+ */
+static Angles make_angles(uint32_t count)
+{
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> deg(-1460.0f, 1460.0f);
+    std::uniform_real_distribution<float> rad(-2.0f * static_cast<float>(M_PI), 2.0f * static_cast<float>(M_PI));
+    std::uniform_real_distribution<float> pu(0.0f, 1.0f);
+    Angles a;
+
+    for (uint32_t i = 0; i < count; i++) {
+        a.deg.push_back(deg(rng));
+        a.rad.push_back(rad(rng));
+        a.pu.push_back(pu(rng));
+
+        // Unwrapped electrical angle advancing 0.37 degree per tick, e.g. 100 Hz electrical at 96 kHz
+        const double turn = std::fmod(0.37 / 360.0 * i, 8.0) - 4.0;
+
+        a.rotating_deg.push_back(static_cast<float>(360.0 * turn));
+        a.rotating_rad.push_back(static_cast<float>(std::remainder(2.0 * M_PI * turn, 2.0 * M_PI)));
+        a.rotating_pu.push_back(static_cast<float>(turn));
+    }
+    return a;
+}
+
+// Max of the sine and cosine errors of one result against the exact angle [rad]
+static double sincos_error(float s, float c, double theta)
+{
+    return std::max(std::fabs(s - std::sin(theta)), std::fabs(c - std::cos(theta)));
+}
+
+/**
+ * @brief Max errors of a lookup table
+ * @param[in] grid   Per-unit grid points over one turn
+ * @param[in] angles Random degree and radian angles
+ *
+ * @return Max errors
+ */
+template <class Table>
+static Accuracy table_accuracy(uint32_t grid, const Angles &angles)
+{
+    Accuracy e;
+    float s, c;
+
+    for (uint32_t i = 0; i < grid; i++) {
+        const float turn = static_cast<float>(i) / grid;
+
+        Table::sincos_pu(turn, s, c);
+        e.pu = std::max(e.pu, sincos_error(s, c, 2.0 * M_PI * turn));
+    }
+    for (size_t i = 0; i < angles.deg.size(); i++) {
+        Table::sincos_deg(angles.deg[i], s, c);
+        e.deg = std::max(e.deg, sincos_error(s, c, angles.deg[i] * (M_PI / 180.0)));
+
+        Table::sincos_rad(angles.rad[i], s, c);
+        e.rad = std::max(e.rad, sincos_error(s, c, angles.rad[i]));
+    }
+    return e;
+}
+
+/**
+ * @brief Max errors of libm sinf/cosf, on radians converted from the same inputs
+ *
+ * @return Max errors
+ */
+static Accuracy libm_accuracy(uint32_t grid, const Angles &angles)
+{
+    Accuracy e;
+
+    for (uint32_t i = 0; i < grid; i++) {
+        const float turn = static_cast<float>(i) / grid;
+        const float theta = 2.0f * static_cast<float>(M_PI) * turn;
+
+        e.pu = std::max(e.pu, sincos_error(sinf(theta), cosf(theta), 2.0 * M_PI * turn));
+    }
+    for (size_t i = 0; i < angles.deg.size(); i++) {
+        const float theta = angles.deg[i] * static_cast<float>(M_PI / 180.0);
+
+        e.deg = std::max(e.deg, sincos_error(sinf(theta), cosf(theta), angles.deg[i] * (M_PI / 180.0)));
+        e.rad = std::max(e.rad, sincos_error(sinf(angles.rad[i]), cosf(angles.rad[i]), angles.rad[i]));
+    }
+    return e;
+}
+
+/**
+ * @brief Time a sine/cosine function over an array of angles, best of 5 runs
+ * @param[in] angles Input angles, in the unit of \p sincos
+ * @param[in] sincos Function (angle, sin, cos)
+ *
+ * @return Nanoseconds per call
+ */
+template <class SinCos>
+static double throughput(const std::vector<float> &angles, SinCos sincos)
+{
+    double best = INFINITY;
+    volatile float sink;
+
+    for (int run = 0; run < 5; run++) {
+        float sum = 0.0f;
+
+        const auto start = std::chrono::steady_clock::now();
+        for (float angle : angles) {
+            float s, c;
+
+            sincos(angle, s, c);
+            sum += s + c;
+        }
+        const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+        sink = sum;
+        best = std::min(best, elapsed.count() / angles.size());
+    }
+    (void)sink;
+    return best;
+}
+
+/**
+ * @brief Print one implementation
+ *
+ * @return None
+ */
+static void print(const char *name, const Accuracy &e, double bound, double ns_random, double ns_rotating)
+{
+    char bound_text[16] = "-";
+
+    if (bound > 0.0) {
+        snprintf(bound_text, sizeof(bound_text), "%.2e", bound);
+    }
+    printf("%-18s %10.2e %10.2e %10.2e %10s %8.2f %8.2f\n",
+           name,
+           e.pu,
+           e.deg,
+           e.rad,
+           bound_text,
+           ns_random,
+           ns_rotating);
+}
+
+/**
+ * @brief Measure and print one table configuration
+ *
+ * @return True if the per-unit error is within the interpolation bound
+ */
+template <size_t N, basic::SinCosPrecision precision>
+static bool report(const char *name, uint32_t grid, const Angles &angles)
+{
+    using Table = basic::SinCosTable<N, precision>;
+
+    // Interpolation bound of SinCosPrecision, plus a few float roundings of the wrap and the interpolation
+    const double h = M_PI / 2.0 / N;
+    const double bound = ((precision == basic::SinCosPrecision::QUADRATIC) ? h * h * h / 15.0 : h * h / 8.0) + 5e-7;
+    const Accuracy e = table_accuracy<Table>(grid, angles);
+    const auto sincos = [](float turn, float &s, float &c) { Table::sincos_pu(turn, s, c); };
+
+    print(name, e, bound, throughput(angles.pu, sincos), throughput(angles.rotating_pu, sincos));
+    return e.pu <= bound;
+}
+
+int main(int argc, char **argv)
+{
+    const uint32_t grid = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+    const uint32_t count = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 1000000;
+
+    if ((grid == 0) || (count == 0)) {
+        fprintf(stderr, "Usage: zspinlab_sincos_lut_report [grid points] [angles]\n");
+        return EXIT_FAILURE;
+    }
+
+    const Angles angles = make_angles(count);
+    bool passed = true;
+
+    printf("Max |error| of sine and cosine against double libm, ns per sine/cosine pair (per-unit input for the tables)\n");
+    printf("%-18s %10s %10s %10s %10s %8s %8s\n", "implementation", "pu", "deg", "rad", "pu bound", "random", "rotating");
+    passed &= report<64, basic::SinCosPrecision::LINEAR>("linear 64", grid, angles);
+    passed &= report<256, basic::SinCosPrecision::LINEAR>("linear 256", grid, angles);
+    passed &= report<1024, basic::SinCosPrecision::LINEAR>("linear 1024", grid, angles);
+    passed &= report<16, basic::SinCosPrecision::QUADRATIC>("quadratic 16", grid, angles);
+    passed &= report<64, basic::SinCosPrecision::QUADRATIC>("quadratic 64", grid, angles);
+    passed &= report<256, basic::SinCosPrecision::QUADRATIC>("quadratic 256", grid, angles);
+
+    const Accuracy e_libm = libm_accuracy(grid, angles);
+    const auto sinf_cosf = [](float theta, float &s, float &c) {
+        s = sinf(theta);
+        c = cosf(theta);
+    };
+    const auto libm_sincosf = [](float theta, float &s, float &c) { sincosf(theta, &s, &c); };
+    const auto lut_deg = [](float deg, float &s, float &c) { basic::fsincosf(deg, s, c); };
+
+    print("sinf + cosf", e_libm, 0.0, throughput(angles.rad, sinf_cosf), throughput(angles.rotating_rad, sinf_cosf));
+    print("sincosf", e_libm, 0.0, throughput(angles.rad, libm_sincosf), throughput(angles.rotating_rad, libm_sincosf));
+    print("fsincosf (deg)",
+          table_accuracy<basic::SinCosLUT>(grid, angles),
+          0.0,
+          throughput(angles.deg, lut_deg),
+          throughput(angles.rotating_deg, lut_deg));
+
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
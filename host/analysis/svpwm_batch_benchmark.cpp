@@ -0,0 +1,186 @@
+/*
+ * Throughput of the batched SVGen kernel against one SVPWM_SVGen object per axis.
+ *
+ * Before timing, svpwm_svgen_run_batch() is checked bit for bit against SVPWM_SVGen::run() in every over-modulation
+ * mode, on random references up to 1.3 (over-modulated) including zero.
+ *
+ * Each batch size is then timed both ways on the same references: N scalar calls (set_vref_ab, run, three
+ * get_phase_duty_*, one object per axis as in a multi-axis controller) against one batch call. Nanoseconds per axis,
+ * best of a few runs. Build with -O3 (or -O2 -ftree-vectorize) and -fno-math-errno to let the circle limiter vectorize.
+ *
+ * Usage: zspinlab_svpwm_batch_benchmark [ticks]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "modulation/svpwm/svpwm_batch.hpp"
+#include "modulation/svpwm/svpwm_svgen.hpp"
+
+using namespace zspinlab::modulation;
+
+// References of a batch, one row per tick
+struct References
+{
+    std::vector<float> va, vb;
+};
+
+/**
+ * @brief Draw random references
+ * @param[in] count         Number of references
+ * @param[in] amplitude_max Largest amplitude
+ * @param[in] seed          Random seed
+ *
+ * @return References, every 16th one is zero
+ */
+static References random_references(size_t count, float amplitude_max, uint32_t seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> amplitude(0.0f, amplitude_max);
+    std::uniform_real_distribution<float> angle(0.0f, 2.0f * static_cast<float>(M_PI));
+    References r = {std::vector<float>(count), std::vector<float>(count)};
+
+    for (size_t i = 0; i < count; i++) {
+        const float a = ((i & 15) == 0) ? 0.0f : amplitude(rng);
+        const float theta = angle(rng);
+
+        r.va[i] = a * std::cos(theta);
+        r.vb[i] = a * std::sin(theta);
+    }
+    return r;
+}
+
+/**
+ * @brief Compare the batch kernel with SVPWM_SVGen bit for bit
+ * @param[in] count Number of random references
+ *
+ * @return Number of references with a different duty cycle
+ */
+template <Overmodulation overmodulation>
+static uint32_t compare(size_t count)
+{
+    const References r = random_references(count, 1.3f, 1);
+    std::vector<float> dA(count), dB(count), dC(count);
+    SVPWM_SVGen modulator;
+    uint32_t mismatches = 0;
+
+    svpwm_svgen_run_batch<overmodulation>(r.va.data(), r.vb.data(), dA.data(), dB.data(), dC.data(), count);
+
+    modulator.set_overmodulation(overmodulation);
+    for (size_t i = 0; i < count; i++) {
+        modulator.set_vref_ab(r.va[i], r.vb[i]);
+        modulator.run();
+
+        const float scalar[3] = {modulator.get_phase_duty_a(), modulator.get_phase_duty_b(),
+                                 modulator.get_phase_duty_c()};
+        const float batch[3] = {dA[i], dB[i], dC[i]};
+
+        mismatches += (std::memcmp(scalar, batch, sizeof(scalar)) != 0);
+    }
+    return mismatches;
+}
+
+/**
+ * @brief Time N scalar modulators against the batch kernel
+ * @param[in] axes  Number of axes
+ * @param[in] ticks Number of PWM ticks, each with new references
+ * @param[out] scalar_ns Nanoseconds per axis, scalar calls
+ * @param[out] batch_ns  Nanoseconds per axis, batch kernel
+ *
+ * @return None
+ */
+template <Overmodulation overmodulation>
+static void time_axes(size_t axes, uint32_t ticks, double &scalar_ns, double &batch_ns)
+{
+    // A few distinct rows of references, cycled so that the inputs stay in cache as in a control loop
+    constexpr uint32_t ROWS = 64;
+    const References r = random_references(axes * ROWS, 1.0f, 2);
+    std::vector<SVPWM_SVGen> modulators(axes);
+    std::vector<float> dA(axes), dB(axes), dC(axes);
+    volatile float sink;
+
+    for (SVPWM_SVGen &modulator : modulators) {
+        modulator.set_overmodulation(overmodulation);
+    }
+
+    scalar_ns = INFINITY;
+    batch_ns = INFINITY;
+    for (int run = 0; run < 5; run++) {
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t t = 0; t < ticks; t++) {
+            const size_t row = (t % ROWS) * axes;
+
+            for (size_t i = 0; i < axes; i++) {
+                modulators[i].set_vref_ab(r.va[row + i], r.vb[row + i]);
+                modulators[i].run();
+                dA[i] = modulators[i].get_phase_duty_a();
+                dB[i] = modulators[i].get_phase_duty_b();
+                dC[i] = modulators[i].get_phase_duty_c();
+            }
+            sink = dA[0] + dB[axes - 1] + dC[axes / 2];
+        }
+        std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        scalar_ns = std::min(scalar_ns, elapsed.count() / (static_cast<double>(ticks) * axes));
+
+        start = std::chrono::steady_clock::now();
+        for (uint32_t t = 0; t < ticks; t++) {
+            const size_t row = (t % ROWS) * axes;
+
+            svpwm_svgen_run_batch<overmodulation>(&r.va[row], &r.vb[row], dA.data(), dB.data(), dC.data(), axes);
+            sink = dA[0] + dB[axes - 1] + dC[axes / 2];
+        }
+        elapsed = std::chrono::steady_clock::now() - start;
+        batch_ns = std::min(batch_ns, elapsed.count() / (static_cast<double>(ticks) * axes));
+    }
+    (void)sink;
+}
+
+/**
+ * @brief Print the batch sizes of one over-modulation mode
+ *
+ * @return None
+ */
+template <Overmodulation overmodulation>
+static void print(const char *name, uint32_t ticks)
+{
+    for (size_t axes : {1, 4, 8, 12, 64}) {
+        double scalar_ns, batch_ns;
+
+        time_axes<overmodulation>(axes, ticks, scalar_ns, batch_ns);
+        printf("%-10s %6zu %12.2f %12.2f %10.2fx\n", name, axes, scalar_ns, batch_ns, scalar_ns / batch_ns);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    const uint32_t ticks = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 200000;
+    uint32_t mismatches = 0;
+
+    printf("Bit-identity check against SVPWM_SVGen, mismatching references out of 1000000\n");
+    const uint32_t identity[] = {
+        compare<Overmodulation::DISABLED>(1000000),
+        compare<Overmodulation::UNLIMITED>(1000000),
+        compare<Overmodulation::MIN_PHASE_ERROR>(1000000),
+        compare<Overmodulation::MIN_AMPLITUDE_ERROR>(1000000),
+        compare<Overmodulation::REGION_I_II>(1000000),
+    };
+    const char *identity_names[] = {"DISABLED", "UNLIMITED", "MIN_PHASE_ERROR", "MIN_AMPLITUDE_ERROR", "REGION_I_II"};
+
+    for (uint32_t i = 0; i < 5; i++) {
+        printf("  %-20s %u\n", identity_names[i], identity[i]);
+        mismatches += identity[i];
+    }
+
+    printf("\nNanoseconds per axis, %u ticks, best of 5 runs\n", ticks);
+    printf("%-10s %6s %12s %12s %11s\n", "limit", "axes", "scalar", "batch", "speedup");
+    print<Overmodulation::DISABLED>("DISABLED", ticks);
+    print<Overmodulation::UNLIMITED>("UNLIMITED", ticks);
+
+    return (mismatches != 0) ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,299 @@
+/*
+ * Cost of one SVPWM call for every modulator: nanoseconds, instructions and latency spread.
+ *
+ * The references sweep the whole voltage hexagon and beyond it: a polar grid of amplitudes from zero to 1.15 times the
+ * hexagon vertex (1.0 is the vertex, sqrt(3)/2 the inscribed linear circle) at evenly spaced angles, visited in a
+ * random order so that the branch predictor cannot learn the sector sequence. Each modulator runs with the default
+ * circle limit (DISABLED) and with the hexagon limit (MIN_PHASE_ERROR), so the over-modulated part of the sweep goes
+ * through both limiters. One call is set_vref_ab(), run() and the three get_phase_duty_*().
+ *
+ * For every modulator and limit:
+ * - ns/call, the whole sweep timed with the steady clock, best of 5 runs;
+ * - instructions/call, from the hardware instruction counter (perf_event_open, user space only), "n/a" when the
+ *   kernel or the virtual machine does not expose it;
+ * - cycles/call of single calls: median over the sweep, and the worst grid point (highest per-point median, a data
+ *   dependent worst case unaffected by interrupts) against the p99.9 of all single calls.
+ * Before timing, every duty cycle of the sweep is checked to lie in [0, 1].
+ *
+ * Usage: zspinlab_svpwm_benchmark [angles] [amplitudes] [repeats]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "modulation/svpwm/svpwm_ars.hpp"
+#include "modulation/svpwm/svpwm_odtv_1n.hpp"
+#include "modulation/svpwm/svpwm_svgen.hpp"
+#include "modulation/svpwm/svpwm_zspinner.hpp"
+#include "host_timer.hpp"
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using namespace zspinlab::modulation;
+
+// Hardware instruction counter of this thread, invalid when the host does not expose one
+class InstructionCounter
+{
+public:
+    InstructionCounter(void)
+    {
+#if defined(__linux__)
+        struct perf_event_attr attr;
+
+        std::memset(&attr, 0, sizeof(attr));
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+    }
+
+    ~InstructionCounter(void)
+    {
+#if defined(__linux__)
+        if (fd >= 0) {
+            close(fd);
+        }
+#endif
+    }
+
+    bool valid(void) const { return fd >= 0; }
+
+    void start(void)
+    {
+#if defined(__linux__)
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+    }
+
+    // Stop counting, return the instructions since start()
+    uint64_t stop(void)
+    {
+        uint64_t count = 0;
+
+#if defined(__linux__)
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        if (read(fd, &count, sizeof(count)) != sizeof(count)) {
+            count = 0;
+        }
+#endif
+        return count;
+    }
+
+private:
+    int fd = -1;
+};
+
+// References of the sweep, in visiting order
+struct Sweep
+{
+    std::vector<float> va, vb;
+};
+
+/**
+ * @brief Build the polar sweep over the hexagon and beyond
+ * @param[in] angles     Angles per turn
+ * @param[in] amplitudes Amplitudes from zero to 1.15 times the hexagon vertex
+ *
+ * @return References in random order
+ */
+static Sweep hexagon_sweep(uint32_t angles, uint32_t amplitudes)
+{
+    std::vector<uint32_t> order(angles * amplitudes);
+    Sweep sweep = {std::vector<float>(order.size()), std::vector<float>(order.size())};
+    std::mt19937 rng(1);
+
+    for (uint32_t i = 0; i < order.size(); i++) {
+        order[i] = i;
+    }
+    std::shuffle(order.begin(), order.end(), rng);
+
+    for (uint32_t i = 0; i < order.size(); i++) {
+        const float amplitude = 1.15f * static_cast<float>(order[i] % amplitudes) / (amplitudes - 1);
+        const float theta = 2.0f * static_cast<float>(M_PI) * static_cast<float>(order[i] / amplitudes) / angles;
+
+        sweep.va[i] = amplitude * std::cos(theta);
+        sweep.vb[i] = amplitude * std::sin(theta);
+    }
+    return sweep;
+}
+
+// Cost of one modulator and limit
+struct Result
+{
+    double ns;
+    double instructions;
+    uint32_t median, worst_point, p999;
+    uint32_t out_of_range;
+};
+
+/**
+ * @brief Measure one modulator over the sweep
+ * @param[in] sweep          References
+ * @param[in] overmodulation Limit of the references beyond the linear circle
+ * @param[in] repeats        Single-call timings per reference
+ *
+ * @return Costs and the number of references with a duty cycle outside [0, 1]
+ */
+template <class Modulator>
+static Result measure(const Sweep &sweep, Overmodulation overmodulation, uint32_t repeats)
+{
+    const size_t points = sweep.va.size();
+    Modulator modulator;
+    InstructionCounter counter;
+    Result result = {INFINITY, NAN, 0, 0, 0, 0};
+    volatile float sink;
+
+    modulator.set_overmodulation(overmodulation);
+
+    for (size_t i = 0; i < points; i++) {
+        modulator.set_vref_ab(sweep.va[i], sweep.vb[i]);
+        modulator.run();
+
+        const float d[3] = {modulator.get_phase_duty_a(), modulator.get_phase_duty_b(), modulator.get_phase_duty_c()};
+
+        result.out_of_range += !std::all_of(d, d + 3, [](float x) { return (x >= 0.0f) && (x <= 1.0f); });
+    }
+
+    for (int run = 0; run < 5; run++) {
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < points; i++) {
+            modulator.set_vref_ab(sweep.va[i], sweep.vb[i]);
+            modulator.run();
+            sink = modulator.get_phase_duty_a() + modulator.get_phase_duty_b() + modulator.get_phase_duty_c();
+        }
+        const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+        result.ns = std::min(result.ns, elapsed.count() / points);
+    }
+
+    if (counter.valid()) {
+        uint64_t best = UINT64_MAX;
+
+        for (int run = 0; run < 5; run++) {
+            counter.start();
+            for (size_t i = 0; i < points; i++) {
+                modulator.set_vref_ab(sweep.va[i], sweep.vb[i]);
+                modulator.run();
+                sink = modulator.get_phase_duty_a() + modulator.get_phase_duty_b() + modulator.get_phase_duty_c();
+            }
+            best = std::min(best, counter.stop());
+        }
+        result.instructions = (best > 0) ? static_cast<double>(best) / points : NAN;
+    }
+
+    // Single calls, [repeat][point] so that every pass visits the points in the random sweep order
+    std::vector<uint32_t> samples(repeats * points);
+    std::vector<uint32_t> point_samples(repeats);
+    std::vector<uint32_t> point_medians(points);
+
+    for (uint32_t k = 0; k < repeats; k++) {
+        for (size_t i = 0; i < points; i++) {
+            const uint32_t start = cycles();
+            modulator.set_vref_ab(sweep.va[i], sweep.vb[i]);
+            modulator.run();
+            sink = modulator.get_phase_duty_a() + modulator.get_phase_duty_b() + modulator.get_phase_duty_c();
+            samples[k * points + i] = cycles() - start;
+        }
+    }
+    (void)sink;
+
+    for (size_t i = 0; i < points; i++) {
+        for (uint32_t k = 0; k < repeats; k++) {
+            point_samples[k] = samples[k * points + i];
+        }
+        std::nth_element(point_samples.begin(), point_samples.begin() + repeats / 2, point_samples.end());
+        point_medians[i] = point_samples[repeats / 2];
+    }
+    result.worst_point = *std::max_element(point_medians.begin(), point_medians.end());
+
+    std::sort(samples.begin(), samples.end());
+    result.median = samples[samples.size() / 2];
+    result.p999 = samples[samples.size() * 999 / 1000];
+
+    return result;
+}
+
+/**
+ * @brief Measure and print one modulator with both limits
+ * @param[in] name    Modulator name
+ * @param[in] sweep   References
+ * @param[in] repeats Single-call timings per reference
+ *
+ * @return Number of references with a duty cycle outside [0, 1]
+ */
+template <class Modulator>
+static uint32_t print(const char *name, const Sweep &sweep, uint32_t repeats)
+{
+    const struct
+    {
+        Overmodulation overmodulation;
+        const char *name;
+    } limits[] = {{Overmodulation::DISABLED, "circle"}, {Overmodulation::MIN_PHASE_ERROR, "hexagon"}};
+    uint32_t out_of_range = 0;
+
+    for (const auto &limit : limits) {
+        const Result r = measure<Modulator>(sweep, limit.overmodulation, repeats);
+        char instructions[16] = "n/a";
+
+        if (!std::isnan(r.instructions)) {
+            snprintf(instructions, sizeof(instructions), "%.1f", r.instructions);
+        }
+        printf("%-10s %-8s %8.2f %8s %8u %8u %8u %8u\n",
+               name,
+               limit.name,
+               r.ns,
+               instructions,
+               r.median,
+               r.worst_point,
+               r.p999,
+               r.out_of_range);
+        out_of_range += r.out_of_range;
+    }
+    return out_of_range;
+}
+
+int main(int argc, char **argv)
+{
+    const uint32_t angles = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 360;
+    const uint32_t amplitudes = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 116;
+    const uint32_t repeats = (argc > 3) ? std::strtoul(argv[3], nullptr, 10) : 21;
+
+    if ((angles == 0) || (amplitudes < 2) || (repeats == 0)) {
+        fprintf(stderr, "Usage: zspinlab_svpwm_benchmark [angles] [amplitudes >= 2] [repeats]\n");
+        return EXIT_FAILURE;
+    }
+
+    const Sweep sweep = hexagon_sweep(angles, amplitudes);
+    uint32_t out_of_range = 0;
+
+    printf("%u references (%u angles x %u amplitudes up to 1.15x the hexagon vertex), random order\n",
+           angles * amplitudes,
+           angles,
+           amplitudes);
+    printf("cycles: median of all single calls, worst grid point (median of %u calls), p99.9 of all single calls\n",
+           repeats);
+    printf("%-10s %-8s %8s %8s %8s %8s %8s %8s\n", "modulator", "limit", "ns/call", "instr", "median", "worst", "p99.9",
+           "out");
+    out_of_range += print<SVPWM_ARS>("ARS", sweep, repeats);
+    out_of_range += print<SVPWM_ODTV_1N>("ODTV_1N", sweep, repeats);
+    out_of_range += print<SVPWM_SVGen>("SVGen", sweep, repeats);
+    out_of_range += print<SVPWM_ZSpinner>("ZSpinner", sweep, repeats);
+
+    return (out_of_range != 0) ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,231 @@
+/*
+ * Angle dependence of the SVPWM run time, branchy against branchless sector sequencing.
+ *
+ * Each modulator runs on references of constant amplitude at evenly spaced angles, visited in a random order so that the
+ * branch predictor cannot learn the sector sequence, as with a noisy or fast rotating reference on target. Every call is
+ * timed and the median of each angle bin is kept; the spread (max - min) of the bin medians across the angle range is
+ * the angle dependent jitter.
+ *
+ * Before timing, the branchless modulators are checked bit for bit against the branchy ones on random references,
+ * including over-modulated ones and the sector boundaries, and their duty clamp against CLAMP() on random values and on
+ * the ones where a bit select can go wrong: +-0, NaN, infinities, denormals and the neighbours of 0 and 1.
+ *
+ * Usage: zspinlab_svpwm_branchless_timing [angle bins] [calls per bin]
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "modulation/svpwm/svpwm_ars.hpp"
+#include "modulation/svpwm/svpwm_odtv_1n.hpp"
+#include "modulation/svpwm/svpwm_zspinner.hpp"
+#include "host_timer.hpp"
+
+using namespace zspinlab::modulation;
+
+/**
+ * @brief Compare the duty cycles of two modulators bit for bit
+ * @param[in] count Number of random references
+ * @param[in] seed  Random seed
+ *
+ * @return Number of references with a different duty cycle
+ */
+template <class Branchy, class Branchless>
+static uint32_t compare(uint32_t count, uint32_t seed)
+{
+    using sample_t = typename Branchy::sample_t;
+
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> amplitude(0.0f, 1.2f);
+    std::uniform_real_distribution<float> angle(0.0f, 2.0f * static_cast<float>(M_PI));
+    Branchy branchy;
+    Branchless branchless;
+    uint32_t mismatches = 0;
+
+    branchy.allow_overmodulation(true);
+    branchless.allow_overmodulation(true);
+
+    for (uint32_t i = 0; i < count; i++) {
+        float a = amplitude(rng);
+        float theta = angle(rng);
+
+        // Every 8th reference exactly on a sector boundary
+        if ((i & 7) == 0) {
+            theta = static_cast<float>(M_PI / 3.0) * static_cast<float>(i % 6);
+            a = (i & 8) ? 0.0f : a;
+        }
+
+        const sample_t va = sample_t(0.9f * a * std::cos(theta));
+        const sample_t vb = sample_t(0.9f * a * std::sin(theta));
+
+        branchy.set_vref_ab(va, vb);
+        branchy.run();
+        branchless.set_vref_ab(va, vb);
+        branchless.run();
+
+        const sample_t d_branchy[3] = {branchy.get_phase_duty_a(), branchy.get_phase_duty_b(), branchy.get_phase_duty_c()};
+        const sample_t d_branchless[3] = {branchless.get_phase_duty_a(),
+                                          branchless.get_phase_duty_b(),
+                                          branchless.get_phase_duty_c()};
+
+        mismatches += (std::memcmp(d_branchy, d_branchless, sizeof(d_branchy)) != 0);
+    }
+    return mismatches;
+}
+
+// Exposes the branchless duty clamp of the modulators
+template <typename T>
+struct ClampProbe : SVPWM_Base<ClampProbe<T>, T>
+{
+    using SVPWM_Base<ClampProbe<T>, T>::clamp_duty_branchless;
+
+    void init(void) {}
+    void run(void) {}
+};
+
+/**
+ * @brief Compare the branchless duty clamp with CLAMP() bit for bit
+ * @param[in] count Number of random values, on top of the special ones
+ * @param[in] seed  Random seed
+ *
+ * @return Number of values clamped differently
+ */
+template <typename T>
+static uint32_t compare_clamp(uint32_t count, uint32_t seed)
+{
+    using limits = std::numeric_limits<T>;
+
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<T> value(T(-0.5), T(1.5));
+    std::vector<T> inputs = {T(0.0), -T(0.0), limits::quiet_NaN(), -limits::quiet_NaN(), limits::infinity(),
+                             -limits::infinity(), limits::denorm_min(), -limits::denorm_min(), limits::min(),
+                             -limits::min(), std::nextafter(T(1.0), T(0.0)), T(1.0), std::nextafter(T(1.0), T(2.0)),
+                             T(0.5), -T(1.0), T(2.0), limits::max(), limits::lowest()};
+    uint32_t mismatches = 0;
+
+    for (uint32_t i = 0; i < count; i++) {
+        inputs.push_back(value(rng));
+    }
+
+    for (const T d : inputs) {
+        const T branchy = CLAMP(d, T(0.0f), T(1.0f));
+        const T branchless = ClampProbe<T>::clamp_duty_branchless(d);
+
+        mismatches += (std::memcmp(&branchy, &branchless, sizeof(T)) != 0);
+    }
+    return mismatches;
+}
+
+/**
+ * @brief Time a modulator over the angle range
+ * @param[in] bins      Angle bins
+ * @param[in] calls     Calls per bin
+ * @param[in] amplitude Reference amplitude
+ *
+ * @return Median cycles of each angle bin
+ */
+template <class Modulator>
+static std::vector<uint32_t> profile(uint32_t bins, uint32_t calls, float amplitude)
+{
+    std::mt19937 rng(1);
+    std::vector<uint32_t> order(bins);
+    std::vector<std::vector<uint32_t>> samples(bins);
+    std::vector<float> va(bins), vb(bins);
+    std::vector<uint32_t> medians(bins);
+    Modulator modulator;
+    volatile float sink;
+
+    for (uint32_t i = 0; i < bins; i++) {
+        const float theta = 2.0f * static_cast<float>(M_PI) * (i + 0.5f) / bins;
+
+        va[i] = amplitude * std::cos(theta);
+        vb[i] = amplitude * std::sin(theta);
+        order[i] = i;
+        samples[i].reserve(calls);
+    }
+
+    for (uint32_t k = 0; k < calls; k++) {
+        std::shuffle(order.begin(), order.end(), rng);
+
+        for (uint32_t i : order) {
+            const uint32_t start = cycles();
+            modulator.set_vref_ab(va[i], vb[i]);
+            modulator.run();
+            sink = modulator.get_phase_duty_a();
+            samples[i].push_back(cycles() - start);
+        }
+    }
+    (void)sink;
+
+    for (uint32_t i = 0; i < bins; i++) {
+        std::nth_element(samples[i].begin(), samples[i].begin() + calls / 2, samples[i].end());
+        medians[i] = samples[i][calls / 2];
+    }
+    return medians;
+}
+
+/**
+ * @brief Print the angle profile summary of a modulator
+ * @param[in] name    Modulator name
+ * @param[in] medians Median cycles of each angle bin
+ *
+ * @return None
+ */
+static void print(const char *name, const std::vector<uint32_t> &medians)
+{
+    const auto [min, max] = std::minmax_element(medians.begin(), medians.end());
+    uint64_t sum = 0;
+
+    for (uint32_t median : medians) {
+        sum += median;
+    }
+    printf("%-22s %6.1f %6u %6u %6u\n", name, static_cast<double>(sum) / medians.size(), *min, *max, *max - *min);
+}
+
+int main(int argc, char **argv)
+{
+    const uint32_t bins = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 360;
+    const uint32_t calls = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 2000;
+    uint32_t mismatches = 0;
+
+    printf("Bit-identity check, mismatching references out of 1000000\n");
+    const uint32_t identity[] = {
+        compare<SVPWM_ARS, SVPWM_ARS_Branchless>(1000000, 1),
+        compare<SVPWM_ARS_T<double>, SVPWM_ARS_T<double, true>>(1000000, 2),
+        compare<SVPWM_ARS_Q15, SVPWM_ARS_Branchless_Q15>(1000000, 3),
+        compare<SVPWM_ARS_Q31, SVPWM_ARS_Branchless_Q31>(1000000, 4),
+        compare<SVPWM_ZSpinner, SVPWM_ZSpinner_Branchless>(1000000, 5),
+        compare<SVPWM_ZSpinner_T<double>, SVPWM_ZSpinner_T<double, true>>(1000000, 6),
+    };
+    const char *identity_names[] = {"ARS float", "ARS double", "ARS Q15", "ARS Q31", "ZSpinner float", "ZSpinner double"};
+
+    for (uint32_t i = 0; i < 6; i++) {
+        printf("  %-16s %u\n", identity_names[i], identity[i]);
+        mismatches += identity[i];
+    }
+
+    printf("\nDuty clamp against CLAMP(), mismatching values out of 1000000 and the special values\n");
+    const uint32_t clamp_identity[] = {compare_clamp<float>(1000000, 7), compare_clamp<double>(1000000, 8)};
+    const char *clamp_names[] = {"float", "double"};
+
+    for (uint32_t i = 0; i < 2; i++) {
+        printf("  %-16s %u\n", clamp_names[i], clamp_identity[i]);
+        mismatches += clamp_identity[i];
+    }
+
+    printf("\nCycles per run(), %u angle bins in random order, %u calls per bin\n", bins, calls);
+    printf("%-22s %6s %6s %6s %6s\n", "modulator", "mean", "min", "max", "spread");
+    print("ARS", profile<SVPWM_ARS>(bins, calls, 0.8f));
+    print("ARS branchless", profile<SVPWM_ARS_Branchless>(bins, calls, 0.8f));
+    print("ZSpinner", profile<SVPWM_ZSpinner>(bins, calls, 0.8f));
+    print("ZSpinner branchless", profile<SVPWM_ZSpinner_Branchless>(bins, calls, 0.8f));
+    print("ODTV_1N", profile<SVPWM_ODTV_1N>(bins, calls, 0.8f));
+
+    return (mismatches != 0) ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,181 @@
+/*
+ * Stress test of the telemetry ring buffer between the control ISR and the draining thread.
+ *
+ * A producer thread plays the ISR: it calls Telemetry::record back to back for two sources, CURRENT_CONTROLLER with six
+ * values and SVPWM with five, every value of call n derived from n. The main thread plays the low priority thread and
+ * drains the records as fast as it can. Every record read is checked:
+ * - all its values belong to the same call (no tearing) and the values beyond count are zero;
+ * - its sequence matches the call it was built from, is a multiple of the decimation and increases per source;
+ * - records read plus records dropped on overflow account for every recorded call.
+ * Three cases: every call recorded back to back, so that the buffer overflows; decimated; and paced, the producer yielding
+ * after every tick as an ISR leaves the CPU between PWM periods, so that the draining thread keeps up and reads race with
+ * writes on a buffer that is neither full nor empty.
+ * The producer also times every record() call: median, p99 and max in cycles (TSC on x86 hosts, ns elsewhere).
+ *
+ * Usage: zspinlab_telemetry_stress [calls per case]
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include "telemetry/telemetry.hpp"
+#include "host_timer.hpp"
+
+using namespace zspinlab;
+
+// Value i of call n, exact in single precision
+static float field(uint32_t n, uint32_t i) { return static_cast<float>((n & 0xFFFFF) * 8 + i); }
+
+// Result of one case
+struct StressResult
+{
+    uint32_t read;      // Records read by the draining thread
+    uint32_t dropped;   // Records dropped on overflow
+    uint32_t expected;  // Records the calls should have produced
+    uint32_t torn;      // Records with values of different calls, or stale values beyond count
+    uint32_t disorder;  // Records with a sequence that does not match the call, the decimation or the order
+    uint32_t median, p99, max;
+};
+
+/**
+ * @brief Run the producer against the draining thread and check every record
+ * @param[in] calls      Record calls per source
+ * @param[in] decimation Decimation of both sources
+ * @param[in] paced      Yield after every tick
+ *
+ * @return Case result
+ */
+static StressResult stress(uint32_t calls, uint16_t decimation, bool paced)
+{
+    telemetry::Telemetry recorder;
+    const telemetry::Source sources[2] = {telemetry::Source::CURRENT_CONTROLLER, telemetry::Source::SVPWM};
+    const uint8_t counts[2] = {6, 5};
+    std::atomic<bool> done(false);
+    std::vector<uint32_t> samples(2 * calls);
+    StressResult result = {};
+
+    recorder.set_decimation(sources[0], decimation);
+    recorder.set_decimation(sources[1], decimation);
+    recorder.enable(true);
+
+    std::thread producer([&]() {
+        for (uint32_t n = 0; n < calls; n++) {
+            for (uint32_t s = 0; s < 2; s++) {
+                float values[telemetry::RECORD_VALUES];
+
+                for (uint32_t i = 0; i < counts[s]; i++) {
+                    values[i] = field(n, i);
+                }
+
+                const uint32_t start = cycles();
+                recorder.record(sources[s], values, counts[s]);
+                samples[2 * n + s] = cycles() - start;
+            }
+            if (paced) {
+                std::this_thread::yield();
+            }
+        }
+        done.store(true, std::memory_order_release);
+    });
+
+    int64_t last[2] = {-1, -1};
+    telemetry::Record rec;
+
+    // Drain until the producer is done and the buffer is empty
+    for (bool finished = false; !finished;) {
+        finished = done.load(std::memory_order_acquire);
+
+        while (recorder.read(rec)) {
+            const uint32_t s = (rec.source == static_cast<uint8_t>(sources[0])) ? 0 : 1;
+            const uint32_t n = static_cast<uint32_t>(rec.values[0]) / 8;
+            bool torn = (rec.count != counts[s]) || (rec.source != static_cast<uint8_t>(sources[s]));
+
+            for (uint32_t i = 0; i < telemetry::RECORD_VALUES; i++) {
+                torn |= rec.values[i] != ((i < rec.count) ? field(n, i) : 0.0f);
+            }
+
+            // The sequence counts every call, the decimated record is the last of each group
+            const bool disorder = ((rec.sequence & 0xFFFFF) != n) || ((rec.sequence + 1) % decimation != 0) ||
+                                  (static_cast<int64_t>(rec.sequence) <= last[s]);
+
+            last[s] = rec.sequence;
+            result.read++;
+            result.torn += torn;
+            result.disorder += disorder;
+        }
+
+        // Empty, leave the CPU to the producer as a draining thread would sleep
+        std::this_thread::yield();
+    }
+    producer.join();
+
+    result.dropped = recorder.get_dropped();
+    result.expected = 2 * (calls / decimation);
+
+    std::sort(samples.begin(), samples.end());
+    result.median = samples[samples.size() / 2];
+    result.p99 = samples[samples.size() * 99 / 100];
+    result.max = samples.back();
+
+    return result;
+}
+
+/**
+ * @brief Print the result of one case
+ * @param[in] name   Case name
+ * @param[in] result Case result
+ *
+ * @return None
+ */
+static void print(const char *name, const StressResult &result)
+{
+    printf("%-14s %10u %10u %10u %8u %8u %8u %8u %8u\n",
+           name,
+           result.expected,
+           result.read,
+           result.dropped,
+           result.torn,
+           result.disorder,
+           result.median,
+           result.p99,
+           result.max);
+}
+
+int main(int argc, char **argv)
+{
+    const uint32_t calls = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+
+    // field() keeps 20 bits of the call index
+    if ((calls == 0) || (calls > 0xFFFFF)) {
+        fprintf(stderr, "Usage: zspinlab_telemetry_stress [calls per case, 1 to 1048575]\n");
+        return EXIT_FAILURE;
+    }
+
+    bool failed = false;
+
+    printf("%u record() calls per source, %u records buffered, record() time in cycles\n",
+           calls,
+           CONFIG_ZSPINLAB_TELEMETRY_RECORDS);
+    printf("%-14s %10s %10s %10s %8s %8s %8s %8s %8s\n", "case", "expected", "read", "dropped", "torn", "disorder",
+           "median", "p99", "max");
+
+    const struct
+    {
+        const char *name;
+        uint16_t decimation;
+        bool paced;
+    } cases[] = {{"back to back", 1, false}, {"decimated 16", 16, false}, {"paced", 1, true}};
+
+    for (const auto &c : cases) {
+        const StressResult result = stress(calls, c.decimation, c.paced);
+
+        print(c.name, result);
+        failed |= (result.torn != 0) || (result.disorder != 0) || (result.read + result.dropped != result.expected);
+    }
+
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+/*
+ * Minimal host-side stand-in for <zephyr/sys/util.h>.
+ *
+ * Only the helpers used by zspinlab are provided, with the same semantics as
+ * the Zephyr versions. Add "host/include" to the include path when building
+ * the library headers off-target (simulation, benchmarking, unit checks).
+ */
+
+#ifndef MAX
+#define MAX(a, b)               (((a) > (b)) ? (a) : (b))
+#endif
+
+#ifndef MIN
+#define MIN(a, b)               (((a) < (b)) ? (a) : (b))
+#endif
+
+#ifndef CLAMP
+#define CLAMP(val, low, high)   (((val) <= (low)) ? (low) : MIN(val, high))
+#endif
+
+#ifndef ARRAY_SIZE
+#define ARRAY_SIZE(array)       (sizeof(array) / sizeof((array)[0]))
+#endif
@@ -0,0 +1,109 @@
+#include "inverter.hpp"
+
+#include <cmath>
+
+namespace zspinlab::sim
+{
+    /**
+     * @brief Constructor, ideal switches and no ripple
+     * @param[in] vdc Mean DC-link voltage [V]
+     **/
+    Inverter::Inverter(double vdc)
+    {
+        this->vdc = vdc;
+    }
+
+    /**
+     * @brief Add a sinusoidal ripple on the DC-link voltage, e.g. the rectifier ripple of a mains supplied drive
+     * @param[in] amplitude Peak ripple [V]
+     * @param[in] frequency Ripple frequency [Hz]
+     *
+     * @return None
+     **/
+    void Inverter::set_dc_link_ripple(double amplitude, double frequency)
+    {
+        ripple_amplitude = amplitude;
+        ripple_omega = 6.283185307179586 * frequency;
+    }
+
+    /**
+     * @brief Set the dead-time inserted between the high and low side switches
+     * @param[in] dead_time  Dead-time [s]
+     * @param[in] pwm_period PWM period [s]
+     *
+     * @return None
+     **/
+    void Inverter::set_dead_time(double dead_time, double pwm_period)
+    {
+        dead_time_ratio = dead_time / pwm_period;
+    }
+
+    /**
+     * @brief Get the DC-link voltage at a given time
+     * @param[in] time Simulation time [s]
+     *
+     * @return DC-link voltage [V]
+     **/
+    double Inverter::get_dc_link(double time)
+    {
+        return vdc + ripple_amplitude * std::sin(ripple_omega * time);
+    }
+
+    /**
+     * @brief Effective high-side duty cycle of one leg
+     * @param[in] duty    Modulator duty cycle
+     * @param[in] current Phase current, positive out of the leg [A]
+     *
+     * @return Duty cycle in [0, 1]
+     **/
+    double Inverter::leg_duty(double duty, double current)
+    {
+        if (polarity == DutyPolarity::ACTIVE_LOW)
+        {
+            duty = 1.0 - duty;
+        }
+
+        // Positive current flows through the low-side diode during the dead-time and loses the volt-seconds
+        double sign = current * inv_current_band;
+        sign = (sign > 1.0) ? 1.0 : ((sign < -1.0) ? -1.0 : sign);
+
+        duty -= sign * dead_time_ratio;
+
+        return (duty > 1.0) ? 1.0 : ((duty < 0.0) ? 0.0 : duty);
+    }
+
+    /**
+     * @brief Compute the stator voltage averaged over one PWM period
+     * @param[in] dA       Phase A duty cycle
+     * @param[in] dB       Phase B duty cycle
+     * @param[in] dC       Phase C duty cycle
+     * @param[in] iA       Phase A current [A]
+     * @param[in] iB       Phase B current [A]
+     * @param[in] iC       Phase C current [A]
+     * @param[in] v_dc     DC-link voltage [V]
+     * @param[out] v_alpha Stator voltage alpha component [V]
+     * @param[out] v_beta  Stator voltage beta component [V]
+     *
+     * @return None
+     **/
+    void Inverter::run(double dA,
+                       double dB,
+                       double dC,
+                       double iA,
+                       double iB,
+                       double iC,
+                       double v_dc,
+                       double &v_alpha,
+                       double &v_beta)
+    {
+        // Leg voltages referred to the negative rail
+        const double vA = v_dc * leg_duty(dA, iA);
+        const double vB = v_dc * leg_duty(dB, iB);
+        const double vC = v_dc * leg_duty(dC, iC);
+
+        // Clarke transform removes the common-mode voltage
+        v_alpha = (2.0 / 3.0) * vA - (1.0 / 3.0) * (vB + vC);
+        v_beta = 0.5773502691896258 * (vB - vC);
+    }
+
+} // namespace zspinlab::sim
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "modulation/svpwm/duty_polarity.hpp"
+
+namespace zspinlab::sim
+{
+    using zspinlab::modulation::DutyPolarity;
+
+    /*
+     * Two-level three-phase voltage source inverter, PWM-period averaged model, host simulation only.
+     *
+     * Each leg applies its duty cycle (clamped to [0, 1]) to the instantaneous DC-link voltage. Dead-time removes
+     * t_dead / T_pwm of volt-seconds against the phase current direction, the sign is smoothed over a small current
+     * band so that the model does not chatter around the zero crossings. The DC link is a constant voltage plus an
+     * optional sinusoidal ripple. The motor is star connected without neutral, so the common-mode voltage (any duty
+     * offset shared by the three legs) does not reach the windings.
+     */
+    class Inverter
+    {
+    public:
+        Inverter(double vdc = 24.0);
+
+        // Set the mean DC-link voltage [V]
+        void set_dc_link(double vdc) { this->vdc = vdc; }
+        void set_dc_link_ripple(double amplitude, double frequency);
+        void set_dead_time(double dead_time, double pwm_period);
+        // Set the current band over which the dead-time error changes sign [A]
+        void set_dead_time_current_band(double current_band) { inv_current_band = 1.0 / current_band; }
+        // Set the duty cycle convention of the raw duties given to run()
+        void set_duty_polarity(DutyPolarity polarity) { this->polarity = polarity; }
+
+        double get_dc_link(double time);
+
+        void run(double dA,
+                 double dB,
+                 double dC,
+                 double iA,
+                 double iB,
+                 double iC,
+                 double v_dc,
+                 double &v_alpha,
+                 double &v_beta);
+
+        // Apply the duty cycles of a modulator, in the duty cycle convention of its duty_polarity trait
+        template <class Modulator>
+        void run(Modulator &modulator,
+                 double iA,
+                 double iB,
+                 double iC,
+                 double v_dc,
+                 double &v_alpha,
+                 double &v_beta)
+        {
+            polarity = Modulator::duty_polarity;
+            run(static_cast<double>(static_cast<float>(modulator.get_phase_duty_a())),
+                static_cast<double>(static_cast<float>(modulator.get_phase_duty_b())),
+                static_cast<double>(static_cast<float>(modulator.get_phase_duty_c())),
+                iA,
+                iB,
+                iC,
+                v_dc,
+                v_alpha,
+                v_beta);
+        }
+
+    private:
+        double vdc;
+        double ripple_amplitude = 0.0;  // Peak ripple [V]
+        double ripple_omega = 0.0;      // Ripple angular frequency [rad/s]
+        double dead_time_ratio = 0.0;   // t_dead / T_pwm
+        double inv_current_band = 20.0; // Inverse of the dead-time sign current band [1/A]
+        DutyPolarity polarity = DutyPolarity::ACTIVE_HIGH;
+
+        double leg_duty(double duty, double current);
+    };
+
+} // namespace zspinlab::sim
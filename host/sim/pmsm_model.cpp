@@ -0,0 +1,205 @@
+#include "pmsm_model.hpp"
+
+#include <cmath>
+
+namespace zspinlab::sim
+{
+    static constexpr double TWO_PI = 6.283185307179586;
+
+    /**
+     * @brief Constructor, rotor at standstill and angle zero
+     * @param[in] params Motor parameters
+     **/
+    PmsmModel::PmsmModel(const PmsmParameters &params)
+    {
+        this->params = params;
+        reset_state();
+    }
+
+    /**
+     * @brief Zero the currents, speed, angle and torque
+     *
+     * @return None
+     **/
+    void PmsmModel::reset_state(void)
+    {
+        id = 0.0;
+        iq = 0.0;
+        omega_m = 0.0;
+        torque = 0.0;
+        set_theta_e(0.0);
+    }
+
+    /**
+     * @brief Force the electrical angle
+     * @param[in] theta_e Electrical angle [rad]
+     *
+     * @return None
+     **/
+    void PmsmModel::set_theta_e(double theta_e)
+    {
+        this->theta_e = theta_e - TWO_PI * std::floor(theta_e * (1.0 / TWO_PI));
+        sin_theta = std::sin(this->theta_e);
+        cos_theta = std::cos(this->theta_e);
+    }
+
+    /**
+     * @brief Set the saturation table, the points are copied
+     * @param[in] current  Current magnitude breakpoints in ascending order [A]
+     * @param[in] ld_scale Ld scale factor at each breakpoint
+     * @param[in] lq_scale Lq scale factor at each breakpoint
+     * @param[in] points   Number of breakpoints, truncated to SATURATION_TABLE_SIZE
+     *
+     * @note The scale factors are linearly interpolated and held constant outside the table.
+     *
+     * @return None
+     **/
+    void PmsmModel::set_saturation_table(const double *current,
+                                         const double *ld_scale,
+                                         const double *lq_scale,
+                                         size_t points)
+    {
+        saturation_points = (points < SATURATION_TABLE_SIZE) ? points : SATURATION_TABLE_SIZE;
+
+        for (size_t i = 0; i < saturation_points; i++)
+        {
+            sat_current[i] = current[i];
+            sat_ld_scale[i] = ld_scale[i];
+            sat_lq_scale[i] = lq_scale[i];
+        }
+    }
+
+    /**
+     * @brief Get the apparent inductances at the present current magnitude
+     * @param[out] ld d-axis inductance [H]
+     * @param[out] lq q-axis inductance [H]
+     *
+     * @return None
+     **/
+    void PmsmModel::get_inductances(double &ld, double &lq)
+    {
+        ld = params.ld;
+        lq = params.lq;
+
+        if (saturation_points == 0)
+        {
+            return;
+        }
+
+        const double i_mag = std::sqrt(id * id + iq * iq);
+
+        if (i_mag <= sat_current[0])
+        {
+            ld *= sat_ld_scale[0];
+            lq *= sat_lq_scale[0];
+            return;
+        }
+
+        for (size_t i = 1; i < saturation_points; i++)
+        {
+            if (i_mag < sat_current[i])
+            {
+                const double k = (i_mag - sat_current[i - 1]) / (sat_current[i] - sat_current[i - 1]);
+
+                ld *= sat_ld_scale[i - 1] + k * (sat_ld_scale[i] - sat_ld_scale[i - 1]);
+                lq *= sat_lq_scale[i - 1] + k * (sat_lq_scale[i] - sat_lq_scale[i - 1]);
+                return;
+            }
+        }
+
+        ld *= sat_ld_scale[saturation_points - 1];
+        lq *= sat_lq_scale[saturation_points - 1];
+    }
+
+    /**
+     * @brief Integrate the motor over one time step with constant stator voltage
+     * @param[in] v_alpha Stator voltage alpha component [V]
+     * @param[in] v_beta  Stator voltage beta component [V]
+     * @param[in] dt      Time step [s], should stay well below Ld/Rs and the electrical period
+     *
+     * @note The sine and cosine of the electrical angle are advanced by rotation rather than evaluated, they are
+     * resynchronized with the angle at every electrical turn.
+     *
+     * @return None
+     **/
+    void PmsmModel::step(double v_alpha, double v_beta, double dt)
+    {
+        double ld, lq;
+
+        get_inductances(ld, lq);
+
+        const double omega_e = omega_m * params.pole_pairs;
+
+        // Park transform of the applied voltage
+        const double vd = v_alpha * cos_theta + v_beta * sin_theta;
+        const double vq = -v_alpha * sin_theta + v_beta * cos_theta;
+
+        // Electrical equations, semi-implicit
+        id += dt * (vd - params.rs * id + omega_e * lq * iq) / ld;
+        iq += dt * (vq - params.rs * iq - omega_e * (ld * id + params.psi_m)) / lq;
+
+        torque = 1.5 * params.pole_pairs * (params.psi_m * iq + (ld - lq) * id * iq);
+
+        // Mechanical equation
+        if (!held)
+        {
+            omega_m += dt * (torque - params.friction * omega_m - load_torque) / params.inertia;
+        }
+
+        const double delta = dt * omega_m * params.pole_pairs;
+
+        theta_e += delta;
+        if (theta_e >= TWO_PI || theta_e < 0.0)
+        {
+            // Resynchronize the cached trig once per electrical turn
+            set_theta_e(theta_e);
+            return;
+        }
+
+        // Rotate the cached (cos, sin) pair, truncated Taylor expansion of the small angle increment
+        const double d2 = delta * delta;
+        const double sin_delta = delta * (1.0 - d2 * (1.0 / 6.0) * (1.0 - d2 * (1.0 / 20.0)));
+        const double cos_delta = 1.0 - d2 * 0.5 * (1.0 - d2 * (1.0 / 12.0));
+        const double c = cos_theta * cos_delta - sin_theta * sin_delta;
+        const double s = sin_theta * cos_delta + cos_theta * sin_delta;
+
+        // 1/sqrt(m) ~ (3 - m) / 2 around m = 1
+        const double k = 1.5 - 0.5 * (c * c + s * s);
+
+        cos_theta = c * k;
+        sin_theta = s * k;
+    }
+
+    /**
+     * @brief Get the stator currents in the stationary reference frame
+     * @param[out] i_alpha Current alpha component [A]
+     * @param[out] i_beta  Current beta component [A]
+     *
+     * @return None
+     **/
+    void PmsmModel::get_alpha_beta_currents(double &i_alpha, double &i_beta)
+    {
+        i_alpha = id * cos_theta - iq * sin_theta;
+        i_beta = id * sin_theta + iq * cos_theta;
+    }
+
+    /**
+     * @brief Get the stator phase currents, star connection without neutral (iA + iB + iC = 0)
+     * @param[out] iA Phase A current [A]
+     * @param[out] iB Phase B current [A]
+     * @param[out] iC Phase C current [A]
+     *
+     * @return None
+     **/
+    void PmsmModel::get_phase_currents(double &iA, double &iB, double &iC)
+    {
+        double i_alpha, i_beta;
+
+        get_alpha_beta_currents(i_alpha, i_beta);
+
+        iA = i_alpha;
+        iB = -0.5 * i_alpha + 0.8660254037844386 * i_beta;
+        iC = -0.5 * i_alpha - 0.8660254037844386 * i_beta;
+    }
+
+} // namespace zspinlab::sim
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstddef>
+
+namespace zspinlab::sim
+{
+    // Electrical and mechanical parameters of a surface or interior PMSM, SI units
+    struct PmsmParameters
+    {
+        double rs;          // Stator phase resistance [Ohm]
+        double ld;          // d-axis inductance [H]
+        double lq;          // q-axis inductance [H]
+        double psi_m;       // Permanent magnet flux linkage [Wb]
+        unsigned pole_pairs;
+        double inertia;     // Rotor and load inertia [kg.m^2]
+        double friction;    // Viscous friction [N.m.s/rad]
+    };
+
+    /*
+     * PMSM model in the rotor (dq) reference frame, host simulation only.
+     *
+     * Integrates the dq voltage equations and the mechanical equation with a semi-implicit Euler scheme: the d-axis
+     * current is updated first and the q-axis equation uses the new value, which keeps the speed-voltage cross
+     * coupling energy conserving. An optional table scales Ld and Lq with the current magnitude to model iron
+     * saturation (apparent inductance, the flux linkage is L(|i|) * i).
+     */
+    class PmsmModel
+    {
+    public:
+        // Maximum number of points of the saturation table
+        static constexpr size_t SATURATION_TABLE_SIZE = 16U;
+
+        PmsmModel(const PmsmParameters &params);
+
+        void set_parameters(const PmsmParameters &params) { this->params = params; }
+        const PmsmParameters &get_parameters(void) { return params; }
+
+        void set_saturation_table(const double *current, const double *ld_scale, const double *lq_scale, size_t points);
+        void clear_saturation_table(void) { saturation_points = 0; }
+
+        // Set the load torque opposing the rotation [N.m]
+        void set_load_torque(double load_torque) { this->load_torque = load_torque; }
+
+        // Force the mechanical speed, e.g. to emulate a dynamometer holding the speed [rad/s]
+        void set_speed(double omega_m) { this->omega_m = omega_m; }
+        // Force the electrical angle [rad]
+        void set_theta_e(double theta_e);
+        // Hold the speed as a dynamometer would, 0 locks the rotor: the mechanical equation is no longer integrated
+        void hold_speed(bool held) { this->held = held; }
+
+        void reset_state(void);
+
+        void step(double v_alpha, double v_beta, double dt);
+
+        // Get the d-axis current [A]
+        double get_id(void) { return id; }
+        // Get the q-axis current [A]
+        double get_iq(void) { return iq; }
+        // Get the electrical angle, wrapped to [0, 2*pi) [rad]
+        double get_theta_e(void) { return theta_e; }
+        // Get the sine value of the electrical angle
+        double get_sin_theta(void) { return sin_theta; }
+        // Get the cosine value of the electrical angle
+        double get_cos_theta(void) { return cos_theta; }
+        // Get the mechanical speed [rad/s]
+        double get_speed(void) { return omega_m; }
+        // Get the electromagnetic torque of the last step [N.m]
+        double get_torque(void) { return torque; }
+
+        void get_alpha_beta_currents(double &i_alpha, double &i_beta);
+        void get_phase_currents(double &iA, double &iB, double &iC);
+
+    private:
+        PmsmParameters params;
+
+        // Saturation table, current magnitude breakpoints and matching inductance scale factors
+        double sat_current[SATURATION_TABLE_SIZE];
+        double sat_ld_scale[SATURATION_TABLE_SIZE];
+        double sat_lq_scale[SATURATION_TABLE_SIZE];
+        size_t saturation_points = 0;
+
+        double load_torque = 0.0;
+        bool held = false;
+
+        // State
+        double id, iq;
+        double omega_m;
+        double theta_e;
+        double sin_theta, cos_theta;    // Cached trig of theta_e, updated once per step
+        double torque;
+
+        void get_inductances(double &ld, double &lq);
+    };
+
+} // namespace zspinlab::sim
@@ -0,0 +1,91 @@
+#include "pmsm_plant.hpp"
+
+namespace zspinlab::sim
+{
+    /**
+     * @brief Constructor
+     * @param[in] params     Motor parameters
+     * @param[in] vdc        Mean DC-link voltage [V]
+     * @param[in] pwm_period PWM (and control) period [s]
+     * @param[in] substeps   Motor integration steps per PWM period
+     **/
+    PmsmPlant::PmsmPlant(const PmsmParameters &params, double vdc, double pwm_period, uint16_t substeps)
+        : inverter(vdc), motor(params)
+    {
+        this->pwm_period = pwm_period;
+        this->substeps = (substeps != 0) ? substeps : 1U;
+    }
+
+    /**
+     * @brief Restart the simulation from standstill at time zero
+     *
+     * @return None
+     **/
+    void PmsmPlant::reset_state(void)
+    {
+        motor.reset_state();
+        time = 0.0;
+    }
+
+    /**
+     * @brief Advance the plant by one PWM period
+     * @param[in] dA Phase A duty cycle
+     * @param[in] dB Phase B duty cycle
+     * @param[in] dC Phase C duty cycle
+     *
+     * @note The duty cycles and the DC-link voltage are held over the period while the motor is integrated in
+     * substeps, the dead-time error follows the phase current at each substep.
+     *
+     * @return None
+     **/
+    void PmsmPlant::run(double dA, double dB, double dC)
+    {
+        const double dt = pwm_period / substeps;
+        const double v_dc = inverter.get_dc_link(time);
+
+        for (uint16_t i = 0; i < substeps; i++)
+        {
+            double iA, iB, iC;
+            double v_alpha, v_beta;
+
+            motor.get_phase_currents(iA, iB, iC);
+            inverter.run(dA, dB, dC, iA, iB, iC, v_dc, v_alpha, v_beta);
+            motor.step(v_alpha, v_beta, dt);
+
+            time += dt;
+        }
+    }
+
+    /**
+     * @brief Get the phase currents, ready for clarke_transform
+     * @param[out] iA Phase A current [A]
+     * @param[out] iB Phase B current [A]
+     * @param[out] iC Phase C current [A]
+     *
+     * @return None
+     **/
+    void PmsmPlant::get_phase_currents(float &iA, float &iB, float &iC)
+    {
+        double a, b, c;
+
+        motor.get_phase_currents(a, b, c);
+
+        iA = static_cast<float>(a);
+        iB = static_cast<float>(b);
+        iC = static_cast<float>(c);
+    }
+
+    /**
+     * @brief Get the sine and cosine of the rotor electrical angle, as an ideal position sensor would
+     * @param[out] sin_theta Sine value of the electrical angle
+     * @param[out] cos_theta Cosine value of the electrical angle
+     *
+     * @return None
+     **/
+    void PmsmPlant::get_sincos(float &sin_theta, float &cos_theta)
+    {
+        sin_theta = static_cast<float>(motor.get_sin_theta());
+        cos_theta = static_cast<float>(motor.get_cos_theta());
+    }
+
+} // namespace zspinlab::sim
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+
+#include "inverter.hpp"
+#include "pmsm_model.hpp"
+
+namespace zspinlab::sim
+{
+    /*
+     * Closed-loop plant for host runs: inverter feeding a PMSM, advanced one PWM period per call.
+     *
+     * Feed it the duty cycles of any SVPWM_Base derivative, read back the phase currents for clarke_transform and the
+     * rotor angle for the Park transforms. Nothing here is real-time or allocation constrained, it is meant to run the
+     * control library faster than real time with no hardware attached.
+     */
+    class PmsmPlant
+    {
+    public:
+        PmsmPlant(const PmsmParameters &params, double vdc, double pwm_period, uint16_t substeps = 2U);
+
+        // Access the inverter, to set dead-time or ripple
+        Inverter &get_inverter(void) { return inverter; }
+        // Access the motor model, to set load torque, saturation or speed
+        PmsmModel &get_motor(void) { return motor; }
+
+        void reset_state(void);
+
+        void run(double dA, double dB, double dC);
+
+        // Run one PWM period from the duty cycles of a modulator, in the convention of its duty_polarity trait
+        template <class Modulator>
+        void run(Modulator &modulator)
+        {
+            inverter.set_duty_polarity(Modulator::duty_polarity);
+            run(static_cast<double>(static_cast<float>(modulator.get_phase_duty_a())),
+                static_cast<double>(static_cast<float>(modulator.get_phase_duty_b())),
+                static_cast<double>(static_cast<float>(modulator.get_phase_duty_c())));
+        }
+
+        void get_phase_currents(float &iA, float &iB, float &iC);
+        void get_sincos(float &sin_theta, float &cos_theta);
+
+        // Get the simulation time [s]
+        double get_time(void) { return time; }
+        // Get the DC-link voltage at the current time [V]
+        double get_dc_link(void) { return inverter.get_dc_link(time); }
+
+    private:
+        Inverter inverter;
+        PmsmModel motor;
+
+        double pwm_period;
+        uint16_t substeps;
+        double time = 0.0;
+    };
+
+} // namespace zspinlab::sim
@@ -0,0 +1,98 @@
+/*
+ * Current loop auto-tuner: sweeps the PI gains, the current feedback low-pass cutoff and the modulator over a grid or
+ * a random sample, simulates an Iq step for every point on the host plant and prints the best points.
+ *
+ * Usage: zspinlab_tune [--grid | --random N] [--seed S] [--threads T] [--top K]
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "sweep.hpp"
+
+using namespace zspinlab::tune;
+
+int main(int argc, char **argv)
+{
+    bool grid = false;
+    size_t count = 1000;
+    uint32_t seed = 1;
+    size_t threads = 0;
+    size_t top = 20;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const bool has_value = i + 1 < argc;
+
+        if (strcmp(argv[i], "--grid") == 0)
+        {
+            grid = true;
+        }
+        else if (strcmp(argv[i], "--random") == 0 && has_value)
+        {
+            count = strtoul(argv[++i], nullptr, 0);
+        }
+        else if (strcmp(argv[i], "--seed") == 0 && has_value)
+        {
+            seed = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 0));
+        }
+        else if (strcmp(argv[i], "--threads") == 0 && has_value)
+        {
+            threads = strtoul(argv[++i], nullptr, 0);
+        }
+        else if (strcmp(argv[i], "--top") == 0 && has_value)
+        {
+            top = strtoul(argv[++i], nullptr, 0);
+        }
+        else
+        {
+            fprintf(stderr, "usage: %s [--grid | --random N] [--seed S] [--threads T] [--top K]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    // Small 24 V servo motor at 20 kHz, Iq step at a third of the rated speed
+    const StepScenario scenario = {
+        {0.5, 1.0e-3, 1.2e-3, 0.01, 4, 1.0e-5, 1.0e-5},
+        24.0, 0.5, 100.0, 500.0e-9, 50.0e-6,
+        100.0, 2.0f, 0.0f, 0.9f,
+        20.0e-3, 0.02f,
+    };
+
+    const SweepSpace space = {
+        {0.02f, 0.5f, 6, true},
+        {0.0005f, 0.02f, 6, true},
+        {0.02f, 0.5f, 6, true},
+        {0.0005f, 0.02f, 6, true},
+        {0.0f, 5000.0f, 3, false},
+        static_cast<uint8_t>(modulator_bit(ModulatorKind::ARS) | modulator_bit(ModulatorKind::ODTV_1N) |
+                             modulator_bit(ModulatorKind::SVGEN) | modulator_bit(ModulatorKind::ZSPINNER)),
+    };
+
+    const RankingWeights weights = {1.0f, 1.0f, 4.0f};
+
+    const std::vector<TuningPoint> points = grid ? make_grid(space) : make_random(space, count, seed);
+    WorkStealingPool pool(threads);
+
+    const auto start = std::chrono::steady_clock::now();
+    const std::vector<SweepResult> results = run_sweep(scenario, points, weights, pool);
+    const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    printf("%zu points on %zu threads in %.2f s (%.1f points/s)\n\n",
+           points.size(), pool.get_threads(), elapsed, points.size() / elapsed);
+    printf("rank  modulator  id_kp    id_ki    iq_kp    iq_ki    lpf[Hz]  settle[ms]  overshoot  ripple   cost\n");
+
+    for (size_t i = 0; i < results.size() && i < top; i++)
+    {
+        const TuningPoint &p = results[i].point;
+        const StepMetrics &m = results[i].metrics;
+
+        printf("%4zu  %-9s  %-7.4f  %-7.5f  %-7.4f  %-7.5f  %-7.0f  %-10.3f  %-9.3f  %-7.4f  %.4f%s\n",
+               i + 1, get_modulator_name(p.modulator), p.id_kp, p.id_ki, p.iq_kp, p.iq_ki, p.lpf_cutoff,
+               m.settling_time * 1.0e3f, m.overshoot, m.ripple, m.cost, m.settled ? "" : "  (not settled)");
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,310 @@
+#include "sweep.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+
+#include "math/math_core.hpp"
+#include "control/current/current_controller.hpp"
+#include "modulation/svpwm/svpwm_ars.hpp"
+#include "modulation/svpwm/svpwm_odtv_1n.hpp"
+#include "modulation/svpwm/svpwm_svgen.hpp"
+#include "modulation/svpwm/svpwm_zspinner.hpp"
+#include "sim/pmsm_plant.hpp"
+
+namespace zspinlab::tune
+{
+    // Iq beyond this many steps is considered diverged, the run is stopped early
+    static constexpr float DIVERGENCE_RATIO = 10.0f;
+
+    /**
+     * @brief Get the printable name of a modulator
+     * @param[in] kind Modulator
+     *
+     * @return Modulator name
+     **/
+    const char *get_modulator_name(ModulatorKind kind)
+    {
+        switch (kind)
+        {
+        case ModulatorKind::ARS:
+            return "ARS";
+        case ModulatorKind::ODTV_1N:
+            return "ODTV_1N";
+        case ModulatorKind::SVGEN:
+            return "SVGen";
+        case ModulatorKind::ZSPINNER:
+            return "ZSpinner";
+        default:
+            return "?";
+        }
+    }
+
+    /**
+     * @brief Get a grid point of the range
+     * @param[in] step Grid point, in [0, steps)
+     *
+     * @return Parameter value
+     **/
+    float ParameterRange::at(uint16_t step) const
+    {
+        return sample((steps > 1) ? static_cast<float>(step) / (steps - 1) : 0.0f);
+    }
+
+    /**
+     * @brief Map a position in the range to a parameter value
+     * @param[in] u Position in [0, 1]
+     *
+     * @return Parameter value, linearly or geometrically spaced
+     **/
+    float ParameterRange::sample(float u) const
+    {
+        if (logarithmic)
+        {
+            return min * std::pow(max / min, u);
+        }
+
+        return min + (max - min) * u;
+    }
+
+    /**
+     * @brief Enabled modulators of a sweep space
+     * @param[in] space Sweep space
+     *
+     * @return Modulator list, in enum order
+     **/
+    static std::vector<ModulatorKind> get_modulators(const SweepSpace &space)
+    {
+        std::vector<ModulatorKind> kinds;
+
+        for (uint8_t i = 0; i < static_cast<uint8_t>(ModulatorKind::COUNT); i++)
+        {
+            if (space.modulators & modulator_bit(static_cast<ModulatorKind>(i)))
+            {
+                kinds.push_back(static_cast<ModulatorKind>(i));
+            }
+        }
+
+        return kinds;
+    }
+
+    /**
+     * @brief Build the full grid of a sweep space
+     * @param[in] space Sweep space
+     *
+     * @return Every combination of the grid points and enabled modulators
+     **/
+    std::vector<TuningPoint> make_grid(const SweepSpace &space)
+    {
+        const std::vector<ModulatorKind> kinds = get_modulators(space);
+        std::vector<TuningPoint> points;
+
+        for (ModulatorKind kind : kinds)
+            for (uint16_t a = 0; a < std::max<uint16_t>(space.id_kp.steps, 1); a++)
+                for (uint16_t b = 0; b < std::max<uint16_t>(space.id_ki.steps, 1); b++)
+                    for (uint16_t c = 0; c < std::max<uint16_t>(space.iq_kp.steps, 1); c++)
+                        for (uint16_t d = 0; d < std::max<uint16_t>(space.iq_ki.steps, 1); d++)
+                            for (uint16_t e = 0; e < std::max<uint16_t>(space.lpf_cutoff.steps, 1); e++)
+                            {
+                                points.push_back({space.id_kp.at(a),
+                                                  space.id_ki.at(b),
+                                                  space.iq_kp.at(c),
+                                                  space.iq_ki.at(d),
+                                                  space.lpf_cutoff.at(e),
+                                                  kind});
+                            }
+
+        return points;
+    }
+
+    /**
+     * @brief Draw random points of a sweep space, uniform in each (linear or logarithmic) range
+     * @param[in] space Sweep space
+     * @param[in] count Number of points
+     * @param[in] seed  Random seed, the same seed gives the same points
+     *
+     * @return Random points
+     **/
+    std::vector<TuningPoint> make_random(const SweepSpace &space, size_t count, uint32_t seed)
+    {
+        const std::vector<ModulatorKind> kinds = get_modulators(space);
+        std::vector<TuningPoint> points;
+
+        if (kinds.empty())
+        {
+            return points;
+        }
+
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> u(0.0f, 1.0f);
+        std::uniform_int_distribution<size_t> k(0, kinds.size() - 1);
+
+        points.reserve(count);
+        for (size_t i = 0; i < count; i++)
+        {
+            TuningPoint point;
+
+            point.id_kp = space.id_kp.sample(u(rng));
+            point.id_ki = space.id_ki.sample(u(rng));
+            point.iq_kp = space.iq_kp.sample(u(rng));
+            point.iq_ki = space.iq_ki.sample(u(rng));
+            point.lpf_cutoff = space.lpf_cutoff.sample(u(rng));
+            point.modulator = kinds[k(rng)];
+
+            points.push_back(point);
+        }
+
+        return points;
+    }
+
+    /**
+     * @brief Run the step scenario with a given modulator
+     * @param[in] scenario Step scenario
+     * @param[in] point    Tuning point
+     *
+     * @return Step response metrics, cost not set
+     **/
+    template <class Modulator>
+    static StepMetrics simulate(const StepScenario &scenario, const TuningPoint &point)
+    {
+        using namespace zspinlab::math;
+
+        zspinlab::sim::PmsmPlant plant(scenario.motor, scenario.vdc, scenario.pwm_period);
+        zspinlab::controller::CurrentController controller;
+        Modulator modulator;
+
+        plant.get_inverter().set_dead_time(scenario.dead_time, scenario.pwm_period);
+        plant.get_inverter().set_dc_link_ripple(scenario.dc_ripple, scenario.ripple_frequency);
+        plant.get_motor().set_speed(scenario.speed);
+        plant.get_motor().hold_speed(true);
+
+        controller.set_Id_pi_params(point.id_kp, point.id_ki, -scenario.out_limit, scenario.out_limit);
+        controller.set_Iq_pi_params(point.iq_kp, point.iq_ki, -scenario.out_limit, scenario.out_limit);
+        controller.set_Id_ref(scenario.id_ref);
+        controller.set_Iq_ref(scenario.iq_step);
+
+        modulator.init();
+
+        const bool filtered = point.lpf_cutoff > 0.0f;
+        const float fs = static_cast<float>(1.0 / scenario.pwm_period);
+        modules::LowPassFirstOrder lpf_id(function::lowpass_first_order(filtered ? point.lpf_cutoff : fs * 0.25f, fs));
+        modules::LowPassFirstOrder lpf_iq(function::lowpass_first_order(filtered ? point.lpf_cutoff : fs * 0.25f, fs));
+
+        const size_t periods = static_cast<size_t>(scenario.duration / scenario.pwm_period);
+        const size_t steady = periods - periods / 4;
+        const float band = scenario.settling_band * std::fabs(scenario.iq_step);
+
+        StepMetrics metrics = {};
+        float peak = 0.0f;
+        double error_sq = 0.0;
+        size_t last_outside = 0;
+
+        for (size_t k = 0; k < periods; k++)
+        {
+            float iA, iB, iC, i_alpha, i_beta, id, iq, sin_theta, cos_theta;
+
+            plant.get_phase_currents(iA, iB, iC);
+            plant.get_sincos(sin_theta, cos_theta);
+
+            function::clarke_transform<true>(iA, iB, iC, i_alpha, i_beta);
+            function::park_transform(i_alpha, i_beta, sin_theta, cos_theta, id, iq);
+
+            if (filtered)
+            {
+                id = lpf_id.run(id);
+                iq = lpf_iq.run(iq);
+            }
+
+            controller.run(id, iq, sin_theta, cos_theta);
+            modulator.set_vref_ab(controller.get_va(), controller.get_vb());
+            modulator.run();
+            plant.run(modulator);
+
+            // Score the true motor current, not the filtered measurement
+            const float error = static_cast<float>(plant.get_motor().get_iq()) - scenario.iq_step;
+
+            if (!std::isfinite(error) || std::fabs(error) > DIVERGENCE_RATIO * std::fabs(scenario.iq_step))
+            {
+                metrics.settling_time = std::numeric_limits<float>::infinity();
+                metrics.overshoot = std::numeric_limits<float>::infinity();
+                metrics.ripple = std::numeric_limits<float>::infinity();
+                metrics.settled = false;
+                return metrics;
+            }
+
+            peak = std::max(peak, (scenario.iq_step >= 0.0f) ? error : -error);
+            if (std::fabs(error) > band)
+            {
+                last_outside = k + 1;
+            }
+            if (k >= steady)
+            {
+                error_sq += static_cast<double>(error) * error;
+            }
+        }
+
+        metrics.settled = last_outside < periods;
+        metrics.settling_time = static_cast<float>(last_outside * scenario.pwm_period);
+        metrics.overshoot = peak / std::fabs(scenario.iq_step);
+        metrics.ripple = static_cast<float>(std::sqrt(error_sq / (periods - steady))) / std::fabs(scenario.iq_step);
+
+        return metrics;
+    }
+
+    /**
+     * @brief Run the step scenario for one tuning point
+     * @param[in] scenario Step scenario
+     * @param[in] point    Tuning point
+     *
+     * @return Step response metrics, cost not set
+     **/
+    StepMetrics simulate_step(const StepScenario &scenario, const TuningPoint &point)
+    {
+        switch (point.modulator)
+        {
+        case ModulatorKind::ARS:
+            return simulate<zspinlab::modulation::SVPWM_ARS>(scenario, point);
+        case ModulatorKind::ODTV_1N:
+            return simulate<zspinlab::modulation::SVPWM_ODTV_1N>(scenario, point);
+        case ModulatorKind::SVGEN:
+            return simulate<zspinlab::modulation::SVPWM_SVGen>(scenario, point);
+        case ModulatorKind::ZSPINNER:
+        default:
+            return simulate<zspinlab::modulation::SVPWM_ZSpinner>(scenario, point);
+        }
+    }
+
+    /**
+     * @brief Simulate every point in parallel and rank the results
+     * @param[in] scenario Step scenario
+     * @param[in] points   Tuning points
+     * @param[in] weights  Ranking weights
+     * @param[in] pool     Worker pool
+     *
+     * @return Results sorted by increasing cost, diverged points last
+     **/
+    std::vector<SweepResult> run_sweep(const StepScenario &scenario,
+                                       const std::vector<TuningPoint> &points,
+                                       const RankingWeights &weights,
+                                       WorkStealingPool &pool)
+    {
+        std::vector<SweepResult> results(points.size());
+
+        pool.parallel_for(points.size(), [&](size_t i) {
+            StepMetrics metrics = simulate_step(scenario, points[i]);
+
+            metrics.cost = weights.settling * metrics.settling_time / static_cast<float>(scenario.duration) +
+                           weights.overshoot * metrics.overshoot + weights.ripple * metrics.ripple;
+
+            results[i] = {points[i], metrics};
+        });
+
+        std::stable_sort(results.begin(), results.end(), [](const SweepResult &a, const SweepResult &b) {
+            return a.metrics.cost < b.metrics.cost;
+        });
+
+        return results;
+    }
+
+} // namespace zspinlab::tune
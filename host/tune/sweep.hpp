@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "sim/pmsm_model.hpp"
+#include "work_stealing_pool.hpp"
+
+namespace zspinlab::tune
+{
+    // Modulators that can be swept
+    enum class ModulatorKind : uint8_t
+    {
+        ARS = 0,
+        ODTV_1N,
+        SVGEN,
+        ZSPINNER,
+        COUNT,
+    };
+
+    // Bit of a modulator in SweepSpace::modulators
+    constexpr uint8_t modulator_bit(ModulatorKind kind) { return static_cast<uint8_t>(1U << static_cast<uint8_t>(kind)); }
+
+    const char *get_modulator_name(ModulatorKind kind);
+
+    // One candidate tuning
+    struct TuningPoint
+    {
+        float id_kp, id_ki;     // Id PI gains, as CurrentController::set_Id_pi_params
+        float iq_kp, iq_ki;     // Iq PI gains, as CurrentController::set_Iq_pi_params
+        float lpf_cutoff;       // First-order low-pass cutoff on the measured Id/Iq [Hz], 0 disables the filter
+        ModulatorKind modulator;
+    };
+
+    // Swept range of one parameter
+    struct ParameterRange
+    {
+        float min, max;
+        uint16_t steps;         // Grid points, 1 keeps min only
+        bool logarithmic;       // Space the points geometrically, min must then be positive
+
+        float at(uint16_t step) const;
+        float sample(float u) const;
+    };
+
+    // Parameter space of a sweep
+    struct SweepSpace
+    {
+        ParameterRange id_kp, id_ki;
+        ParameterRange iq_kp, iq_ki;
+        ParameterRange lpf_cutoff;
+        uint8_t modulators;     // Set of modulator_bit()
+    };
+
+    // Closed-loop test run for every point: Iq step with the rotor held at a constant speed by a dynamometer
+    struct StepScenario
+    {
+        zspinlab::sim::PmsmParameters motor;
+        double vdc;             // DC-link voltage [V]
+        double dc_ripple;       // DC-link peak ripple [V]
+        double ripple_frequency;// DC-link ripple frequency [Hz]
+        double dead_time;       // Inverter dead-time [s]
+        double pwm_period;      // PWM and control period [s]
+        double speed;           // Dynamometer mechanical speed [rad/s]
+        float iq_step;          // Iq reference step [A]
+        float id_ref;           // Id reference [A]
+        float out_limit;        // PI output limit, normalized voltage
+        double duration;        // Simulated time after the step [s]
+        float settling_band;    // Settling band, relative to iq_step
+    };
+
+    // Weights of the ranking cost, each metric is normalized first
+    struct RankingWeights
+    {
+        float settling;         // Settling time, relative to the run duration
+        float overshoot;        // Overshoot, relative to iq_step
+        float ripple;           // Steady-state RMS Iq error, relative to iq_step
+    };
+
+    // Step response quality of one point
+    struct StepMetrics
+    {
+        float settling_time;    // Time after which Iq stays in the settling band [s], the run duration if it never does
+        float overshoot;        // Peak Iq above the reference, relative to iq_step
+        float ripple;           // RMS Iq error over the last quarter of the run, relative to iq_step
+        bool settled;           // False if the response never settled or diverged
+        float cost;             // Weighted cost, lower is better
+    };
+
+    // Result of one point
+    struct SweepResult
+    {
+        TuningPoint point;
+        StepMetrics metrics;
+    };
+
+    std::vector<TuningPoint> make_grid(const SweepSpace &space);
+    std::vector<TuningPoint> make_random(const SweepSpace &space, size_t count, uint32_t seed);
+
+    StepMetrics simulate_step(const StepScenario &scenario, const TuningPoint &point);
+
+    std::vector<SweepResult> run_sweep(const StepScenario &scenario,
+                                       const std::vector<TuningPoint> &points,
+                                       const RankingWeights &weights,
+                                       WorkStealingPool &pool);
+
+} // namespace zspinlab::tune
@@ -0,0 +1,128 @@
+#include "work_stealing_pool.hpp"
+
+#include <thread>
+#include <vector>
+
+namespace zspinlab::tune
+{
+    /**
+     * @brief Constructor
+     * @param[in] threads Number of worker threads, 0 uses one per hardware thread
+     **/
+    WorkStealingPool::WorkStealingPool(size_t threads)
+    {
+        if (threads == 0)
+        {
+            threads = std::thread::hardware_concurrency();
+        }
+
+        this->threads = (threads != 0) ? threads : 1U;
+        queues = std::make_unique<Queue[]>(this->threads);
+    }
+
+    /**
+     * @brief Take the next job of a worker own queue
+     * @param[in] worker Worker number
+     * @param[out] index Job index
+     *
+     * @return True if a job was taken
+     **/
+    bool WorkStealingPool::pop(size_t worker, size_t &index)
+    {
+        Queue &queue = queues[worker];
+        std::lock_guard<std::mutex> guard(queue.lock);
+
+        if (queue.jobs.empty())
+        {
+            return false;
+        }
+
+        index = queue.jobs.back();
+        queue.jobs.pop_back();
+        return true;
+    }
+
+    /**
+     * @brief Take a job from another worker queue, from the end opposite to its owner
+     * @param[in] worker Thief worker number
+     * @param[out] index Job index
+     *
+     * @return True if a job was stolen, false when every queue is empty
+     **/
+    bool WorkStealingPool::steal(size_t worker, size_t &index)
+    {
+        for (size_t i = 1; i < threads; i++)
+        {
+            Queue &queue = queues[(worker + i) % threads];
+            std::lock_guard<std::mutex> guard(queue.lock);
+
+            if (!queue.jobs.empty())
+            {
+                index = queue.jobs.front();
+                queue.jobs.pop_front();
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /**
+     * @brief Worker loop, runs until no job is left anywhere
+     * @param[in] worker Worker number
+     * @param[in] job    Job function
+     *
+     * @note Jobs are only dealt before the workers start, so once every queue is empty no job can appear anymore.
+     *
+     * @return None
+     **/
+    void WorkStealingPool::work(size_t worker, const std::function<void(size_t)> &job)
+    {
+        size_t index;
+
+        while (pop(worker, index) || steal(worker, index))
+        {
+            job(index);
+        }
+    }
+
+    /**
+     * @brief Run job(0) ... job(count - 1) on the worker threads and wait for all of them
+     * @param[in] count Number of jobs
+     * @param[in] job   Job function, called concurrently with different indices
+     *
+     * @return None
+     **/
+    void WorkStealingPool::parallel_for(size_t count, const std::function<void(size_t)> &job)
+    {
+        // Deal contiguous slices, the owner pops from the back so it walks its slice downwards
+        for (size_t worker = 0; worker < threads; worker++)
+        {
+            const size_t first = count * worker / threads;
+            const size_t last = count * (worker + 1) / threads;
+
+            queues[worker].jobs.clear();
+            for (size_t index = first; index < last; index++)
+            {
+                queues[worker].jobs.push_back(index);
+            }
+        }
+
+        std::vector<std::thread> workers;
+        workers.reserve(threads - 1);
+
+        for (size_t worker = 1; worker < threads; worker++)
+        {
+            workers.emplace_back(&WorkStealingPool::work, this, worker, std::cref(job));
+        }
+
+        // The calling thread is worker 0
+        work(0, job);
+
+        for (std::thread &t : workers)
+        {
+            t.join();
+        }
+    }
+
+} // namespace zspinlab::tune
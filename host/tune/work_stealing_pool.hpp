@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+namespace zspinlab::tune
+{
+    /*
+     * Work-stealing parallel-for, host tools only.
+     *
+     * Indices are dealt in contiguous slices to one deque per worker. A worker pops from the back of its own deque and,
+     * once empty, steals from the front of the others, so uneven job durations (e.g. diverging simulations stopped
+     * early) do not leave cores idle. Jobs must be independent.
+     */
+    class WorkStealingPool
+    {
+    public:
+        WorkStealingPool(size_t threads = 0U);
+
+        // Get the number of worker threads
+        size_t get_threads(void) { return threads; }
+
+        void parallel_for(size_t count, const std::function<void(size_t)> &job);
+
+    private:
+        struct Queue
+        {
+            std::mutex lock;
+            std::deque<size_t> jobs;
+        };
+
+        size_t threads;
+        std::unique_ptr<Queue[]> queues;
+
+        bool pop(size_t worker, size_t &index);
+        bool steal(size_t worker, size_t &index);
+        void work(size_t worker, const std::function<void(size_t)> &job);
+    };
+
+} // namespace zspinlab::tune
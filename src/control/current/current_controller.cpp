@@ -11,10 +11,8 @@ namespace zspinlab::controller
      **/
     void CurrentController::set_Id_pi_params(float kP, float kI, float min, float max)
     {
-        PI_id.set_kp(kP);
-        PI_id.set_ki(kI);
-        PI_id.set_outMax(max);
-        PI_id.set_outMin(min);
+        staged.id = {kP, kI, min, max};
+        param_block.publish(staged);
     }
 
     /**
@@ -26,10 +24,18 @@ namespace zspinlab::controller
      **/
     void CurrentController::set_Iq_pi_params(float kP, float kI, float min, float max)
     {
-        PI_iq.set_kp(kP);
-        PI_iq.set_ki(kI);
-        PI_iq.set_outMax(max);
-        PI_iq.set_outMin(min);
+        staged.iq = {kP, kI, min, max};
+        param_block.publish(staged);
+    }
+
+    /**
+     * @brief Publish the parameters of both PI controllers as one set
+     * @param[in] params    Parameter set
+     **/
+    void CurrentController::publish_params(const Params &params)
+    {
+        staged = params;
+        param_block.publish(staged);
     }
 
 } // namespace zspinner::controller
@@ -1,15 +1,32 @@
 #pragma once
 
 #include "math/math_core.hpp"
+#include "telemetry/telemetry.hpp"
 
 namespace zspinlab::controller {
-// Classical current (torque) controller implementation
+/*
+ * Classical current (torque) controller implementation.
+ *
+ * The gains and limits of both PI controllers are published as one set through a ParamBlock, so any of the parameter
+ * setters can be called from a tuning thread while the current loop runs: run() picks up the latest complete set when
+ * it starts, never a mix of the Id and Iq updates.
+ */
 class CurrentController {
 public:
+    // Complete parameter set of both PI controllers
+    struct Params {
+        zspinlab::math::modules::PI::Params id, iq;
+    };
+
     CurrentController() {};
 
-    void set_Id_pi_params(float kP, float kI, float min, float max);     
+    // Publish the PI parameters, one controller or both at once
+    void set_Id_pi_params(float kP, float kI, float min, float max);
     void set_Iq_pi_params(float kP, float kI, float min, float max);
+    void publish_params(const Params &params);
+
+    // Obtain the parameter set in use by run()
+    Params get_params(void) { return Params{PI_id.get_params(), PI_iq.get_params()}; }
 
     // Set Iq reference current
     void set_Iq_ref(float Iq_ref) { this->Iq_ref = Iq_ref; }
@@ -22,18 +39,30 @@ public:
     float get_Id_ref(void) { return Id_ref; };
 
     void run(float Id, float Iq, float sin_theta, float cos_theta);
+
+    // Run the current controller module from rotor frame currents and the electrical angle
+    void run(zspinlab::math::type::Dq i_dq, zspinlab::math::type::SinCos theta)
+    {
+        run(i_dq.d, i_dq.q, theta.sin, theta.cos);
+    }
     
     // Obtain the calculated alpha voltage vector
     float get_va(void) { return v_a; }
     // Obtain the calculated beta voltage vector
     float get_vb(void) { return v_b; }
+    // Obtain the calculated alpha and beta voltage vectors
+    zspinlab::math::type::AlphaBeta get_vab(void) { return {v_a, v_b}; }
 
 private:
     // PI units
     zspinlab::math::modules::PI PI_id, PI_iq;
 
-    float Iq_ref, Id_ref;
-    float v_a, v_b;
+    // Parameter sets published by the writer, picked up by run()
+    zspinlab::math::type::ParamBlock<Params> param_block;
+    Params staged = {};     // Last published set, writer owned
+
+    float Iq_ref = 0.0f, Id_ref = 0.0f;
+    float v_a = 0.0f, v_b = 0.0f;
 };
 
 /**
@@ -48,7 +77,13 @@ private:
 inline void CurrentController::run(float Id, float Iq, float sin_theta, float cos_theta)
 {
     float v_q, v_d;
-    float sin_theta, cos_theta;
+    Params params;
+
+    // Apply the latest complete parameter set before touching the PI units
+    if (param_block.fetch(params)) {
+        PI_id.set_params(params.id);
+        PI_iq.set_params(params.iq);
+    }
 
     // Currently not implementing feed-forward variable
     v_q = PI_iq.run(Iq_ref, Iq, 0.0f);
@@ -56,6 +91,8 @@ inline void CurrentController::run(float Id, float Iq, float sin_theta, float co
 
     // Get alpha and beta voltage
     zspinlab::math::function::inverse_park_transform(v_d, v_q, sin_theta, cos_theta, v_a, v_b);
+
+    ZSPINLAB_TELEMETRY_PROBE(CURRENT_CONTROLLER, Id, Iq, v_d, v_q, v_a, v_b);
 }
 
 } // namespace zspinner::controller
\ No newline at end of file
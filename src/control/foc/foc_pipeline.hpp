@@ -0,0 +1,81 @@
+#pragma once
+
+#include <type_traits>
+
+#include "control/current/current_controller.hpp"
+#include "math/math_core.hpp"
+#include "modulation/svpwm/svpwm_base.hpp"
+#include "modulation/modulator_set.hpp"
+
+namespace zspinlab::controller {
+
+/*
+ * Fused FOC current-loop stage: Clarke -> Park -> Id/Iq PI -> inverse Park -> SVPWM in a single inlined call.
+ *
+ * A CurrentController with the transforms and the modulator fused around its run(): its parameter setters, references
+ * and tuning thread rules apply as they are. The intermediate values (alpha/beta and dq currents) stay in local
+ * variables so the compiler can keep them in registers, instead of going through the out-parameters of the individual
+ * blocks. The modulator is any SVPWM_Base derivative, selected at compile time, or a ModulatorSet of them to switch at
+ * runtime. Only float modulators are supported, as the current controller itself runs in float.
+ */
+template <class Modulator, bool use_all_phase = true>
+class FocPipeline : public CurrentController {
+    static_assert(std::is_same_v<typename Modulator::sample_t, float>, "FocPipeline only supports float modulators");
+    static_assert(std::is_base_of_v<zspinlab::modulation::SVPWM_Base<Modulator, typename Modulator::sample_t>,
+                                    Modulator> ||
+                      zspinlab::modulation::is_modulator_set_v<Modulator>,
+                  "Modulator must derive from SVPWM_Base or be a ModulatorSet");
+
+public:
+    FocPipeline() {};
+
+    // Access the modulator, e.g. to allow over-modulation
+    Modulator &get_modulator(void) { return modulator; }
+
+    void run(float iA, float iB, float iC, float sin_theta, float cos_theta, float &dA, float &dB, float &dC);
+
+private:
+    // Modulator unit
+    Modulator modulator;
+};
+
+/**
+ * @brief Run one current-loop tick, from phase currents to phase duty cycles
+ * @param[in] iA        Input phase A current
+ * @param[in] iB        Input phase B current
+ * @param[in] iC        Input phase C current, ignored if \p use_all_phase is set to false
+ * @param[in] sin_theta Input Sine value of electrical angle
+ * @param[in] cos_theta Input Cosine value of electrical angle
+ * @param[out] dA       Output phase A duty cycle
+ * @param[out] dB       Output phase B duty cycle
+ * @param[out] dC       Output phase C duty cycle
+ *
+ * @return None
+ **/
+template <class Modulator, bool use_all_phase>
+inline void FocPipeline<Modulator, use_all_phase>::run(float iA,
+                                                       float iB,
+                                                       float iC,
+                                                       float sin_theta,
+                                                       float cos_theta,
+                                                       float &dA,
+                                                       float &dB,
+                                                       float &dC)
+{
+    float i_alpha, i_beta;
+    float i_d, i_q;
+
+    zspinlab::math::function::clarke_transform<use_all_phase>(iA, iB, iC, i_alpha, i_beta);
+    zspinlab::math::function::park_transform(i_alpha, i_beta, sin_theta, cos_theta, i_d, i_q);
+
+    CurrentController::run(i_d, i_q, sin_theta, cos_theta);
+
+    modulator.set_vref_ab(get_va(), get_vb());
+    modulator.run();
+
+    dA = modulator.get_phase_duty_a();
+    dB = modulator.get_phase_duty_b();
+    dC = modulator.get_phase_duty_c();
+}
+
+} // namespace zspinlab::controller
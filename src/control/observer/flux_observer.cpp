@@ -0,0 +1,108 @@
+#include "flux_observer.hpp"
+
+namespace zspinlab::controller
+{
+    /**
+     * @brief Set the motor parameters
+     * @param[in] rs    Stator phase resistance [Ohm]
+     * @param[in] ld    d-axis inductance [H]
+     * @param[in] lq    q-axis inductance [H]
+     * @param[in] psi_m Permanent magnet flux linkage [Wb]
+     *
+     * @return None
+     **/
+    void FluxObserver::set_motor_params(float rs, float ld, float lq, float psi_m)
+    {
+        this->rs = rs;
+        this->ld = ld;
+        this->lq = lq;
+        this->psi_m = psi_m;
+
+        update_coefficients();
+    }
+
+    /**
+     * @brief Set the current loop sample time
+     * @param[in] ts Sample time [s]
+     *
+     * @return None
+     **/
+    void FluxObserver::set_sample_time(float ts)
+    {
+        this->ts = ts;
+        pll.set_sample_time(ts);
+
+        update_coefficients();
+    }
+
+    /**
+     * @brief Set the scale of the voltage inputs
+     * @param[in] v_scale Volts per unit of the voltage inputs, e.g. the stator voltage of a unit modulator reference at
+     *                    the present DC-link voltage. Update it from the DC-link measurement if it moves
+     *
+     * @return None
+     **/
+    void FluxObserver::set_voltage_scale(float v_scale)
+    {
+        this->v_scale = v_scale;
+
+        update_coefficients();
+    }
+
+    /**
+     * @brief Set the flux drift correction gain
+     * @param[in] k_c Correction gain [rad/s], of the order of the lowest electrical angular speed the observer runs at
+     *
+     * @return None
+     **/
+    void FluxObserver::set_flux_correction(float k_c)
+    {
+        this->k_c = k_c;
+
+        update_coefficients();
+    }
+
+    /**
+     * @brief Set the PLL loop filter from its closed-loop natural frequency and damping
+     * @param[in] omega_n Natural frequency [rad/s], a few times the flux correction gain
+     * @param[in] zeta    Damping ratio
+     *
+     * @return None
+     **/
+    void FluxObserver::set_pll_bandwidth(float omega_n, float zeta)
+    {
+        pll.set_bandwidth(omega_n, zeta);
+    }
+
+    /**
+     * @brief Reset the flux estimate and restart the PLL, e.g. at the hand-over from open-loop start
+     * @param[in] angle_pu Electrical angle (1.0 is one full electrical turn)
+     * @param[in] speed    Electrical angular speed [rad/s]
+     *
+     * @return None
+     **/
+    void FluxObserver::reset_state(float angle_pu, float speed)
+    {
+        pll.reset_state(angle_pu, speed);
+
+        // Start from the magnet flux at the given angle
+        af_a = psi_m * pll.get_cos();
+        af_b = psi_m * pll.get_sin();
+        psi_a = af_a;
+        psi_b = af_b;
+    }
+
+    /**
+     * @brief Refresh the per-tick coefficients after a parameter change
+     *
+     * @return None
+     **/
+    void FluxObserver::update_coefficients(void)
+    {
+        k_v = ts * v_scale;
+        k_r = ts * rs;
+        k_f = ts * k_c;
+        inv_psi_m = (psi_m > 0.0f) ? 1.0f / psi_m : 0.0f;
+    }
+
+} // namespace zspinlab::controller
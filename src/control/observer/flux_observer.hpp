@@ -0,0 +1,107 @@
+#pragma once
+
+#include "math/math_core.hpp"
+#include "telemetry/telemetry.hpp"
+
+namespace zspinlab::controller {
+/*
+ * Sensorless rotor angle and speed observer, active flux followed by a quadrature PLL.
+ *
+ * The stator flux is integrated from the voltage model, psi' = v - Rs * i, in the stationary frame. The active flux
+ * psi_s - Lq * i is aligned with the rotor d axis for both surface and interior PMSM, with an amplitude psi_m +
+ * (Ld - Lq) * id. The pure integrator drifts with the current and voltage offsets, so it is pulled toward the model
+ * active flux at the PLL angle with a correction gain k_c [rad/s]: below k_c the observer follows the model, above it
+ * the voltage model. A quadrature PLL then tracks the active flux angle and outputs its sine and cosine directly.
+ *
+ * Allocation free, no trig call, no divide and no branch in run(). The estimate is only usable above a few percent of
+ * the rated speed, where the back-EMF dominates the resistive drop; start the motor open loop (e.g. I-f) and hand
+ * over once the PLL is locked.
+ *
+ * Call run() once per current loop tick, before CurrentController::run(), with the alpha-beta currents of this tick
+ * and the voltage reference of the previous one (CurrentController::get_vab(), applied during the period that just
+ * ended).
+ */
+class FluxObserver {
+public:
+    FluxObserver() {};
+
+    void set_motor_params(float rs, float ld, float lq, float psi_m);
+    void set_sample_time(float ts);
+    void set_voltage_scale(float v_scale);
+    void set_flux_correction(float k_c);
+    void set_pll_bandwidth(float omega_n, float zeta = 1.0f);
+
+    void reset_state(float angle_pu = 0.0f, float speed = 0.0f);
+
+    void run(float i_alpha, float i_beta, float v_alpha, float v_beta);
+
+    // Run the observer from the alpha-beta currents and the previous alpha-beta voltage reference
+    void run(zspinlab::math::type::AlphaBeta i_ab, zspinlab::math::type::AlphaBeta v_ab)
+    {
+        run(i_ab.alpha, i_ab.beta, v_ab.alpha, v_ab.beta);
+    }
+
+    // Obtain the sine value of the estimated electrical angle, for the next current loop tick
+    float get_sin(void) { return pll.get_sin(); }
+    // Obtain the cosine value of the estimated electrical angle, for the next current loop tick
+    float get_cos(void) { return pll.get_cos(); }
+    // Obtain the sine and cosine of the estimated electrical angle, for the next current loop tick
+    zspinlab::math::type::SinCos get_sincos(void) { return {pll.get_sin(), pll.get_cos()}; }
+    // Obtain the estimated electrical angular speed [rad/s]
+    float get_speed(void) { return pll.get_speed(); }
+    // Obtain the estimated active flux [Wb]
+    zspinlab::math::type::AlphaBeta get_flux_ab(void) { return {af_a, af_b}; }
+
+private:
+    // PLL unit
+    zspinlab::math::modules::QuadraturePLL pll;
+
+    // Motor parameters
+    float rs = 0.0f, ld = 0.0f, lq = 0.0f, psi_m = 0.0f;
+    float ts = 0.0f, v_scale = 1.0f, k_c = 0.0f;
+
+    // Per-tick coefficients, derived from the parameters above
+    float k_v = 0.0f;           // Ts * voltage scale
+    float k_r = 0.0f;           // Ts * Rs
+    float k_f = 0.0f;           // Ts * k_c
+    float inv_psi_m = 0.0f;     // PLL input normalization
+
+    // Stator flux estimate
+    float psi_a = 0.0f, psi_b = 0.0f;
+    // Active flux estimate
+    float af_a = 0.0f, af_b = 0.0f;
+
+    void update_coefficients(void);
+};
+
+/**
+ * @brief Run the observer, one current loop tick
+ * @param[in] i_alpha Input alpha current [A]
+ * @param[in] i_beta  Input beta current [A]
+ * @param[in] v_alpha Input alpha voltage reference of the previous tick, in voltage scale units
+ * @param[in] v_beta  Input beta voltage reference of the previous tick, in voltage scale units
+ *
+ * @return None
+ **/
+inline void FluxObserver::run(float i_alpha, float i_beta, float v_alpha, float v_beta)
+{
+    const float s = pll.get_sin();
+    const float c = pll.get_cos();
+
+    // Model active flux at the estimated angle, the d current sets the reluctance part
+    const float id = i_alpha * c + i_beta * s;
+    const float af_model = psi_m + (ld - lq) * id;
+
+    // Voltage model, the correction term pulls the drift toward the model flux
+    psi_a += k_v * v_alpha - k_r * i_alpha + k_f * (af_model * c - af_a);
+    psi_b += k_v * v_beta - k_r * i_beta + k_f * (af_model * s - af_b);
+
+    af_a = psi_a - lq * i_alpha;
+    af_b = psi_b - lq * i_beta;
+
+    pll.run(af_a * inv_psi_m, af_b * inv_psi_m);
+
+    ZSPINLAB_TELEMETRY_PROBE(FLUX_OBSERVER, af_a, af_b, pll.get_sin(), pll.get_cos(), pll.get_speed());
+}
+
+} // namespace zspinlab::controller
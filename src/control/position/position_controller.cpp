@@ -0,0 +1,40 @@
+#include "position_controller.hpp"
+
+namespace zspinlab::controller
+{
+    /**
+     * @brief Set the position PID controller general parameters
+     * @param[in] kP        Proportional gain
+     * @param[in] kI        Integral gain, per position loop call
+     * @param[in] kD        Derivative gain, per position loop call
+     * @param[in] min       Minimum speed reference
+     * @param[in] max       Maximum speed reference
+     **/
+    void PositionController::set_pid_params(float kP, float kI, float kD, float min, float max)
+    {
+        param_block.publish({kP, kI, kD, min, max});
+    }
+
+    /**
+     * @brief Set the derivative term low pass filter
+     * @param[in] coeffs Filter coefficients, e.g. from zspinlab::math::function::lowpass_first_order() at the position
+     *                   loop rate
+     **/
+    void PositionController::set_derivative_filter(const zspinlab::math::type::FirstOrderCoefficients<float> &coeffs)
+    {
+        PID_position.set_lpf_parameter(coeffs);
+    }
+
+    /**
+     * @brief Reset the position controller to default state (zero)
+     *
+     * @return None
+     **/
+    void PositionController::reset_state(void)
+    {
+        PID_position.reset_state();
+
+        speed_ref = 0.0f;
+    }
+
+} // namespace zspinlab::controller
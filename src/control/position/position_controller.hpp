@@ -0,0 +1,67 @@
+#pragma once
+
+#include "math/math_core.hpp"
+#include "telemetry/telemetry.hpp"
+
+namespace zspinlab::controller {
+/*
+ * Position controller, outputs the speed reference of the speed controller.
+ *
+ * Positions are unwrapped (multi-turn) angles. Runs at an integer divider of the current loop, the PID gains are per
+ * position loop call.
+ *
+ * The PID gains and limits go through a ParamBlock, so set_pid_params() is fine from a tuning thread while the loop
+ * runs. set_derivative_filter() writes the derivative filter of the PID in place, it belongs to the loop context.
+ */
+class PositionController {
+public:
+    PositionController() {};
+
+    // Publish the PID gains and limits, picked up by the next run()
+    void set_pid_params(float kP, float kI, float kD, float min, float max);
+    // Set the derivative filter, loop context only
+    void set_derivative_filter(const zspinlab::math::type::FirstOrderCoefficients<float> &coeffs);
+
+    // Set position reference
+    void set_position_ref(float position_ref) { this->position_ref = position_ref; }
+    // Get position reference
+    float get_position_ref(void) { return position_ref; }
+
+    // Set speed feed-forward, e.g. the speed of the reference trajectory
+    void set_speed_ffwd(float speed_ffwd) { this->speed_ffwd = speed_ffwd; }
+    // Get speed feed-forward
+    float get_speed_ffwd(void) { return speed_ffwd; }
+
+    void run(float position);
+    void reset_state(void);
+
+    // Obtain the calculated speed reference
+    float get_speed_ref(void) { return speed_ref; }
+
+private:
+    // PID unit
+    zspinlab::math::modules::PID PID_position;
+
+    // Parameter sets published by the writer, picked up by run()
+    zspinlab::math::type::ParamBlock<zspinlab::math::modules::PID::Params> param_block;
+
+    float position_ref = 0.0f, speed_ffwd = 0.0f;
+    float speed_ref = 0.0f;
+};
+
+/**
+ * @brief Run the position controller module
+ * @param[in] position Input measured position
+ *
+ * @return None
+ **/
+inline void PositionController::run(float position)
+{
+    PID_position.update_params(param_block);
+
+    speed_ref = PID_position.run(position_ref, position, speed_ffwd);
+
+    ZSPINLAB_TELEMETRY_PROBE(POSITION_CONTROLLER, position_ref, position, speed_ffwd, speed_ref);
+}
+
+} // namespace zspinlab::controller
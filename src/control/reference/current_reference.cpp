@@ -0,0 +1,190 @@
+#include "current_reference.hpp"
+
+namespace zspinlab::controller
+{
+    // Bisection steps of the solver, enough for the float resolution of the currents
+    static constexpr int SOLVER_STEPS = 40;
+
+    /**
+     * @brief Compute the electromagnetic torque of a current vector
+     * @param[in] motor Motor parameters
+     * @param[in] i_dq  Input rotor frame currents [A]
+     *
+     * @return Torque [Nm]
+     **/
+    float current_reference_torque(const CurrentReferenceMotor &motor, zspinlab::math::type::Dq i_dq)
+    {
+        return 1.5f * motor.pole_pairs * (motor.psi_m + (motor.ld - motor.lq) * i_dq.d) * i_dq.q;
+    }
+
+    /**
+     * @brief Compute the d current of the MTPA point at a current magnitude
+     * @param[in] motor     Motor parameters
+     * @param[in] magnitude Stator current magnitude [A]
+     *
+     * @return d current [A]
+     **/
+    static float mtpa_id(const CurrentReferenceMotor &motor, float magnitude)
+    {
+        const float saliency = motor.lq - motor.ld;
+
+        // Non-salient motor, the torque is only produced by Iq
+        if (zspinlab::math::basic::ffabsf(saliency) * magnitude < 1e-6f * motor.psi_m) {
+            return 0.0f;
+        }
+
+        const float root = zspinlab::math::basic::fsqrtf(motor.psi_m * motor.psi_m +
+                                                         8.0f * saliency * saliency * magnitude * magnitude);
+
+        return (motor.psi_m - root) / (4.0f * saliency);
+    }
+
+    /**
+     * @brief Compute the MTPA current vector at a current magnitude
+     * @param[in] motor     Motor parameters
+     * @param[in] magnitude Stator current magnitude [A]
+     *
+     * @return Rotor frame currents [A]
+     **/
+    static zspinlab::math::type::Dq mtpa_point(const CurrentReferenceMotor &motor, float magnitude)
+    {
+        const float id = mtpa_id(motor, magnitude);
+        const float iq2 = magnitude * magnitude - id * id;
+
+        return {id, zspinlab::math::basic::fsqrtf((iq2 > 0.0f) ? iq2 : 0.0f)};
+    }
+
+    /**
+     * @brief Compute the q current on the voltage limit ellipse at a d current
+     * @param[in] motor    Motor parameters
+     * @param[in] flux_max Stator flux limit [Wb]
+     * @param[in] id       d current [A]
+     *
+     * @return q current [A], zero outside of the ellipse
+     **/
+    static float ellipse_iq(const CurrentReferenceMotor &motor, float flux_max, float id)
+    {
+        const float flux_d = motor.psi_m + motor.ld * id;
+        const float flux_q2 = flux_max * flux_max - flux_d * flux_d;
+
+        return (flux_q2 > 0.0f) ? zspinlab::math::basic::fsqrtf(flux_q2) / motor.lq : 0.0f;
+    }
+
+    /**
+     * @brief Solve the current reference of a torque with the current and voltage limits, by bisection
+     * @param[in] motor        Motor and drive limits
+     * @param[in] torque       Torque reference [Nm], saturated to the torque available at this speed
+     * @param[in] speed_by_vdc Electrical speed per DC bus volt [rad/s/V]
+     *
+     * @note MTPA while the stator flux is within the voltage limit, otherwise the point of the voltage limit ellipse
+     * giving the torque, with the least negative d current. When the torque is not available the point of largest torque within
+     * both limits is returned (MTPV or current limit). Stator resistance is neglected. Iterative, meant for table
+     * building and offline use.
+     *
+     * @return Id and Iq references [A]
+     **/
+    zspinlab::math::type::Dq solve_current_reference(const CurrentReferenceMotor &motor,
+                                                     float torque,
+                                                     float speed_by_vdc)
+    {
+        using zspinlab::math::type::Dq;
+
+        const float sign = (torque < 0.0f) ? -1.0f : 1.0f;
+        const float torque_abs = torque * sign;
+
+        // MTPA: the torque grows with the current magnitude along the MTPA curve
+        float lo = 0.0f, hi = motor.i_max;
+
+        if (current_reference_torque(motor, mtpa_point(motor, hi)) <= torque_abs) {
+            lo = hi;
+        }
+        for (int step = 0; (step < SOLVER_STEPS) && (lo < hi); step++) {
+            const float mid = 0.5f * (lo + hi);
+
+            if (current_reference_torque(motor, mtpa_point(motor, mid)) < torque_abs) {
+                lo = mid;
+            } else {
+                hi = mid;
+            }
+        }
+
+        Dq i_dq = mtpa_point(motor, hi);
+
+        const float speed_abs = zspinlab::math::basic::ffabsf(speed_by_vdc);
+        const float flux_d = motor.psi_m + motor.ld * i_dq.d;
+        const float flux_q = motor.lq * i_dq.q;
+
+        if ((speed_abs * speed_abs) * (flux_d * flux_d + flux_q * flux_q) <= motor.voltage_ratio * motor.voltage_ratio) {
+            return {i_dq.d, sign * i_dq.q};
+        }
+
+        // Field weakening: on the voltage limit ellipse, from its zero torque point toward its centre
+        const float flux_max = motor.voltage_ratio / speed_abs;
+        const float id_zero = (flux_max - motor.psi_m) / motor.ld;
+        float id_end = -motor.psi_m / motor.ld;
+
+        if (id_zero <= -motor.i_max) {
+            // The ellipse is out of the current limit, no torque is available at this speed
+            return {-motor.i_max, 0.0f};
+        }
+        id_end = (id_end > -motor.i_max) ? id_end : -motor.i_max;
+
+        // The MTPA point is out of the ellipse, so the solution has a lower d current
+        const float id_start = (id_zero < i_dq.d) ? id_zero : i_dq.d;
+
+        // Largest torque of the ellipse (MTPV), the torque is unimodal along it
+        float a = id_end, b = id_start;
+
+        for (int step = 0; step < SOLVER_STEPS; step++) {
+            const float m1 = a + (b - a) / 3.0f;
+            const float m2 = b - (b - a) / 3.0f;
+
+            if (current_reference_torque(motor, {m1, ellipse_iq(motor, flux_max, m1)}) <
+                current_reference_torque(motor, {m2, ellipse_iq(motor, flux_max, m2)})) {
+                a = m1;
+            } else {
+                b = m2;
+            }
+        }
+        id_end = 0.5f * (a + b);
+
+        // Current limit, the current grows away from the zero torque point
+        const float iq_end = ellipse_iq(motor, flux_max, id_end);
+
+        if (id_end * id_end + iq_end * iq_end > motor.i_max * motor.i_max) {
+            lo = id_end;
+            hi = id_start;
+
+            for (int step = 0; step < SOLVER_STEPS; step++) {
+                const float mid = 0.5f * (lo + hi);
+                const float iq = ellipse_iq(motor, flux_max, mid);
+
+                if (mid * mid + iq * iq > motor.i_max * motor.i_max) {
+                    lo = mid;
+                } else {
+                    hi = mid;
+                }
+            }
+            id_end = hi;
+        }
+
+        // Least d current giving the torque, the torque decreases toward the zero torque point
+        lo = id_end;
+        hi = id_start;
+
+        if (current_reference_torque(motor, {lo, ellipse_iq(motor, flux_max, lo)}) > torque_abs) {
+            for (int step = 0; step < SOLVER_STEPS; step++) {
+                const float mid = 0.5f * (lo + hi);
+
+                if (current_reference_torque(motor, {mid, ellipse_iq(motor, flux_max, mid)}) > torque_abs) {
+                    lo = mid;
+                } else {
+                    hi = mid;
+                }
+            }
+        }
+
+        return {lo, sign * ellipse_iq(motor, flux_max, lo)};
+    }
+
+} // namespace zspinlab::controller
@@ -0,0 +1,184 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "math/math_core.hpp"
+#include "telemetry/telemetry.hpp"
+
+namespace zspinlab::controller {
+
+// Motor and drive limits the current references are computed for
+struct CurrentReferenceMotor {
+    float psi_m;            // Permanent magnet flux linkage [Wb]
+    float ld, lq;           // d and q axis inductances [H]
+    uint8_t pole_pairs;
+    float i_max;            // Stator current limit, peak [A]
+    float voltage_ratio;    // Usable stator voltage per DC bus volt, 1/sqrt(3) with linear SVPWM, less a margin
+};
+
+zspinlab::math::type::Dq solve_current_reference(const CurrentReferenceMotor &motor, float torque, float speed_by_vdc);
+
+float current_reference_torque(const CurrentReferenceMotor &motor, zspinlab::math::type::Dq i_dq);
+
+/*
+ * MTPA / field-weakening current reference table, (torque, speed / Vdc) -> (Id, Iq).
+ *
+ * Uniform grid over [0, torque max] x [0, speed/Vdc max], the electrical speed divided by the DC bus voltage so that one
+ * table covers the whole bus voltage range. Each node holds the Id and Iq references as int16_t counts of
+ * current_scale, 4 bytes per node. A plain aggregate: build it at startup with build_current_reference_table(), or
+ * offline with host/analysis/current_reference_benchmark.cpp --emit, as a const initializer that stays in flash.
+ * Negative torques and speeds use the table by symmetry (Iq follows the sign of the torque).
+ *
+ * @tparam TorquePoints Number of nodes along the torque axis
+ * @tparam SpeedPoints  Number of nodes along the speed / Vdc axis
+ */
+template <size_t TorquePoints, size_t SpeedPoints>
+struct CurrentReferenceTable {
+    static_assert(TorquePoints >= 2 && SpeedPoints >= 2, "At least two nodes per axis");
+
+    // Reference currents of one node, counts of current_scale
+    struct Node {
+        int16_t id, iq;
+    };
+
+    float torque_scale;     // Node index per Nm
+    float speed_scale;      // Node index per rad/s/V
+    float current_scale;    // A per count
+    Node nodes[SpeedPoints][TorquePoints];
+
+    zspinlab::math::type::Dq lookup(float torque, float speed_by_vdc) const;
+};
+
+/**
+ * @brief Interpolate the current references, bilinear between the four surrounding nodes
+ * @param[in] torque       Input torque reference [Nm], saturated to the table range
+ * @param[in] speed_by_vdc Input electrical speed per DC bus volt [rad/s/V], saturated to the table range
+ *
+ * @note No data dependent branch: the axis positions are clamped with selects.
+ *
+ * @return Id and Iq references [A]
+ **/
+template <size_t TorquePoints, size_t SpeedPoints>
+inline zspinlab::math::type::Dq CurrentReferenceTable<TorquePoints, SpeedPoints>::lookup(float torque,
+                                                                                       float speed_by_vdc) const
+{
+    constexpr float torque_last = static_cast<float>(TorquePoints - 1);
+    constexpr float speed_last = static_cast<float>(SpeedPoints - 1);
+
+    float u = zspinlab::math::basic::ffabsf(torque) * torque_scale;
+    float v = zspinlab::math::basic::ffabsf(speed_by_vdc) * speed_scale;
+
+    u = (u < torque_last) ? u : torque_last;
+    v = (v < speed_last) ? v : speed_last;
+
+    // The last cell also serves the upper edge, with a fraction of one
+    uint32_t i = static_cast<uint32_t>(u);
+    uint32_t j = static_cast<uint32_t>(v);
+
+    i = (i < TorquePoints - 2) ? i : TorquePoints - 2;
+    j = (j < SpeedPoints - 2) ? j : SpeedPoints - 2;
+
+    const float fu = u - static_cast<float>(i);
+    const float fv = v - static_cast<float>(j);
+
+    const Node &n00 = nodes[j][i];
+    const Node &n01 = nodes[j][i + 1];
+    const Node &n10 = nodes[j + 1][i];
+    const Node &n11 = nodes[j + 1][i + 1];
+
+    const float id0 = n00.id + fu * static_cast<float>(n01.id - n00.id);
+    const float id1 = n10.id + fu * static_cast<float>(n11.id - n10.id);
+    const float iq0 = n00.iq + fu * static_cast<float>(n01.iq - n00.iq);
+    const float iq1 = n10.iq + fu * static_cast<float>(n11.iq - n10.iq);
+
+    const float id = (id0 + fv * (id1 - id0)) * current_scale;
+    const float iq = (iq0 + fv * (iq1 - iq0)) * current_scale;
+
+    return {id, (torque < 0.0f) ? -iq : iq};
+}
+
+/**
+ * @brief Fill a current reference table with the exact MTPA / field-weakening solution at every node
+ * @param[in] motor            Motor and drive limits
+ * @param[in] torque_max       Torque of the last node [Nm], e.g. the MTPA torque at the current limit
+ * @param[in] speed_by_vdc_max Electrical speed per DC bus volt of the last node [rad/s/V]
+ * @param[out] table           Table to fill
+ *
+ * @note Runs the iterative solver at every node, at startup or offline only.
+ *
+ * @return None
+ **/
+template <size_t TorquePoints, size_t SpeedPoints>
+void build_current_reference_table(const CurrentReferenceMotor &motor,
+                                   float torque_max,
+                                   float speed_by_vdc_max,
+                                   CurrentReferenceTable<TorquePoints, SpeedPoints> &table)
+{
+    table.torque_scale = static_cast<float>(TorquePoints - 1) / torque_max;
+    table.speed_scale = static_cast<float>(SpeedPoints - 1) / speed_by_vdc_max;
+    table.current_scale = motor.i_max / 32767.0f;
+
+    for (size_t j = 0; j < SpeedPoints; j++) {
+        for (size_t i = 0; i < TorquePoints; i++) {
+            const zspinlab::math::type::Dq i_dq =
+                solve_current_reference(motor,
+                                        torque_max * static_cast<float>(i) / static_cast<float>(TorquePoints - 1),
+                                        speed_by_vdc_max * static_cast<float>(j) / static_cast<float>(SpeedPoints - 1));
+
+            table.nodes[j][i] = {static_cast<int16_t>(lroundf(i_dq.d / table.current_scale)),
+                                 static_cast<int16_t>(lroundf(i_dq.q / table.current_scale))};
+        }
+    }
+}
+
+/*
+ * Current reference generator, turns the torque demand of the speed loop into Id and Iq references through a
+ * CurrentReferenceTable: MTPA below the base speed, field weakening above it, within the current and voltage limits.
+ *
+ * Call run() at the speed loop rate, after SpeedController::run() (its output is then a torque, set its PI limits in
+ * Nm), and pass get_Id_ref() and get_Iq_ref() to the current controller.
+ */
+template <size_t TorquePoints, size_t SpeedPoints>
+class CurrentReference {
+public:
+    using Table = CurrentReferenceTable<TorquePoints, SpeedPoints>;
+
+    CurrentReference(const Table &table) : table(&table) {};
+
+    void run(float torque_ref, float speed, float vdc);
+
+    // Obtain the Id reference current
+    float get_Id_ref(void) { return Id_ref; }
+    // Obtain the Iq reference current
+    float get_Iq_ref(void) { return Iq_ref; }
+    // Obtain the Id and Iq reference currents
+    zspinlab::math::type::Dq get_dq_ref(void) { return {Id_ref, Iq_ref}; }
+
+private:
+    const Table *table;
+
+    float Id_ref = 0.0f, Iq_ref = 0.0f;
+};
+
+/**
+ * @brief Compute the Id and Iq references, one speed loop tick
+ * @param[in] torque_ref Input torque reference [Nm]
+ * @param[in] speed      Input electrical angular speed [rad/s]
+ * @param[in] vdc        Input DC bus voltage [V], must be positive
+ *
+ * @return None
+ **/
+template <size_t TorquePoints, size_t SpeedPoints>
+inline void CurrentReference<TorquePoints, SpeedPoints>::run(float torque_ref, float speed, float vdc)
+{
+    const float speed_by_vdc = speed / vdc;
+    const zspinlab::math::type::Dq i_dq = table->lookup(torque_ref, speed_by_vdc);
+
+    Id_ref = i_dq.d;
+    Iq_ref = i_dq.q;
+
+    ZSPINLAB_TELEMETRY_PROBE(CURRENT_REFERENCE, torque_ref, speed_by_vdc, Id_ref, Iq_ref);
+}
+
+} // namespace zspinlab::controller
@@ -0,0 +1,212 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <tuple>
+#include <utility>
+
+namespace zspinlab::controller {
+
+/*
+ * Periodic task of the multi-rate scheduler.
+ *
+ * The task runs every Divider PWM ISR ticks, its work split over Stages consecutive ticks. F is called as f() for a
+ * single stage task, or as f(stage) with stage in [0, Stages) otherwise.
+ */
+template <uint16_t Divider, uint8_t Stages, class F>
+class RateTask {
+    static_assert(Divider > 0, "Divider must be at least 1");
+    static_assert(Stages > 0 && Stages <= Divider, "Stages must be in [1, Divider]");
+
+public:
+    static constexpr uint16_t divider = Divider;
+    static constexpr uint8_t stages = Stages;
+
+    constexpr explicit RateTask(F f) : f(f) {}
+
+    // Run one stage of the task
+    void run_stage(uint8_t stage)
+    {
+        if constexpr (Stages == 1) {
+            (void)stage;
+            f();
+        } else {
+            f(stage);
+        }
+    }
+
+private:
+    F f;
+};
+
+/**
+ * @brief Create a periodic task of the multi-rate scheduler
+ * @param[in] f Task function, f() if Stages is 1 or f(stage) otherwise
+ *
+ * @return The task
+ **/
+template <uint16_t Divider, uint8_t Stages = 1, class F>
+constexpr RateTask<Divider, Stages, F> make_rate_task(F f)
+{
+    return RateTask<Divider, Stages, F>(f);
+}
+
+namespace detail {
+
+    // Phase value of a task that could not be placed
+    constexpr uint16_t NO_PHASE = 0xFFFF;
+
+    /**
+     * @brief Check whether two tasks ever run a stage on the same tick
+     *
+     * Task i runs at ticks t = p_i + s_i (mod d_i), so two tasks meet iff p_i + s_i = p_j + s_j (mod gcd(d_i, d_j)) for
+     * some pair of stages.
+     **/
+    constexpr bool phases_collide(uint16_t p_i, uint16_t d_i, uint8_t s_i, uint16_t p_j, uint16_t d_j, uint8_t s_j)
+    {
+        const uint16_t g = std::gcd(d_i, d_j);
+
+        for (uint16_t a = 0; a < s_i; a++) {
+            for (uint16_t b = 0; b < s_j; b++) {
+                if ((p_i + a) % g == (p_j + b) % g) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Assign the task phases so that no two stages ever share a tick, fastest tasks first
+     * @param[in] dividers Task dividers
+     * @param[in] stages   Task stage counts
+     *
+     * @return Phase of each task, NO_PHASE if no collision-free phase exists
+     **/
+    template <size_t N>
+    constexpr std::array<uint16_t, N> assign_phases(const std::array<uint16_t, N> &dividers,
+                                                    const std::array<uint8_t, N> &stages)
+    {
+        std::array<size_t, N> order{};
+        std::array<uint16_t, N> phases{};
+        std::array<bool, N> placed{};
+
+        // Sort by divider, stable
+        for (size_t i = 0; i < N; i++) {
+            size_t j = i;
+            while (j > 0 && dividers[order[j - 1]] > dividers[i]) {
+                order[j] = order[j - 1];
+                j--;
+            }
+            order[j] = i;
+        }
+
+        for (size_t k = 0; k < N; k++) {
+            const size_t i = order[k];
+
+            phases[i] = NO_PHASE;
+            for (uint16_t p = 0; p < dividers[i] && phases[i] == NO_PHASE; p++) {
+                bool collide = false;
+                for (size_t j = 0; j < N && !collide; j++) {
+                    collide = placed[j] && phases_collide(p, dividers[i], stages[i], phases[j], dividers[j], stages[j]);
+                }
+                if (!collide) {
+                    phases[i] = p;
+                }
+            }
+            placed[i] = true;
+        }
+        return phases;
+    }
+
+} // namespace detail
+
+/*
+ * Static multi-rate scheduler, called once per PWM ISR after the current loop.
+ *
+ * Each task runs at an integer divider of the PWM rate. The task phases are assigned at compile time so that at most one
+ * stage of one task runs per tick: the slow loops never pile up on the same ISR, and splitting a task in stages spreads
+ * its own work too. Task sets that cannot be placed are rejected at compile time.
+ *
+ * Usage, speed loop at 1/10 split in two stages and position loop at 1/20 of the PWM rate:
+ *     MultiRateScheduler scheduler(make_rate_task<10, 2>([&](uint8_t stage) { ... }),
+ *                                  make_rate_task<20>([&]() { ... }));
+ */
+template <class... Tasks>
+class MultiRateScheduler {
+    static_assert(sizeof...(Tasks) > 0, "At least one task is needed");
+
+    static constexpr std::array<uint16_t, sizeof...(Tasks)> phases =
+        detail::assign_phases<sizeof...(Tasks)>({Tasks::divider...}, {Tasks::stages...});
+
+    static constexpr bool all_placed(void)
+    {
+        for (uint16_t phase : phases) {
+            if (phase == detail::NO_PHASE) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+public:
+    explicit MultiRateScheduler(Tasks... tasks) : tasks(tasks...)
+    {
+        static_assert(all_placed(), "Task set cannot run one stage per tick, use larger dividers or fewer stages");
+        reset();
+    }
+
+    // Restart the schedule, the next tick() is tick 0
+    void reset(void)
+    {
+        for (size_t i = 0; i < sizeof...(Tasks); i++) {
+            counter[i] = (dividers[i] - phases[i]) % dividers[i];
+        }
+    }
+
+    void tick(void) { tick(std::index_sequence_for<Tasks...>{}); }
+
+    // Tick offset of the first stage of task I
+    template <size_t I>
+    static constexpr uint16_t get_phase(void) { return phases[I]; }
+
+    // Access task I
+    template <size_t I>
+    auto &get_task(void) { return std::get<I>(tasks); }
+
+private:
+    static constexpr std::array<uint16_t, sizeof...(Tasks)> dividers = {Tasks::divider...};
+
+    template <size_t... I>
+    void tick(std::index_sequence<I...>)
+    {
+        (tick_task<I>(), ...);
+    }
+
+    /**
+     * @brief Run the stage of task I due on this tick, if any, and advance its counter
+     *
+     * @return None
+     **/
+    template <size_t I>
+    void tick_task(void)
+    {
+        using task_t = std::tuple_element_t<I, std::tuple<Tasks...>>;
+
+        uint16_t count = counter[I];
+
+        if (count < task_t::stages) {
+            std::get<I>(tasks).run_stage(static_cast<uint8_t>(count));
+        }
+        counter[I] = (++count == task_t::divider) ? 0 : count;
+    }
+
+    std::tuple<Tasks...> tasks;
+
+    // Ticks since the first stage of each task, modulo its divider
+    uint16_t counter[sizeof...(Tasks)];
+};
+
+} // namespace zspinlab::controller
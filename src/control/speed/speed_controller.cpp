@@ -0,0 +1,41 @@
+#include "speed_controller.hpp"
+
+namespace zspinlab::controller
+{
+    /**
+     * @brief Set the speed PI controller general parameters
+     * @param[in] kP        Proportional gain
+     * @param[in] kI        Integral gain, per speed loop call
+     * @param[in] min       Minimum Iq reference current
+     * @param[in] max       Maximum Iq reference current
+     **/
+    void SpeedController::set_pi_params(float kP, float kI, float min, float max)
+    {
+        param_block.publish({kP, kI, min, max});
+    }
+
+    /**
+     * @brief Set the speed feedback low pass filter
+     * @param[in] coeffs Filter coefficients, e.g. from zspinlab::math::function::lowpass_first_order() at the speed
+     *                   loop rate
+     **/
+    void SpeedController::set_feedback_filter(const zspinlab::math::type::FirstOrderCoefficients<float> &coeffs)
+    {
+        filter.set_coefficients(coeffs);
+    }
+
+    /**
+     * @brief Reset the speed controller to default state (zero)
+     *
+     * @return None
+     **/
+    void SpeedController::reset_state(void)
+    {
+        PI_speed.reset_state();
+        filter.set_initial_condition(0.0f, 0.0f);
+
+        speed = 0.0f;
+        Iq_ref = 0.0f;
+    }
+
+} // namespace zspinlab::controller
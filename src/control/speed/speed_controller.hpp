@@ -0,0 +1,93 @@
+#pragma once
+
+#include "math/math_core.hpp"
+#include "telemetry/telemetry.hpp"
+
+namespace zspinlab::controller {
+/*
+ * Speed controller, outputs the Iq reference of the current controller.
+ *
+ * Runs at an integer divider of the current loop, the PI gains are per speed loop call. The work is split in two halves,
+ * filter_feedback() and run(), so that a scheduler can spread them over two PWM ISR ticks.
+ *
+ * The PI gains and limits go through a ParamBlock: set_pi_params() may be called from a tuning thread while the loop
+ * runs, the new set is picked up at the start of run(). set_feedback_filter() writes the filter coefficients in place,
+ * call it from the context of the loop or while it is stopped.
+ */
+class SpeedController {
+public:
+    SpeedController() {};
+
+    // Publish the PI gains and limits
+    void set_pi_params(float kP, float kI, float min, float max);
+    // Set the feedback filter, loop context only
+    void set_feedback_filter(const zspinlab::math::type::FirstOrderCoefficients<float> &coeffs);
+
+    // Set speed reference
+    void set_speed_ref(float speed_ref) { this->speed_ref = speed_ref; }
+    // Get speed reference
+    float get_speed_ref(void) { return speed_ref; }
+
+    // Set Iq feed-forward, e.g. the current needed by the reference acceleration
+    void set_Iq_ffwd(float Iq_ffwd) { this->Iq_ffwd = Iq_ffwd; }
+    // Get Iq feed-forward
+    float get_Iq_ffwd(void) { return Iq_ffwd; }
+
+    void filter_feedback(float speed);
+    void run(void);
+
+    // Filter the measured speed and run the PI controller in one call
+    void run(float speed)
+    {
+        filter_feedback(speed);
+        run();
+    }
+
+    void reset_state(void);
+
+    // Obtain the filtered speed feedback
+    float get_speed(void) { return speed; }
+    // Obtain the calculated Iq reference current
+    float get_Iq_ref(void) { return Iq_ref; }
+
+private:
+    // PI unit
+    zspinlab::math::modules::PI PI_speed;
+
+    // Parameter sets published by the writer, picked up by run()
+    zspinlab::math::type::ParamBlock<zspinlab::math::modules::PI::Params> param_block;
+
+    // Feedback filter unit
+    zspinlab::math::modules::LowPassFirstOrder filter{0.0f, 1.0f, 0.0f}; // Default to non-filtering mode
+
+    float speed_ref = 0.0f, Iq_ffwd = 0.0f;
+    float speed = 0.0f;
+    float Iq_ref = 0.0f;
+};
+
+/**
+ * @brief Filter the measured speed, first half of the speed loop
+ * @param[in] speed Input measured speed
+ *
+ * @return None
+ **/
+inline void SpeedController::filter_feedback(float speed)
+{
+    this->speed = filter.run(speed);
+}
+
+/**
+ * @brief Run the speed PI controller on the last filtered feedback, second half of the speed loop
+ *
+ * @return None
+ **/
+inline void SpeedController::run(void)
+{
+    PI_speed.update_params(param_block);
+
+    Iq_ref = PI_speed.run(speed_ref, speed, Iq_ffwd);
+
+    ZSPINLAB_TELEMETRY_PROBE(SPEED_CONTROLLER, speed_ref, speed, Iq_ffwd, Iq_ref);
+}
+
+} // namespace zspinlab::controller
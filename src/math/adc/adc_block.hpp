@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "math/math_const.hpp"
+#include "math/math_core.hpp"
+
+namespace zspinlab::math::type
+{
+    // Offset and gain calibration of one ADC channel, value = (raw - offset) * gain
+    struct AdcCalibration
+    {
+        float offset;   // Raw count of a zero input, e.g. the mid-scale count of a bidirectional current sensor
+        float gain;     // Physical unit per count
+    };
+
+    // Calibration of the three phase current channels
+    using AbcCalibration = Abc_T<AdcCalibration>;
+
+} // namespace zspinlab::math::type
+
+// Block entry points working directly on the raw DMA buffer: frame-major interleaved uint16_t samples, Stride channels
+// per frame (raw[frame * Stride + channel]), read in place, with the calibration folded into the conversion
+namespace zspinlab::math::function
+{
+    /**
+     * @brief Convert one channel of a block of raw interleaved ADC frames to calibrated values
+     * @param[in] Stride  Number of interleaved channels per frame. This is statically defined
+     * @param[in] Channel Index of the channel in a frame. This is statically defined
+     * @param[in] raw     Raw ADC frames, e.g. a DMA half-buffer
+     * @param[in] frames  Number of frames in the block
+     * @param[in] cal     Channel calibration
+     * @param[out] output Calibrated values, one per frame
+     *
+     * @return None
+     **/
+    template <size_t Stride, size_t Channel>
+    inline void adc_convert_block(const uint16_t *raw, size_t frames, type::AdcCalibration cal, float *output)
+    {
+        static_assert(Channel < Stride, "Channel is out of the frame");
+
+        // (raw - offset) * gain as a single multiply-add
+        const float bias = -cal.offset * cal.gain;
+
+        for (size_t i = 0; i < frames; i++)
+        {
+            output[i] = static_cast<float>(raw[i * Stride + Channel]) * cal.gain + bias;
+        }
+    }
+
+    /**
+     * @brief Vector Clarke transform of a block of raw interleaved ADC frames, calibration fused in
+     * @param[in] use_all_phase Using all the input phase coordinates. This is statically defined
+     * @param[in] Stride        Number of interleaved channels per frame. This is statically defined
+     * @param[in] A             Index of the phase A channel in a frame. This is statically defined
+     * @param[in] B             Index of the phase B channel in a frame. This is statically defined
+     * @param[in] C             (Optional) Index of the phase C channel in a frame, ignored if \p use_all_phase is set
+     *                          to false. This is statically defined
+     * @param[in] raw           Raw ADC frames, e.g. a DMA half-buffer
+     * @param[in] frames        Number of frames in the block
+     * @param[in] cal           Phase channel calibrations
+     * @param[out] i_alpha      Output two-phase vector coordinates alpha, one per frame
+     * @param[out] i_beta       Output two-phase vector coordinates beta, one per frame
+     *
+     * @note The offsets and gains are folded into the Clarke matrix once per block, so every output costs one
+     * multiply-add per phase, without an intermediate calibrated phase buffer.
+     *
+     * @return None
+     **/
+    template <bool use_all_phase, size_t Stride = 3, size_t A = 0, size_t B = 1, size_t C = 2>
+    inline void adc_clarke_transform_block(const uint16_t *raw,
+                                           size_t frames,
+                                           const type::AbcCalibration &cal,
+                                           float *i_alpha,
+                                           float *i_beta)
+    {
+        static_assert(A < Stride && B < Stride && (C < Stride || !use_all_phase), "Phase channel is out of the frame");
+
+        const float bias_a = -cal.a.offset * cal.a.gain;
+        const float bias_b = -cal.b.offset * cal.b.gain;
+
+        if constexpr (use_all_phase)
+        {
+            const float bias_c = -cal.c.offset * cal.c.gain;
+
+            const float k_alpha_a = MATH_2_BY_3 * cal.a.gain;
+            const float k_alpha_b = -MATH_1_BY_3 * cal.b.gain;
+            const float k_alpha_c = -MATH_1_BY_3 * cal.c.gain;
+            const float k_alpha_0 = MATH_2_BY_3 * bias_a - MATH_1_BY_3 * (bias_b + bias_c);
+
+            const float k_beta_b = MATH_1_BY_SQRT_3 * cal.b.gain;
+            const float k_beta_c = -MATH_1_BY_SQRT_3 * cal.c.gain;
+            const float k_beta_0 = MATH_1_BY_SQRT_3 * (bias_b - bias_c);
+
+            for (size_t i = 0; i < frames; i++)
+            {
+                const float a = raw[i * Stride + A];
+                const float b = raw[i * Stride + B];
+                const float c = raw[i * Stride + C];
+
+                i_alpha[i] = k_alpha_a * a + k_alpha_b * b + k_alpha_c * c + k_alpha_0;
+                i_beta[i] = k_beta_b * b + k_beta_c * c + k_beta_0;
+            }
+        }
+        else
+        {
+            const float k_beta_a = MATH_1_BY_SQRT_3 * cal.a.gain;
+            const float k_beta_b = MATH_2_BY_SQRT_3 * cal.b.gain;
+            const float k_beta_0 = MATH_1_BY_SQRT_3 * bias_a + MATH_2_BY_SQRT_3 * bias_b;
+
+            for (size_t i = 0; i < frames; i++)
+            {
+                const float a = raw[i * Stride + A];
+                const float b = raw[i * Stride + B];
+
+                i_alpha[i] = cal.a.gain * a + bias_a;
+                i_beta[i] = k_beta_a * a + k_beta_b * b + k_beta_0;
+            }
+        }
+    }
+
+} // namespace zspinlab::math::function
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <math.h>
+
+namespace zspinlab::math::basic
+{
+    // Accuracy tier of the exponential, from the cheapest to libm
+    enum class ExpPrecision
+    {
+        SCHRAUDOLPH,    // Exponent bit trick, one multiply-add, |relative error| < 3e-2
+        POLY3,          // Range reduction and degree 3 minimax polynomial, |relative error| < 7.5e-5
+        POLY5,          // Range reduction and degree 5 minimax polynomial, |relative error| < 2.3e-7
+        FULL,           // expf()
+    };
+
+    namespace detail
+    {
+        // Input range of the approximations, the result stays a normal float
+        constexpr float EXP_INPUT_MIN = -87.0f;
+        constexpr float EXP_INPUT_MAX = 88.0f;
+
+        // Build the float 2^n from its exponent field, n in [-126, 127]
+        inline float exp2_int(int32_t n)
+        {
+            const uint32_t bits = static_cast<uint32_t>(n + 127) << 23;
+            float out;
+
+            std::memcpy(&out, &bits, sizeof(out));
+            return out;
+        }
+    } // namespace detail
+
+    /**
+     * @brief Approximate exp(x) at the given accuracy tier
+     * @param[in] in        Input value
+     * @param[in] precision Accuracy tier. This is statically defined
+     *
+     * @note Except for ExpPrecision::FULL, the input is saturated to [-87, 88] so that the result stays a normal float:
+     * no infinity, zero or denormal. Branch free, no divide.
+     *
+     * @return exp(in)
+     **/
+    template <ExpPrecision precision>
+    inline float exp_approx(float in)
+    {
+        if constexpr (precision == ExpPrecision::FULL)
+        {
+            return expf(in);
+        }
+        else
+        {
+            constexpr float LOG2E = 1.44269504088896341f;
+
+            float x = (in < detail::EXP_INPUT_MIN) ? detail::EXP_INPUT_MIN : in;
+            x = (x > detail::EXP_INPUT_MAX) ? detail::EXP_INPUT_MAX : x;
+
+            if constexpr (precision == ExpPrecision::SCHRAUDOLPH)
+            {
+                // Write x / ln(2) in the exponent field, the mantissa linearly interpolates 2^frac. The offset centres
+                // the relative error (Schraudolph, 1999)
+                constexpr float A = 8388608.0f * LOG2E;
+                constexpr float B = 1065353216.0f - 366393.0f;
+
+                const uint32_t bits = static_cast<uint32_t>(static_cast<int32_t>(A * x + B));
+                float out;
+
+                std::memcpy(&out, &bits, sizeof(out));
+                return out;
+            }
+            else
+            {
+                // x = n * ln(2) + r with |r| <= ln(2) / 2, ln(2) split in two so that n * LN2_HI is exact (Cody-Waite)
+                constexpr float LN2_HI = 0.693145751953125f;
+                constexpr float LN2_LO = 1.42860676533018672e-06f;
+
+                const int32_t n = static_cast<int32_t>(x * LOG2E + copysignf(0.5f, x));
+                const float nf = static_cast<float>(n);
+                const float r = (x - nf * LN2_HI) - nf * LN2_LO;
+                float p;
+
+                if constexpr (precision == ExpPrecision::POLY5)
+                {
+                    p = 1.0000000717f +
+                        r * (0.99999969199f +
+                             r * (0.49998894851f + r * (0.16667574729f + r * (0.041915381992f + r * 0.0082976550804f))));
+                }
+                else
+                {
+                    p = 0.99992807354f + r * (1.0001641858f + r * (0.50496326418f + r * 0.16566842348f));
+                }
+
+                return p * detail::exp2_int(n);
+            }
+        }
+    }
+
+} // namespace zspinlab::math::basic
@@ -0,0 +1,10 @@
+#include "cic_decimator.hpp"
+
+namespace zspinlab::math::modules
+{
+    // Explicit instantiation of the common phase current configurations (three channels, 16x oversampling), so that
+    // they are built with the library
+    template class CicDecimator<1, 16, 3>;
+    template class CicDecimator<3, 16, 3>;
+
+} // namespace zspinlab::math::modules
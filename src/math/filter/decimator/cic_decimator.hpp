@@ -0,0 +1,221 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "math/adc/adc_block.hpp"
+
+namespace zspinlab::math::modules
+{
+    /*
+     * Cascaded integrator-comb (CIC) decimator for oversampled raw ADC channels, e.g. 4-16 phase current samples per
+     * PWM period transferred by DMA.
+     *
+     * The filter runs on the raw interleaved uint16_t frames of the DMA buffer: Order integrators at the input rate, and
+     * Order combs at the output rate, every Ratio frames. The integrators and combs are 32-bit registers left to wrap
+     * around, which is exact as long as the output (raw * Ratio^Order) fits in 32 bits, checked at compile time. The
+     * offset and gain calibration and the 1 / Ratio^Order normalization are folded in a single multiply-add per output.
+     * Order 1 is a moving-average (boxcar) decimator, higher orders trade a longer delay for a better alias rejection
+     * (zeros of order Order at every multiple of the output rate, e.g. the PWM frequency and its harmonics).
+     *
+     * A block is integrated one channel at a time over each run of frames up to the next output, so that the integrators
+     * stay in CPU registers and the decimation phase is only tested once per output frame.
+     *
+     * @tparam Order    Number of integrator and comb stages
+     * @tparam Ratio    Decimation ratio, input frames per output frame
+     * @tparam Channels Number of interleaved channels per raw frame, all decimated
+     */
+    template <uint8_t Order, uint16_t Ratio, size_t Channels = 1>
+    class CicDecimator
+    {
+        static_assert(Order > 0 && Ratio > 0 && Channels > 0, "At least one stage, one channel and a ratio of 1");
+
+        // Bits needed to count up to Ratio - 1
+        static constexpr uint32_t ratio_bits(void)
+        {
+            uint32_t bits = 0;
+            while ((1UL << bits) < Ratio)
+            {
+                bits++;
+            }
+            return bits;
+        }
+
+        static_assert(16 + Order * ratio_bits() <= 32, "Register growth exceeds 32 bits, lower the order or the ratio");
+
+    public:
+        // DC gain of the integrator-comb cascade, Ratio^Order
+        static constexpr uint32_t gain(void)
+        {
+            uint32_t g = 1;
+            for (uint8_t s = 0; s < Order; s++)
+            {
+                g *= Ratio;
+            }
+            return g;
+        }
+
+        CicDecimator(void);
+
+        void set_calibration(size_t channel, const zspinlab::math::type::AdcCalibration &cal);
+
+        void reset_state(void);
+
+        size_t run_block(const uint16_t *raw, size_t frames, float *output);
+
+    private:
+        void integrate(const uint16_t *raw, size_t frames);
+
+        // Integrator and comb delay registers, [stage][channel]
+        uint32_t integrator[Order][Channels];
+        uint32_t comb[Order][Channels];
+
+        // Calibration folded with the 1 / Ratio^Order normalization, value = sum * scale + bias
+        float scale[Channels];
+        float bias[Channels];
+
+        uint16_t phase; // Input frames since the last output
+    };
+
+    // Moving-average (boxcar) decimator, first-order CIC
+    template <uint16_t Ratio, size_t Channels = 1>
+    using MovingAverageDecimator = CicDecimator<1, Ratio, Channels>;
+
+    /**
+     * @brief Constructor, every channel defaults to the uncalibrated mean raw count with zero state
+     **/
+    template <uint8_t Order, uint16_t Ratio, size_t Channels>
+    inline CicDecimator<Order, Ratio, Channels>::CicDecimator(void)
+    {
+        for (size_t ch = 0; ch < Channels; ch++)
+        {
+            set_calibration(ch, zspinlab::math::type::AdcCalibration{0.0f, 1.0f});
+        }
+
+        reset_state();
+    }
+
+    /**
+     * @brief Set the offset and gain calibration of one channel
+     * @param[in] channel Channel index
+     * @param[in] cal     Channel calibration
+     *
+     * @return None
+     **/
+    template <uint8_t Order, uint16_t Ratio, size_t Channels>
+    inline void CicDecimator<Order, Ratio, Channels>::set_calibration(size_t channel,
+                                                                      const zspinlab::math::type::AdcCalibration &cal)
+    {
+        scale[channel] = cal.gain / static_cast<float>(gain());
+        bias[channel] = -cal.offset * cal.gain;
+    }
+
+    /**
+     * @brief Reset the integrators, the combs and the decimation phase, the next output comes after Ratio frames
+     *
+     * @return None
+     **/
+    template <uint8_t Order, uint16_t Ratio, size_t Channels>
+    inline void CicDecimator<Order, Ratio, Channels>::reset_state(void)
+    {
+        for (uint8_t s = 0; s < Order; s++)
+        {
+            for (size_t ch = 0; ch < Channels; ch++)
+            {
+                integrator[s][ch] = 0;
+                comb[s][ch] = 0;
+            }
+        }
+
+        phase = 0;
+    }
+
+    /**
+     * @brief Decimate a block of raw interleaved ADC frames, e.g. a DMA half-buffer
+     * @param[in] raw     Raw ADC frames, frame-major: raw[frame * Channels + channel]
+     * @param[in] frames  Number of frames in the block, need not be a multiple of Ratio
+     * @param[out] output Calibrated output frames, same layout: output[k * Channels + channel]. Room for
+     *                    (frames + Ratio - 1) / Ratio frames is needed
+     *
+     * @return Number of output frames written
+     **/
+    template <uint8_t Order, uint16_t Ratio, size_t Channels>
+    inline size_t CicDecimator<Order, Ratio, Channels>::run_block(const uint16_t *raw, size_t frames, float *output)
+    {
+        size_t outputs = 0;
+
+        while (frames > 0)
+        {
+            // Integrate up to the next output frame without testing the phase on every frame
+            const size_t run = (frames < size_t(Ratio - phase)) ? frames : size_t(Ratio - phase);
+
+            integrate(raw, run);
+            raw += run * Channels;
+            frames -= run;
+            phase += static_cast<uint16_t>(run);
+
+            if (phase < Ratio)
+            {
+                break;
+            }
+            phase = 0;
+
+            for (size_t ch = 0; ch < Channels; ch++)
+            {
+                uint32_t y = integrator[Order - 1][ch];
+
+                for (uint8_t s = 0; s < Order; s++)
+                {
+                    const uint32_t delayed = comb[s][ch];
+
+                    comb[s][ch] = y;
+                    y -= delayed;
+                }
+
+                output[outputs * Channels + ch] = static_cast<float>(y) * scale[ch] + bias[ch];
+            }
+            outputs++;
+        }
+
+        return outputs;
+    }
+
+    /**
+     * @brief Run the integrators over a block of raw interleaved ADC frames
+     * @param[in] raw    Raw ADC frames, frame-major: raw[frame * Channels + channel]
+     * @param[in] frames Number of frames
+     *
+     * @return None
+     **/
+    template <uint8_t Order, uint16_t Ratio, size_t Channels>
+    inline void CicDecimator<Order, Ratio, Channels>::integrate(const uint16_t *raw, size_t frames)
+    {
+        // One channel at a time, its integrators kept in CPU registers for the whole block
+        for (size_t ch = 0; ch < Channels; ch++)
+        {
+            uint32_t acc[Order];
+
+            for (uint8_t s = 0; s < Order; s++)
+            {
+                acc[s] = integrator[s][ch];
+            }
+
+            for (size_t frame = 0; frame < frames; frame++)
+            {
+                uint32_t v = raw[frame * Channels + ch];
+
+                for (uint8_t s = 0; s < Order; s++)
+                {
+                    acc[s] += v;
+                    v = acc[s];
+                }
+            }
+
+            for (uint8_t s = 0; s < Order; s++)
+            {
+                integrator[s][ch] = acc[s];
+            }
+        }
+    }
+
+} // namespace zspinlab::math::modules
@@ -0,0 +1,150 @@
+#pragma once
+
+namespace zspinlab::math::type
+{
+    // First-order filter coefficients, y[n] = b0*x[n] + b1*x[n-1] - a1*y[n-1]
+    template <typename T = float>
+    struct FirstOrderCoefficients
+    {
+        T a1;
+        T b0, b1;
+
+        // Convert to another coefficient type, e.g. the Fixed coefficient type of a filter
+        template <typename U>
+        constexpr FirstOrderCoefficients<U> cast(void) const
+        {
+            return FirstOrderCoefficients<U>{U(a1), U(b0), U(b1)};
+        }
+    };
+
+    // Second-order filter coefficients, y[n] = b0*x[n] + b1*x[n-1] + b2*x[n-2] - a1*y[n-1] - a2*y[n-2]
+    template <typename T = float>
+    struct SecondOrderCoefficients
+    {
+        T a1, a2;
+        T b0, b1, b2;
+
+        // Convert to another coefficient type, e.g. the Fixed coefficient type of a filter
+        template <typename U>
+        constexpr SecondOrderCoefficients<U> cast(void) const
+        {
+            return SecondOrderCoefficients<U>{U(a1), U(a2), U(b0), U(b1), U(b2)};
+        }
+    };
+
+} // namespace zspinlab::math::type
+
+// Low-pass filter coefficient design. Every function is constexpr, so filters with a fixed cutoff and sample rate are
+// designed at compile time, and cheap enough (no libm call, two divides) to retune at runtime when the PWM frequency
+// changes.
+namespace zspinlab::math::function
+{
+    /**
+     * @brief Bilinear transform pre-warping factor tan(pi * fc / fs)
+     * @param[in] fc Cutoff frequency in Hz, 0 < fc < fs / 2
+     * @param[in] fs Sample rate in Hz
+     *
+     * @note Pade [5/4] approximant of tan, folded around pi/4 with tan(x) = 1 / tan(pi/2 - x). Relative error below 2e-8
+     * over the whole range, one divide.
+     *
+     * @return tan(pi * fc / fs)
+     **/
+    template <typename T = float>
+    constexpr T prewarp(T fc, T fs)
+    {
+        constexpr T pi = T(3.14159265358979323846);
+
+        T x = pi * fc / fs;
+        const bool fold = x > pi * T(0.25);
+
+        x = fold ? pi * T(0.5) - x : x;
+
+        const T x2 = x * x;
+        const T num = x * (T(945) - T(105) * x2 + x2 * x2);
+        const T den = T(945) - T(420) * x2 + T(15) * x2 * x2;
+
+        return fold ? den / num : num / den;
+    }
+
+    /**
+     * @brief First-order low-pass filter, bilinear transform with pre-warping
+     * @param[in] fc Cutoff (-3 dB) frequency in Hz
+     * @param[in] fs Sample rate in Hz
+     *
+     * @return Filter coefficients
+     **/
+    template <typename T = float>
+    constexpr type::FirstOrderCoefficients<T> lowpass_first_order(T fc, T fs)
+    {
+        const T k = prewarp(fc, fs);
+        const T norm = T(1) / (T(1) + k);
+
+        return type::FirstOrderCoefficients<T>{(k - T(1)) * norm, k * norm, k * norm};
+    }
+
+    /**
+     * @brief Second-order low-pass filter from an already pre-warped analog frequency
+     * @param[in] k Pre-warped natural frequency, tan(pi * f0 / fs)
+     * @param[in] q Quality factor
+     *
+     * @return Filter coefficients
+     **/
+    template <typename T = float>
+    constexpr type::SecondOrderCoefficients<T> lowpass_second_order_prewarped(T k, T q)
+    {
+        const T k2 = k * k;
+        const T norm = T(1) / (T(1) + k / q + k2);
+        const T b0 = k2 * norm;
+
+        return type::SecondOrderCoefficients<T>{
+            T(2) * (k2 - T(1)) * norm,
+            (T(1) - k / q + k2) * norm,
+            b0,
+            T(2) * b0,
+            b0,
+        };
+    }
+
+    /**
+     * @brief Second-order low-pass filter, bilinear transform with pre-warping
+     * @param[in] fc Natural frequency in Hz
+     * @param[in] fs Sample rate in Hz
+     * @param[in] q  Quality factor
+     *
+     * @return Filter coefficients
+     **/
+    template <typename T = float>
+    constexpr type::SecondOrderCoefficients<T> lowpass_second_order(T fc, T fs, T q)
+    {
+        return lowpass_second_order_prewarped(prewarp(fc, fs), q);
+    }
+
+    /**
+     * @brief Second-order Butterworth low-pass filter (Q = 1/sqrt(2)), maximally flat pass band
+     * @param[in] fc Cutoff (-3 dB) frequency in Hz
+     * @param[in] fs Sample rate in Hz
+     *
+     * @return Filter coefficients
+     **/
+    template <typename T = float>
+    constexpr type::SecondOrderCoefficients<T> lowpass_butterworth(T fc, T fs)
+    {
+        return lowpass_second_order(fc, fs, T(0.70710678118654752));
+    }
+
+    /**
+     * @brief Second-order critically damped low-pass filter (Q = 1/2, no overshoot on a step)
+     * @param[in] fc Cutoff (-3 dB) frequency in Hz
+     * @param[in] fs Sample rate in Hz
+     *
+     * @note The pre-warped natural frequency is scaled by 1 / sqrt(sqrt(2) - 1) so that the -3 dB point lands on fc.
+     *
+     * @return Filter coefficients
+     **/
+    template <typename T = float>
+    constexpr type::SecondOrderCoefficients<T> lowpass_critically_damped(T fc, T fs)
+    {
+        return lowpass_second_order_prewarped(prewarp(fc, fs) * T(1.55377397403003730), T(0.5));
+    }
+
+} // namespace zspinlab::math::function
@@ -0,0 +1,175 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+
+namespace zspinlab::math::modules
+{
+    /*
+     * Cascade of second-order sections (biquads) in transposed direct form II, for several channels at once.
+     *
+     * Every stage computes y = b0*x + s1, s1 = b1*x - a1*y + s2, s2 = b2*x - a2*y, with the same coefficient sign
+     * convention as LowPassSecondOrder (a0 normalized to 1). Coefficients and state are stored stage-major and
+     * channel-interleaved, so the inner loop of run() walks all channels of a stage with contiguous loads and stores
+     * and can be auto-vectorized (SSE/AVX on host, NEON/Helium on target).
+     *
+     * @tparam Stages   Number of second-order sections, filter order is 2 * Stages
+     * @tparam Channels Number of independent channels filtered per call
+     * @tparam T        Floating point sample type
+     */
+    template <size_t Stages, size_t Channels, typename T = float>
+    class BiquadCascade
+    {
+        static_assert(Stages > 0 && Channels > 0, "At least one stage and one channel are required");
+        static_assert(std::is_floating_point_v<T>, "BiquadCascade requires a floating point sample type");
+
+    public:
+        // Coefficients of one second-order section, a0 is normalized to 1
+        struct Coefficients
+        {
+            T b0, b1, b2;
+            T a1, a2;
+        };
+
+        BiquadCascade(void);
+
+        void set_stage(size_t stage, const Coefficients &coeffs);
+        void set_stage(size_t stage, size_t channel, const Coefficients &coeffs);
+
+        void reset_state(void);
+
+        void run(const T *input, T *output);
+        void run_block(const T *input, T *output, size_t frames);
+
+    private:
+        // Coefficients, [stage][channel]
+        T b0[Stages][Channels];
+        T b1[Stages][Channels];
+        T b2[Stages][Channels];
+        T a1[Stages][Channels];
+        T a2[Stages][Channels];
+
+        // Delay elements, [stage][channel]
+        T s1[Stages][Channels];
+        T s2[Stages][Channels];
+    };
+
+    /**
+     * @brief Constructor, every stage defaults to pass-through with zero state
+     **/
+    template <size_t Stages, size_t Channels, typename T>
+    inline BiquadCascade<Stages, Channels, T>::BiquadCascade(void)
+    {
+        for (size_t stage = 0; stage < Stages; stage++)
+        {
+            set_stage(stage, Coefficients{T(1), T(0), T(0), T(0), T(0)});
+        }
+
+        reset_state();
+    }
+
+    /**
+     * @brief Set the coefficients of one stage for all channels
+     * @param[in] stage  Stage index
+     * @param[in] coeffs Second-order section coefficients
+     *
+     * @return None
+     **/
+    template <size_t Stages, size_t Channels, typename T>
+    inline void BiquadCascade<Stages, Channels, T>::set_stage(size_t stage, const Coefficients &coeffs)
+    {
+        for (size_t ch = 0; ch < Channels; ch++)
+        {
+            set_stage(stage, ch, coeffs);
+        }
+    }
+
+    /**
+     * @brief Set the coefficients of one stage for a single channel
+     * @param[in] stage   Stage index
+     * @param[in] channel Channel index
+     * @param[in] coeffs  Second-order section coefficients
+     *
+     * @return None
+     **/
+    template <size_t Stages, size_t Channels, typename T>
+    inline void BiquadCascade<Stages, Channels, T>::set_stage(size_t stage, size_t channel, const Coefficients &coeffs)
+    {
+        b0[stage][channel] = coeffs.b0;
+        b1[stage][channel] = coeffs.b1;
+        b2[stage][channel] = coeffs.b2;
+        a1[stage][channel] = coeffs.a1;
+        a2[stage][channel] = coeffs.a2;
+    }
+
+    /**
+     * @brief Reset every delay element to zero
+     *
+     * @return None
+     **/
+    template <size_t Stages, size_t Channels, typename T>
+    inline void BiquadCascade<Stages, Channels, T>::reset_state(void)
+    {
+        for (size_t stage = 0; stage < Stages; stage++)
+        {
+            for (size_t ch = 0; ch < Channels; ch++)
+            {
+                s1[stage][ch] = T(0);
+                s2[stage][ch] = T(0);
+            }
+        }
+    }
+
+    /**
+     * @brief Filter one sample of every channel
+     * @param[in] input   Input samples, one per channel
+     * @param[out] output Output samples, one per channel. May be the same buffer as \p input
+     *
+     * @return None
+     **/
+    template <size_t Stages, size_t Channels, typename T>
+    inline void BiquadCascade<Stages, Channels, T>::run(const T *input, T *output)
+    {
+        T x[Channels];
+
+        for (size_t ch = 0; ch < Channels; ch++)
+        {
+            x[ch] = input[ch];
+        }
+
+        for (size_t stage = 0; stage < Stages; stage++)
+        {
+            for (size_t ch = 0; ch < Channels; ch++)
+            {
+                const T y = b0[stage][ch] * x[ch] + s1[stage][ch];
+
+                s1[stage][ch] = b1[stage][ch] * x[ch] - a1[stage][ch] * y + s2[stage][ch];
+                s2[stage][ch] = b2[stage][ch] * x[ch] - a2[stage][ch] * y;
+                x[ch] = y;
+            }
+        }
+
+        for (size_t ch = 0; ch < Channels; ch++)
+        {
+            output[ch] = x[ch];
+        }
+    }
+
+    /**
+     * @brief Filter a block of interleaved frames, e.g. a DMA half-buffer
+     * @param[in] input   Input samples, frame-major: input[frame * Channels + channel]
+     * @param[out] output Output samples, same layout. May be the same buffer as \p input
+     * @param[in] frames  Number of frames in the block
+     *
+     * @return None
+     **/
+    template <size_t Stages, size_t Channels, typename T>
+    inline void BiquadCascade<Stages, Channels, T>::run_block(const T *input, T *output, size_t frames)
+    {
+        for (size_t frame = 0; frame < frames; frame++)
+        {
+            run(input + frame * Channels, output + frame * Channels);
+        }
+    }
+
+} // namespace zspinlab::math::modules
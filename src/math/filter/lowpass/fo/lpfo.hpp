@@ -1,52 +1,144 @@
 #pragma once
 
+#include <cstddef>
+
+#include "math/fixed/fixed.hpp"
+#include "math/filter/design/filter_design.hpp"
+
 namespace zspinlab::math::modules
 {
 
-    // Create a simple first-order low-pass filter
-    class LowPassFirstOrder
+    /*
+     * Create a simple first-order low-pass filter.
+     *
+     * T is the sample type (float, double or a zspinlab::math::type::Fixed type). With a Fixed type the coefficients
+     * get two more integer bits so that pass-through (b0 = 1) is representable, and the difference equation is
+     * accumulated in the wide integer type and only rounded and saturated once.
+     */
+    template <typename T>
+    class LowPassFirstOrder_T
     {
     public:
-        LowPassFirstOrder(float a1, float b0, float b1);
+        using coeff_t = zspinlab::math::type::coeff_t<T>;
+
+        LowPassFirstOrder_T(coeff_t a1, coeff_t b0, coeff_t b1);
+
+        /**
+         * @brief Constructor from designed coefficients, usable in constant expressions
+         * @param[in] coeffs Filter coefficients, e.g. from zspinlab::math::function::lowpass_first_order()
+         **/
+        constexpr LowPassFirstOrder_T(const zspinlab::math::type::FirstOrderCoefficients<coeff_t> &coeffs)
+            : a1(coeffs.a1), b0(coeffs.b0), b1(coeffs.b1), x1(), y1()
+        {
+        }
 
-        void set_initial_condition(float x1, float y1);
+        void set_initial_condition(T x1, T y1);
+
+        // Set all the filter coefficients at once, e.g. when retuning at runtime
+        void set_coefficients(const zspinlab::math::type::FirstOrderCoefficients<coeff_t> &coeffs)
+        {
+            a1 = coeffs.a1;
+            b0 = coeffs.b0;
+            b1 = coeffs.b1;
+        }
 
         // Get the filter denominator coefficient
-        float get_denominator_coefficient(void) { return a1; }
+        coeff_t get_denominator_coefficient(void) { return a1; }
         // Set the filter denominator coefficient
-        void set_denominator_coefficient(float a1) { this->a1 = a1; }
+        void set_denominator_coefficient(coeff_t a1) { this->a1 = a1; }
 
         // Get the filter numerator coefficient for z^0
-        float get_numerator_coefficient_b0(void) { return b0; }
+        coeff_t get_numerator_coefficient_b0(void) { return b0; }
         // Set the filter numerator coefficient for z^0
-        void set_denominator_coefficient_b0(float b0) { this->b0 = b0; }
+        void set_numerator_coefficient_b0(coeff_t b0) { this->b0 = b0; }
 
         // Get the filter numerator coefficient for z^1
-        float get_numerator_coefficient_b1(void) { return b1; }
+        coeff_t get_numerator_coefficient_b1(void) { return b1; }
         // Set the filter numerator coefficient for z^1
-        void set_denominator_coefficient_b1(float b1) { this->b1 = b1; }
+        void set_numerator_coefficient_b1(coeff_t b1) { this->b1 = b1; }
+
+        T run(T input);
 
-        float run(float input);
+        template <size_t Channels>
+        static void run_block(LowPassFirstOrder_T<T> (&filters)[Channels],
+                              const T *const (&input)[Channels],
+                              T *const (&output)[Channels],
+                              size_t n);
 
     private:
-        float a1; // the denominator filter coefficient value for z^(-1)
+        // Uninitialized filter, only for the local copies of run_block()
+        LowPassFirstOrder_T(void) = default;
 
-        float b0; // the numerator filter coefficient value for z^0
-        float b1; // the numerator filter coefficient value for z^(-1)
+        coeff_t a1; // the denominator filter coefficient value for z^(-1)
 
-        float x1; // the input value at time sample n=-1
-        float y1; // the output value at time sample n=-1
+        coeff_t b0; // the numerator filter coefficient value for z^0
+        coeff_t b1; // the numerator filter coefficient value for z^(-1)
+
+        T x1; // the input value at time sample n=-1
+        T y1; // the output value at time sample n=-1
     };
 
+    // Single precision first-order low-pass filter
+    using LowPassFirstOrder = LowPassFirstOrder_T<float>;
+    // Q15 first-order low-pass filter
+    using LowPassFirstOrder_Q15 = LowPassFirstOrder_T<zspinlab::math::type::Q15>;
+    // Q31 first-order low-pass filter
+    using LowPassFirstOrder_Q31 = LowPassFirstOrder_T<zspinlab::math::type::Q31>;
+
+    /**
+     * @brief Constructor, set initial denominator and numerator coefficients
+     * @param[in] a1 The denominator filter coefficient value for z^(-1)
+     * @param[in] b0 The numerator filter coefficient value for z^0
+     * @param[in] b1 The numerator filter coefficient value for z^(-1)
+     **/
+    template <typename T>
+    inline LowPassFirstOrder_T<T>::LowPassFirstOrder_T(coeff_t a1, coeff_t b0, coeff_t b1)
+    {
+        this->a1 = a1;
+        this->b0 = b0;
+        this->b1 = b1;
+
+        // Default the initial condition to zero
+        this->x1 = T();
+        this->y1 = T();
+    }
+
+    /**
+     * @brief Set the initial input and output of the filter
+     * @param[in] x1 The input value at time sample n=-1
+     * @param[in] y1 The output value at time sample n=-1
+     *
+     * @return None
+     **/
+    template <typename T>
+    inline void LowPassFirstOrder_T<T>::set_initial_condition(T x1, T y1)
+    {
+        this->x1 = x1;
+        this->y1 = y1;
+    }
+
     /**
      * @brief Run the filter (y[n] = b0*x[n] + b1*x[n-1] - a1*y[n-1])
      * @param[in] input Input raw value x[n]
      *
      * @return Output filter value
      **/
-    inline float LowPassFirstOrder::run(float input)
+    template <typename T>
+    inline T LowPassFirstOrder_T<T>::run(T input)
     {
-        float y0 = b0 * input + b1 * x1 - a1 * y1;
+        T y0;
+
+        if constexpr (zspinlab::math::type::is_fixed_v<T>)
+        {
+            using wide_t = typename T::wide_t;
+
+            wide_t acc = wide_t(b0.raw()) * input.raw() + wide_t(b1.raw()) * x1.raw() - wide_t(a1.raw()) * y1.raw();
+            y0 = T::from_raw(T::saturate(T::template mul_round<coeff_t::frac_bits>(acc)));
+        }
+        else
+        {
+            y0 = b0 * input + b1 * x1 - a1 * y1;
+        }
 
         // Store new value into previous input and output value
         x1 = input;
@@ -55,4 +147,50 @@ namespace zspinlab::math::modules
         return y0;
     }
 
-} // namespace zspinlab::math::modules
\ No newline at end of file
+    /**
+     * @brief Run several filters over a block of samples each, e.g. alpha and beta of an oversampled DMA half-buffer
+     * @param[in,out] filters One filter per channel
+     * @param[in] input       Input raw values x[n], one buffer per channel
+     * @param[out] output     Output filter values, one buffer per channel. A channel may filter in place (same buffer
+     *                        as its input), buffers of different channels must not overlap
+     * @param[in] n           Number of samples per channel
+     *
+     * @note Same result as calling run() of every filter on every sample. The channels are interleaved sample by
+     * sample, with their coefficients and delay lines kept in registers for the whole block: the recursion of one
+     * channel is latency bound, the independent channels fill its gaps. This is for in-order cores such as Cortex-M, an
+     * out-of-order host CPU already overlaps the channels of a per-sample loop and runs both at the same speed.
+     *
+     * @return None
+     **/
+    template <typename T>
+    template <size_t Channels>
+    inline void LowPassFirstOrder_T<T>::run_block(LowPassFirstOrder_T<T> (&filters)[Channels],
+                                                  const T *const (&input)[Channels],
+                                                  T *const (&output)[Channels],
+                                                  size_t n)
+    {
+        LowPassFirstOrder_T<T> local[Channels];
+
+        for (size_t ch = 0; ch < Channels; ch++)
+        {
+            local[ch] = filters[ch];
+        }
+
+        for (size_t i = 0; i < n; i++)
+        {
+            // Unrolled so that every channel keeps its state in registers, also at -O2
+            #pragma GCC unroll 8
+            for (size_t ch = 0; ch < Channels; ch++)
+            {
+                output[ch][i] = local[ch].run(input[ch][i]);
+            }
+        }
+
+        for (size_t ch = 0; ch < Channels; ch++)
+        {
+            filters[ch].x1 = local[ch].x1;
+            filters[ch].y1 = local[ch].y1;
+        }
+    }
+
+} // namespace zspinlab::math::modules
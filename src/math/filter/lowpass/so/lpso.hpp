@@ -1,86 +1,296 @@
 #pragma once
 
+#include <cstddef>
+
+#include "math/fixed/fixed.hpp"
+#include "math/filter/design/filter_design.hpp"
+
 namespace zspinlab::math::modules
 {
 
-    // Create a simple Second-order low-pass filter
-    class LowPassSecondOrder
+    /*
+     * Create a simple Second-order low-pass filter.
+     *
+     * T is the sample type (float, double or a zspinlab::math::type::Fixed type). With a Fixed type the coefficients
+     * get two more integer bits since a1 of a low-pass biquad sits close to -2, and the difference equation is
+     * accumulated in the wide integer type and only rounded and saturated once.
+     */
+    template <typename T>
+    class LowPassSecondOrder_T
     {
     public:
-        LowPassSecondOrder(float a1, float a2, float b0, float b1, float b2);
+        using coeff_t = zspinlab::math::type::coeff_t<T>;
+
+        LowPassSecondOrder_T(coeff_t a1, coeff_t a2, coeff_t b0, coeff_t b1, coeff_t b2);
+
+        /**
+         * @brief Constructor from designed coefficients, usable in constant expressions
+         * @param[in] coeffs Filter coefficients, e.g. from zspinlab::math::function::lowpass_butterworth()
+         **/
+        constexpr LowPassSecondOrder_T(const zspinlab::math::type::SecondOrderCoefficients<coeff_t> &coeffs)
+            : a1(coeffs.a1), a2(coeffs.a2), b0(coeffs.b0), b1(coeffs.b1), b2(coeffs.b2), x1(), x2(), y1(), y2()
+        {
+        }
 
         // Set the initial inputs and outputs of the filter
-        void set_initial_condition(float x1, float x2, float y1, float y2);
+        void set_initial_condition(T x1, T x2, T y1, T y2);
 
         // Get the filter denominator coefficients
-        void get_denominator_coefficients(float &a1, float &a2);
+        void get_denominator_coefficients(coeff_t &a1, coeff_t &a2);
         // Set the filter denominator coefficients
-        void set_denominator_coefficients(float a1, float a2);
+        void set_denominator_coefficients(coeff_t a1, coeff_t a2);
 
         // Get the filter numerator coefficients
-        void get_numerator_coefficients(float &b0, float &b1, float &b2);
+        void get_numerator_coefficients(coeff_t &b0, coeff_t &b1, coeff_t &b2);
         // Set the filter numerator coefficients
-        void set_numerator_coefficients(float b0, float b1, float b2);
+        void set_numerator_coefficients(coeff_t b0, coeff_t b1, coeff_t b2);
+
+        // Set all the filter coefficients at once, e.g. when retuning at runtime
+        void set_coefficients(const zspinlab::math::type::SecondOrderCoefficients<coeff_t> &coeffs)
+        {
+            set_denominator_coefficients(coeffs.a1, coeffs.a2);
+            set_numerator_coefficients(coeffs.b0, coeffs.b1, coeffs.b2);
+        }
 
         // Get the filter denominator coefficient for z^(-1)
-        float get_denominator_coefficient_a1(void) { return a1; }
+        coeff_t get_denominator_coefficient_a1(void) { return a1; }
         // Set the filter denominator coefficient for z^(-1)
-        void get_denominator_coefficient_a1(float a1) { this->a1 = a1; }
+        void set_denominator_coefficient_a1(coeff_t a1) { this->a1 = a1; }
 
         // Get the filter denominator coefficient for z^(-2)
-        float get_denominator_coefficient_a2(void) { return a2; }
+        coeff_t get_denominator_coefficient_a2(void) { return a2; }
         // Set the filter denominator coefficient for z^(-2)
-        void get_denominator_coefficient_a2(float a2) { this->a2 = a2; }
+        void set_denominator_coefficient_a2(coeff_t a2) { this->a2 = a2; }
 
         // Get the filter numerator coefficient for z^0
-        float get_numerator_coefficient_b0(void) { return b0; }
+        coeff_t get_numerator_coefficient_b0(void) { return b0; }
         // Set the filter numerator coefficient for z^0
-        void set_denominator_coefficient_b0(float b0) { this->b0 = b0; }
+        void set_numerator_coefficient_b0(coeff_t b0) { this->b0 = b0; }
 
         // Get the filter numerator coefficient for z^(-1)
-        float get_numerator_coefficient_b1(void) { return b1; }
+        coeff_t get_numerator_coefficient_b1(void) { return b1; }
         // Set the filter numerator coefficient for z^(-1)
-        void set_denominator_coefficient_b1(float b1) { this->b1 = b1; }
+        void set_numerator_coefficient_b1(coeff_t b1) { this->b1 = b1; }
 
         // Get the filter numerator coefficient for z^(-2)
-        float get_numerator_coefficient_b2(void) { return b2; }
+        coeff_t get_numerator_coefficient_b2(void) { return b2; }
         // Set the filter numerator coefficient for z^(-2)
-        void set_denominator_coefficient_b2(float b2) { this->b2 = b2; }
+        void set_numerator_coefficient_b2(coeff_t b2) { this->b2 = b2; }
 
-        float run(float input);
+        T run(T input);
+
+        template <size_t Channels>
+        static void run_block(LowPassSecondOrder_T<T> (&filters)[Channels],
+                              const T *const (&input)[Channels],
+                              T *const (&output)[Channels],
+                              size_t n);
 
     private:
-        float a1; // the denominator filter coefficient value for z^(-1)
-        float a2; // the denominator filter coefficient value for z^(-2)
+        // Uninitialized filter, only for the local copies of run_block()
+        LowPassSecondOrder_T(void) = default;
+
+        coeff_t a1; // the denominator filter coefficient value for z^(-1)
+        coeff_t a2; // the denominator filter coefficient value for z^(-2)
 
-        float b0; // the numerator filter coefficient value for z^0
-        float b1; // the numerator filter coefficient value for z^(-1)
-        float b2; // the numerator filter coefficient value for z^(-2)
+        coeff_t b0; // the numerator filter coefficient value for z^0
+        coeff_t b1; // the numerator filter coefficient value for z^(-1)
+        coeff_t b2; // the numerator filter coefficient value for z^(-2)
 
-        float x1; // the input value at time sample n=-1
-        float x2; // the input value at time sample n=-2
+        T x1; // the input value at time sample n=-1
+        T x2; // the input value at time sample n=-2
 
-        float y1; // the output value at time sample n=-1
-        float y2; // the output value at time sample n=-2
+        T y1; // the output value at time sample n=-1
+        T y2; // the output value at time sample n=-2
     };
 
+    // Single precision second-order low-pass filter
+    using LowPassSecondOrder = LowPassSecondOrder_T<float>;
+    // Q15 second-order low-pass filter
+    using LowPassSecondOrder_Q15 = LowPassSecondOrder_T<zspinlab::math::type::Q15>;
+    // Q31 second-order low-pass filter
+    using LowPassSecondOrder_Q31 = LowPassSecondOrder_T<zspinlab::math::type::Q31>;
+
+    /**
+     * @brief Constructor, set initial denominator and numerator coefficients
+     * @param[in] a1 The denominator filter coefficient value for z^(-1)
+     * @param[in] a2 The denominator filter coefficient value for z^(-2)
+     * @param[in] b0 The numerator filter coefficient value for z^0
+     * @param[in] b1 The numerator filter coefficient value for z^(-1)
+     * @param[in] b2 The numerator filter coefficient value for z^(-2)
+     **/
+    template <typename T>
+    inline LowPassSecondOrder_T<T>::LowPassSecondOrder_T(coeff_t a1, coeff_t a2, coeff_t b0, coeff_t b1, coeff_t b2)
+    {
+        this->a1 = a1;
+        this->a2 = a2;
+
+        this->b0 = b0;
+        this->b1 = b1;
+        this->b2 = b2;
+
+        // Default the initial condition to zero
+        this->x1 = T();
+        this->y1 = T();
+
+        this->x2 = T();
+        this->y2 = T();
+    }
+
+    /**
+     * @brief Set the initial inputs and outputs of the filter
+     * @param[in] x1 The input value at time sample n=-1
+     * @param[in] x2 The input value at time sample n=-2
+     * @param[in] y1 The output value at time sample n=-1
+     * @param[in] y2 The output value at time sample n=-2
+     *
+     * @return None
+     **/
+    template <typename T>
+    inline void LowPassSecondOrder_T<T>::set_initial_condition(T x1, T x2, T y1, T y2)
+    {
+        this->x1 = x1;
+        this->y1 = y1;
+        this->x2 = x2;
+        this->y2 = y2;
+    }
+
+    /**
+     * @brief Get the filter denominator coefficients
+     * @param[out] a1 the denominator filter coefficient value for z^(-1)
+     * @param[out] a2 the denominator filter coefficient value for z^(-2)
+     *
+     * @return None
+     **/
+    template <typename T>
+    inline void LowPassSecondOrder_T<T>::get_denominator_coefficients(coeff_t &a1, coeff_t &a2)
+    {
+        a1 = this->a1;
+        a2 = this->a2;
+    }
+
+    /**
+     * @brief Set the filter denominator coefficients
+     * @param[in] a1 the denominator filter coefficient value for z^(-1)
+     * @param[in] a2 the denominator filter coefficient value for z^(-2)
+     *
+     * @return None
+     **/
+    template <typename T>
+    inline void LowPassSecondOrder_T<T>::set_denominator_coefficients(coeff_t a1, coeff_t a2)
+    {
+        this->a1 = a1;
+        this->a2 = a2;
+    }
+
+    /**
+     * @brief Get the filter numerator coefficients
+     * @param[out] b0 the numerator filter coefficient value for z^(0)
+     * @param[out] b1 the numerator filter coefficient value for z^(-1)
+     * @param[out] b2 the numerator filter coefficient value for z^(-2)
+     *
+     * @return None
+     **/
+    template <typename T>
+    inline void LowPassSecondOrder_T<T>::get_numerator_coefficients(coeff_t &b0, coeff_t &b1, coeff_t &b2)
+    {
+        b0 = this->b0;
+        b1 = this->b1;
+        b2 = this->b2;
+    }
+
+    /**
+     * @brief Set the filter numerator coefficients
+     * @param[in] b0 the numerator filter coefficient value for z^(0)
+     * @param[in] b1 the numerator filter coefficient value for z^(-1)
+     * @param[in] b2 the numerator filter coefficient value for z^(-2)
+     *
+     * @return None
+     **/
+    template <typename T>
+    inline void LowPassSecondOrder_T<T>::set_numerator_coefficients(coeff_t b0, coeff_t b1, coeff_t b2)
+    {
+        this->b0 = b0;
+        this->b1 = b1;
+        this->b2 = b2;
+    }
+
     /**
      * @brief Run the filter (y[n] = b0*x[n] + b1*x[n-1] + b2*x[n-2] - a1*y[n-1] - a2*y[n-2])
      * @param[in] input Input raw value x[n]
      *
      * @return Output filter value
      **/
-    inline float LowPassSecondOrder::run(float input)
+    template <typename T>
+    inline T LowPassSecondOrder_T<T>::run(T input)
     {
-        float y0 = (b0 * input) + (b1 * x1) + (b2 * x2) - (a1 * y1) - (a2 * y2);
+        T y0;
 
-        // Store new value into previous input and output value
-        x1 = input;
+        if constexpr (zspinlab::math::type::is_fixed_v<T>)
+        {
+            using wide_t = typename T::wide_t;
+
+            wide_t acc = wide_t(b0.raw()) * input.raw() + wide_t(b1.raw()) * x1.raw() +
+                         wide_t(b2.raw()) * x2.raw() - wide_t(a1.raw()) * y1.raw() - wide_t(a2.raw()) * y2.raw();
+            y0 = T::from_raw(T::saturate(T::template mul_round<coeff_t::frac_bits>(acc)));
+        }
+        else
+        {
+            y0 = (b0 * input) + (b1 * x1) + (b2 * x2) - (a1 * y1) - (a2 * y2);
+        }
+
+        // Shift the delay lines before storing the new values
         x2 = x1;
-        y1 = y0;
+        x1 = input;
         y2 = y1;
+        y1 = y0;
 
         return y0;
     }
 
-} // namespace zspinlab::math::modules
\ No newline at end of file
+    /**
+     * @brief Run several filters over a block of samples each, e.g. alpha and beta of an oversampled DMA half-buffer
+     * @param[in,out] filters One filter per channel
+     * @param[in] input       Input raw values x[n], one buffer per channel
+     * @param[out] output     Output filter values, one buffer per channel. A channel may filter in place (same buffer
+     *                        as its input), buffers of different channels must not overlap
+     * @param[in] n           Number of samples per channel
+     *
+     * @note Same result as calling run() of every filter on every sample, with the channels interleaved as in
+     * LowPassFirstOrder_T::run_block().
+     *
+     * @return None
+     **/
+    template <typename T>
+    template <size_t Channels>
+    inline void LowPassSecondOrder_T<T>::run_block(LowPassSecondOrder_T<T> (&filters)[Channels],
+                                                   const T *const (&input)[Channels],
+                                                   T *const (&output)[Channels],
+                                                   size_t n)
+    {
+        LowPassSecondOrder_T<T> local[Channels];
+
+        for (size_t ch = 0; ch < Channels; ch++)
+        {
+            local[ch] = filters[ch];
+        }
+
+        for (size_t i = 0; i < n; i++)
+        {
+            // Unrolled so that every channel keeps its state in registers, also at -O2
+            #pragma GCC unroll 8
+            for (size_t ch = 0; ch < Channels; ch++)
+            {
+                output[ch][i] = local[ch].run(input[ch][i]);
+            }
+        }
+
+        for (size_t ch = 0; ch < Channels; ch++)
+        {
+            filters[ch].x1 = local[ch].x1;
+            filters[ch].x2 = local[ch].x2;
+            filters[ch].y1 = local[ch].y1;
+            filters[ch].y2 = local[ch].y2;
+        }
+    }
+
+} // namespace zspinlab::math::modules
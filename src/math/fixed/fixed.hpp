@@ -0,0 +1,172 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace zspinlab::math::type
+{
+    /*
+     * Signed fixed-point number with saturating arithmetic, for cores without FPU.
+     *
+     * T is the storage integer (int16_t or int32_t) and Q the number of fractional bits, so Fixed<int16_t, 15> is Q15
+     * and covers [-1, 1). Products are computed in a wider integer, rounded to nearest and saturated; additions and
+     * subtractions saturate instead of wrapping, the same way the ARM QADD/QSUB instructions behave.
+     * Conversions from float are constexpr so constants are folded at compile time.
+     */
+    template <typename T, int Q>
+    class Fixed
+    {
+        static_assert(std::is_signed_v<T> && std::is_integral_v<T>, "Storage must be a signed integer");
+        static_assert(sizeof(T) <= 4, "Storage wider than 32 bits is not supported");
+        static_assert(Q > 0 && Q < static_cast<int>(8 * sizeof(T)), "Invalid number of fractional bits");
+
+    public:
+        using raw_t = T;
+        using wide_t = std::conditional_t<(sizeof(T) <= 2), int32_t, int64_t>;
+
+        static constexpr int frac_bits = Q;
+
+        constexpr Fixed(void) : value(0) {}
+
+        // Convert from floating point, saturating to the representable range
+        constexpr explicit Fixed(float in) : value(saturate(round_to_wide(static_cast<double>(in) * scale()))) {}
+        constexpr explicit Fixed(double in) : value(saturate(round_to_wide(in * scale()))) {}
+        constexpr explicit Fixed(int in) : Fixed(static_cast<double>(in)) {}
+
+        // Create a value from its raw integer representation
+        static constexpr Fixed from_raw(T raw)
+        {
+            Fixed out;
+            out.value = raw;
+            return out;
+        }
+
+        // Get the raw integer representation
+        constexpr T raw(void) const { return value; }
+
+        // Convert to floating point
+        constexpr float to_float(void) const { return static_cast<float>(value / scale()); }
+        constexpr explicit operator float(void) const { return to_float(); }
+
+        // Largest representable value
+        static constexpr Fixed max(void) { return from_raw(std::numeric_limits<T>::max()); }
+        // Smallest representable value
+        static constexpr Fixed min(void) { return from_raw(std::numeric_limits<T>::min()); }
+
+        // Saturate a wide intermediate to the storage range
+        static constexpr T saturate(wide_t in)
+        {
+            return (in > std::numeric_limits<T>::max())   ? std::numeric_limits<T>::max()
+                   : (in < std::numeric_limits<T>::min()) ? std::numeric_limits<T>::min()
+                                                          : static_cast<T>(in);
+        }
+
+        constexpr Fixed operator+(Fixed rhs) const { return from_raw(saturate(wide_t(value) + rhs.value)); }
+        constexpr Fixed operator-(Fixed rhs) const { return from_raw(saturate(wide_t(value) - rhs.value)); }
+        constexpr Fixed operator-(void) const { return from_raw(saturate(-wide_t(value))); }
+
+        // Multiply by a value in any Q format sharing the same storage, the result keeps the format of the left operand
+        template <int Q2>
+        constexpr Fixed operator*(Fixed<T, Q2> rhs) const
+        {
+            return from_raw(saturate(mul_round<Q2>(wide_t(value) * rhs.raw())));
+        }
+
+        constexpr Fixed &operator+=(Fixed rhs) { return *this = *this + rhs; }
+        constexpr Fixed &operator-=(Fixed rhs) { return *this = *this - rhs; }
+
+        template <int Q2>
+        constexpr Fixed &operator*=(Fixed<T, Q2> rhs) { return *this = *this * rhs; }
+
+        constexpr bool operator==(Fixed rhs) const { return value == rhs.value; }
+        constexpr bool operator!=(Fixed rhs) const { return value != rhs.value; }
+        constexpr bool operator<(Fixed rhs) const { return value < rhs.value; }
+        constexpr bool operator>(Fixed rhs) const { return value > rhs.value; }
+        constexpr bool operator<=(Fixed rhs) const { return value <= rhs.value; }
+        constexpr bool operator>=(Fixed rhs) const { return value >= rhs.value; }
+
+        // Round a wide product with S fractional bits too many back to the storage scale (round half up)
+        template <int S>
+        static constexpr wide_t mul_round(wide_t product)
+        {
+            return (product + (wide_t(1) << (S - 1))) >> S;
+        }
+
+    private:
+        T value;
+
+        static constexpr double scale(void) { return static_cast<double>(wide_t(1) << Q); }
+
+        static constexpr wide_t round_to_wide(double in)
+        {
+            // Clip before the integer conversion to stay defined for out-of-range inputs
+            constexpr double lim = static_cast<double>(std::numeric_limits<T>::max()) + 1.0;
+            in = (in > lim) ? lim : (in < -lim) ? -lim : in;
+            return static_cast<wide_t>(in < 0.0 ? in - 0.5 : in + 0.5);
+        }
+    };
+
+    // Q1.15, [-1, 1) with 16-bit storage
+    using Q15 = Fixed<int16_t, 15>;
+    // Q1.31, [-1, 1) with 32-bit storage
+    using Q31 = Fixed<int32_t, 31>;
+
+    /**
+     * @brief Integer square root, floor(sqrt(in)), in a fixed number of iterations
+     * @param[in] in Input unsigned integer
+     *
+     * @return Integer square root
+     **/
+    template <typename U>
+    constexpr U isqrt(U in)
+    {
+        static_assert(std::is_unsigned_v<U>, "isqrt requires an unsigned type");
+
+        U res = 0;
+        U bit = U(1) << (8 * sizeof(U) - 2);
+
+        while (bit != 0)
+        {
+            if (in >= res + bit)
+            {
+                in -= res + bit;
+                res = (res >> 1) + bit;
+            }
+            else
+            {
+                res >>= 1;
+            }
+            bit >>= 2;
+        }
+
+        return res;
+    }
+
+    // Check if a type is a Fixed point type
+    template <typename T>
+    struct is_fixed : std::false_type {};
+
+    template <typename T, int Q>
+    struct is_fixed<Fixed<T, Q>> : std::true_type {};
+
+    template <typename T>
+    inline constexpr bool is_fixed_v = is_fixed<T>::value;
+
+    // Filter coefficient type for a sample type: the sample type itself, or two more integer bits ([-4, 4)) for Fixed
+    template <typename T>
+    struct coeff
+    {
+        using type = T;
+    };
+
+    template <typename T, int Q>
+    struct coeff<Fixed<T, Q>>
+    {
+        using type = Fixed<T, Q - 2>;
+    };
+
+    template <typename T>
+    using coeff_t = typename coeff<T>::type;
+
+} // namespace zspinlab::math::type
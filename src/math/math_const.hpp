@@ -5,4 +5,7 @@
 #define MATH_1_BY_SQRT_3            0.57735026919f          // 1/sqrt(3)
 #define MATH_2_BY_SQRT_3            1.15470053838f          // 2/sqrt(3)
 #define MATH_2_BY_3                 0.6666666666666667f     // 2/3
-#define MATH_1_BY_3                 0.3333333333333333f     // 2/3
\ No newline at end of file
+#define MATH_1_BY_3                 0.3333333333333333f     // 1/3
+#define MATH_PI                     3.14159265358979323846f // pi
+#define MATH_PI_BY_2                1.57079632679489661923f // pi/2
+#define MATH_1_BY_2PI               0.15915494309189535f    // 1/(2*pi)
\ No newline at end of file
@@ -1,20 +1,108 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <math.h>
+#include <type_traits>
 
 #include "math_const.hpp"
-#include "pi/pi.hpp"
-#include "pid/pid.hpp"
+#include "fixed/fixed.hpp"
+#include "trig/sincos_lut.hpp"
+#include "trig/atan_poly.hpp"
+#include "trig/cordic.hpp"
+#include "exp/exp_approx.hpp"
+#include "filter/design/filter_design.hpp"
 #include "filter/lowpass/fo/lpfo.hpp"
 #include "filter/lowpass/so/lpso.hpp"
+#include "filter/iir/biquad_cascade.hpp"
+#include "pi/pi.hpp"
+#include "pid/pid.hpp"
+#include "phasor/phasor.hpp"
+#include "pll/quadrature_pll.hpp"
+#include "profiling/profiler.hpp"
 
 #if defined(CONFIG_CMSIS_DSP) && defined(CONFIG_ARM)
 #include <arm_math.h>
 #endif
 
+// Quarter-wave sine table size used by the generic (non CMSIS-DSP) sine/cosine path, must be a power of two
+#ifndef CONFIG_ZSPINLAB_SINCOS_LUT_SIZE
+#define CONFIG_ZSPINLAB_SINCOS_LUT_SIZE 256
+#endif
+
+// Use quadratic instead of linear interpolation between the sine table entries
+#ifdef CONFIG_ZSPINLAB_SINCOS_LUT_QUADRATIC
+#define ZSPINLAB_SINCOS_LUT_PRECISION zspinlab::math::basic::SinCosPrecision::QUADRATIC
+#else
+#define ZSPINLAB_SINCOS_LUT_PRECISION zspinlab::math::basic::SinCosPrecision::LINEAR
+#endif
+
+// Use the degree 11 instead of the degree 7 polynomial in the generic atan2
+#ifdef CONFIG_ZSPINLAB_ATAN2_ACCURATE
+#define ZSPINLAB_ATAN2_PRECISION zspinlab::math::basic::AtanPrecision::ACCURATE
+#else
+#define ZSPINLAB_ATAN2_PRECISION zspinlab::math::basic::AtanPrecision::FAST
+#endif
+
 namespace zspinlab::math::type
 {
+    /*
+     * Reference frame values, passed and returned by value.
+     *
+     * Small trivially-copyable aggregates of T (float or a zspinlab::math::type::Fixed type), so that the by-value
+     * transforms below keep them in registers (returned in FPU registers on hard-float ABIs), and a stationary value
+     * cannot be passed where a rotating one is expected.
+     */
+
+    // Three phase coordinates
+    template <typename T = float>
+    struct Abc_T
+    {
+        T a, b, c;
+    };
+
+    // Two-phase stationary frame coordinates
+    template <typename T = float>
+    struct AlphaBeta_T
+    {
+        T alpha, beta;
+    };
+
+    // Rotor reference frame coordinates
+    template <typename T = float>
+    struct Dq_T
+    {
+        T d, q;
+    };
+
+    // Sine and cosine of a rotation angle
+    template <typename T = float>
+    struct SinCos_T
+    {
+        T sin, cos;
+    };
+
+    // Single precision frame values
+    using Abc = Abc_T<float>;
+    using AlphaBeta = AlphaBeta_T<float>;
+    using Dq = Dq_T<float>;
+    using SinCos = SinCos_T<float>;
+
+    // Q15 frame values
+    using Abc_Q15 = Abc_T<Q15>;
+    using AlphaBeta_Q15 = AlphaBeta_T<Q15>;
+    using Dq_Q15 = Dq_T<Q15>;
+    using SinCos_Q15 = SinCos_T<Q15>;
+
+    // Q31 frame values
+    using Abc_Q31 = Abc_T<Q31>;
+    using AlphaBeta_Q31 = AlphaBeta_T<Q31>;
+    using Dq_Q31 = Dq_T<Q31>;
+    using SinCos_Q31 = SinCos_T<Q31>;
+
+    static_assert(std::is_trivially_copyable_v<Abc> && std::is_trivially_copyable_v<AlphaBeta> &&
+                  std::is_trivially_copyable_v<Dq> && std::is_trivially_copyable_v<SinCos>);
+    static_assert(std::is_trivially_copyable_v<Abc_Q31> && std::is_trivially_copyable_v<SinCos_Q31>);
 
 } // namespace zspinlab::math::type
 
@@ -48,7 +136,7 @@ namespace zspinlab::math::basic
 #if defined(CONFIG_CMSIS_DSP) && defined(CONFIG_ARM)
         // Currently only support ARM with DSP functions
         float x;
-        (void)arm_sqrt_f32(square, x);
+        (void)arm_sqrt_f32(square, &x);
         return x;
 #else
         // Generic newlib implementation
@@ -56,25 +144,44 @@ namespace zspinlab::math::basic
 #endif
     }
 
+    // Sine/cosine table used by the generic implementation
+    using SinCosLUT = SinCosTable<CONFIG_ZSPINLAB_SINCOS_LUT_SIZE, ZSPINLAB_SINCOS_LUT_PRECISION>;
+
     inline void fsincosf(const float angle_deg, float &sin_out, float &cos_out)
     {
 #if defined(CONFIG_CMSIS_DSP) && defined(CONFIG_ARM)
         // Currently only support ARM with DSP functions
-        arm_sin_cos_f32(angle_deg, sin_out, cos_out);
+        arm_sin_cos_f32(angle_deg, &sin_out, &cos_out);
 #else
-        // Generic newlib implementation. This will be really slow and inefficient
-        const angle_rad = angle_deg * 180.0f * M_1_PI;
-        sin_out = sinf(angle_rad);
-        cos_out = cosf(angle_rad);
+        // Generic implementation, quarter-wave lookup table with interpolation
+        SinCosLUT::sincos_deg(angle_deg, sin_out, cos_out);
 #endif
     }
 
-    // Float exp(x)
+    // Compute sine and cosine from a per-unit angle (1.0 is one full electrical turn)
+    inline void fsincosf_pu(const float angle_pu, float &sin_out, float &cos_out)
+    {
+#if defined(CONFIG_CMSIS_DSP) && defined(CONFIG_ARM)
+        // Currently only support ARM with DSP functions
+        arm_sin_cos_f32(angle_pu * 360.0f, &sin_out, &cos_out);
+#else
+        // Generic implementation, quarter-wave lookup table with interpolation
+        SinCosLUT::sincos_pu(angle_pu, sin_out, cos_out);
+#endif
+    }
+
+    // Compute the four-quadrant arctangent of y / x [rad]
+    inline float fatan2f(const float y, const float x)
+    {
+        // Generic implementation, minimax polynomial, no CMSIS-DSP counterpart in every supported version
+        return atan2_poly<ZSPINLAB_ATAN2_PRECISION>(y, x);
+    }
+
+    // Float exp(x), the accuracy tier is chosen per call site, e.g. fexpf<ExpPrecision::POLY3>(x)
+    template <ExpPrecision precision = ExpPrecision::FULL>
     inline float fexpf(const float in)
     {
-        // TODO: Sacrifice precision for speed with Taylor expansion:
-        // https://stackoverflow.com/questions/10552280/fast-exp-calculation-possible-to-improve-accuracy-without-losing-too-much-perfo
-        return expf(in);
+        return exp_approx<precision>(in);
     }
 
     // Float fabs(x)
@@ -112,6 +219,8 @@ namespace zspinlab::math::function
                                  float &i_alpha,
                                  float &i_beta)
     {
+        ZSPINLAB_PROFILE_SCOPE(CLARKE);
+
         // Statically check if we are using all the three phases
         if constexpr (use_all_phase)
         {
@@ -188,17 +297,275 @@ namespace zspinlab::math::function
                                        float &i_alpha,
                                        float &i_beta)
     {
+        ZSPINLAB_PROFILE_SCOPE(INVERSE_PARK);
+
         i_alpha = id * cos_theta - iq * sin_theta;
         i_beta = id * sin_theta + iq * cos_theta;
     }
 
+    /**
+     * @brief Fixed-point vector Clarke transform, saturating
+     * @param[in] use_all_phase Using all the input phase coordinates. This is statically defined
+     * @param[in] iA            Input three phase coordinate A
+     * @param[in] iB            Input three phase coordinate B
+     * @param[in] iC            (Optional) Input three phase coordinate C, ignored if \p use_all_phase is set to false
+     * @param[out] i_alpha      Output two-phase vector coordinate alpha
+     * @param[out] i_beta       Output two-phase vector coordinate beta
+     *
+     * @return None
+     **/
+    template <bool use_all_phase, typename T, int Q>
+    inline void clarke_transform(type::Fixed<T, Q> iA,
+                                 type::Fixed<T, Q> iB,
+                                 type::Fixed<T, Q> iC,
+                                 type::Fixed<T, Q> &i_alpha,
+                                 type::Fixed<T, Q> &i_beta)
+    {
+        ZSPINLAB_PROFILE_SCOPE(CLARKE);
+
+        using fixed_t = type::Fixed<T, Q>;
+
+        constexpr fixed_t k_2_by_3(MATH_2_BY_3);
+        constexpr fixed_t k_1_by_3(MATH_1_BY_3);
+        constexpr fixed_t k_1_by_sqrt_3(MATH_1_BY_SQRT_3);
+
+        if constexpr (use_all_phase)
+        {
+            // Scale each term first so that no intermediate saturates
+            i_alpha = iA * k_2_by_3 - iB * k_1_by_3 - iC * k_1_by_3;
+            i_beta = iB * k_1_by_sqrt_3 - iC * k_1_by_sqrt_3;
+        }
+        else
+        {
+            // 2/sqrt(3) is out of the Q1.x range, scale each term first so that no intermediate saturates
+            (void)iC;
+            const fixed_t iB_by_sqrt_3 = iB * k_1_by_sqrt_3;
+
+            i_alpha = iA;
+            i_beta = iA * k_1_by_sqrt_3 + iB_by_sqrt_3 + iB_by_sqrt_3;
+        }
+    }
+
+    /**
+     * @brief Fixed-point vector Park transform, saturating
+     * @param[in] i_alpha   Input two-phase vector coordinate alpha
+     * @param[in] i_beta    Input two-phase vector coordinate beta
+     * @param[in] sin_theta Sine value of rotation angle theta
+     * @param[in] cos_theta Cosine value of rotation angle theta
+     * @param[out] id       Output coordinate rotor reference frame d
+     * @param[out] iq       Output coordinate rotor reference frame q
+     *
+     * @return None
+     **/
+    template <typename T, int Q>
+    inline void park_transform(type::Fixed<T, Q> i_alpha,
+                               type::Fixed<T, Q> i_beta,
+                               type::Fixed<T, Q> sin_theta,
+                               type::Fixed<T, Q> cos_theta,
+                               type::Fixed<T, Q> &id,
+                               type::Fixed<T, Q> &iq)
+    {
+        id = i_alpha * cos_theta + i_beta * sin_theta;
+        iq = i_beta * cos_theta - i_alpha * sin_theta;
+    }
+
+    /**
+     * @brief Fixed-point vector Inverse Park transform, saturating
+     * @param[in] id        Input coordinate of rotor reference frame d
+     * @param[in] iq        Input coordinate rotor reference frame q
+     * @param[in] sin_theta Sine value of rotation angle theta
+     * @param[in] cos_theta Cosine value of rotation angle theta
+     * @param[out] i_alpha  Output two-phase vector coordinate alpha
+     * @param[out] i_beta   Output two-phase vector coordinate beta
+     *
+     * @return None
+     **/
+    template <typename T, int Q>
+    inline void inverse_park_transform(type::Fixed<T, Q> id,
+                                       type::Fixed<T, Q> iq,
+                                       type::Fixed<T, Q> sin_theta,
+                                       type::Fixed<T, Q> cos_theta,
+                                       type::Fixed<T, Q> &i_alpha,
+                                       type::Fixed<T, Q> &i_beta)
+    {
+        ZSPINLAB_PROFILE_SCOPE(INVERSE_PARK);
+
+        i_alpha = id * cos_theta - iq * sin_theta;
+        i_beta = id * sin_theta + iq * cos_theta;
+    }
+
+    /**
+     * @brief Vector Clarke transform, by value
+     * @param[in] use_all_phase Using all the input phase coordinates. This is statically defined
+     * @param[in] i_abc         Input three phase coordinates, c is ignored if \p use_all_phase is set to false
+     *
+     * @return Two-phase vector coordinates
+     **/
+    template <bool use_all_phase, typename T>
+    inline type::AlphaBeta_T<T> clarke_transform(type::Abc_T<T> i_abc)
+    {
+        type::AlphaBeta_T<T> i_ab;
+
+        clarke_transform<use_all_phase>(i_abc.a, i_abc.b, i_abc.c, i_ab.alpha, i_ab.beta);
+        return i_ab;
+    }
+
+    /**
+     * @brief Vector Inverse Clarke transform, by value
+     * @param[in] i_ab Input two-phase vector coordinates
+     *
+     * @return Three phase coordinates
+     **/
+    inline type::Abc inverse_clarke_transform(type::AlphaBeta i_ab)
+    {
+        type::Abc i_abc;
+
+        inverse_clarke_transform(i_ab.alpha, i_ab.beta, i_abc.a, i_abc.b, i_abc.c);
+        return i_abc;
+    }
+
+    /**
+     * @brief Vector Park transform, by value
+     * @param[in] i_ab  Input two-phase vector coordinates
+     * @param[in] theta Sine and cosine of rotation angle theta
+     *
+     * @return Rotor reference frame coordinates
+     **/
+    template <typename T>
+    inline type::Dq_T<T> park_transform(type::AlphaBeta_T<T> i_ab, type::SinCos_T<T> theta)
+    {
+        type::Dq_T<T> i_dq;
+
+        park_transform(i_ab.alpha, i_ab.beta, theta.sin, theta.cos, i_dq.d, i_dq.q);
+        return i_dq;
+    }
+
+    /**
+     * @brief Vector Inverse Park transform, by value
+     * @param[in] i_dq  Input rotor reference frame coordinates
+     * @param[in] theta Sine and cosine of rotation angle theta
+     *
+     * @return Two-phase vector coordinates
+     **/
+    template <typename T>
+    inline type::AlphaBeta_T<T> inverse_park_transform(type::Dq_T<T> i_dq, type::SinCos_T<T> theta)
+    {
+        type::AlphaBeta_T<T> i_ab;
+
+        inverse_park_transform(i_dq.d, i_dq.q, theta.sin, theta.cos, i_ab.alpha, i_ab.beta);
+        return i_ab;
+    }
+
+    /**
+     * @brief Vector Clarke transform of a block of samples, e.g. the oversampled phase currents of a DMA half-buffer
+     * @param[in] use_all_phase Using all the input phase coordinates. This is statically defined
+     * @param[in] iA            Input three phase coordinates A
+     * @param[in] iB            Input three phase coordinates B
+     * @param[in] iC            (Optional) Input three phase coordinates C, not read if \p use_all_phase is set to false
+     * @param[out] i_alpha      Output two-phase vector coordinates alpha. May be the same buffer as \p iA
+     * @param[out] i_beta       Output two-phase vector coordinates beta. May be the same buffer as \p iB
+     * @param[in] n             Number of samples in the block
+     *
+     * @return None
+     **/
+    template <bool use_all_phase>
+    inline void clarke_transform_block(const float *iA,
+                                       const float *iB,
+                                       const float *iC,
+                                       float *i_alpha,
+                                       float *i_beta,
+                                       size_t n)
+    {
+        for (size_t i = 0; i < n; i++)
+        {
+            const float a = iA[i];
+            const float b = iB[i];
+
+            if constexpr (use_all_phase)
+            {
+                const float c = iC[i];
+
+                i_alpha[i] = MATH_2_BY_3 * a - MATH_1_BY_3 * (b + c);
+                i_beta[i] = MATH_1_BY_SQRT_3 * (b - c);
+            }
+            else
+            {
+                (void)iC;
+                i_alpha[i] = a;
+                i_beta[i] = MATH_1_BY_SQRT_3 * a + MATH_2_BY_SQRT_3 * b;
+            }
+        }
+    }
+
+    /**
+     * @brief Vector Park transform of a block of samples taken at the same rotation angle
+     * @param[in] i_alpha Input two-phase vector coordinates alpha
+     * @param[in] i_beta  Input two-phase vector coordinates beta
+     * @param[in] theta   Sine and cosine of rotation angle theta
+     * @param[out] id     Output coordinates rotor reference frame d. May be the same buffer as \p i_alpha
+     * @param[out] iq     Output coordinates rotor reference frame q. May be the same buffer as \p i_beta
+     * @param[in] n       Number of samples in the block
+     *
+     * @return None
+     **/
+    inline void park_transform_block(const float *i_alpha,
+                                     const float *i_beta,
+                                     type::SinCos theta,
+                                     float *id,
+                                     float *iq,
+                                     size_t n)
+    {
+        for (size_t i = 0; i < n; i++)
+        {
+            const float alpha = i_alpha[i];
+            const float beta = i_beta[i];
+
+            id[i] = alpha * theta.cos + beta * theta.sin;
+            iq[i] = -alpha * theta.sin + beta * theta.cos;
+        }
+    }
+
+    /**
+     * @brief Vector Park transform of a block of samples, one rotation angle per sample
+     * @param[in] i_alpha   Input two-phase vector coordinates alpha
+     * @param[in] i_beta    Input two-phase vector coordinates beta
+     * @param[in] sin_theta Sine values of rotation angle theta
+     * @param[in] cos_theta Cosine values of rotation angle theta
+     * @param[out] id       Output coordinates rotor reference frame d. May be the same buffer as \p i_alpha
+     * @param[out] iq       Output coordinates rotor reference frame q. May be the same buffer as \p i_beta
+     * @param[in] n         Number of samples in the block
+     *
+     * @return None
+     **/
+    inline void park_transform_block(const float *i_alpha,
+                                     const float *i_beta,
+                                     const float *sin_theta,
+                                     const float *cos_theta,
+                                     float *id,
+                                     float *iq,
+                                     size_t n)
+    {
+        for (size_t i = 0; i < n; i++)
+        {
+            const float alpha = i_alpha[i];
+            const float beta = i_beta[i];
+
+            id[i] = alpha * cos_theta[i] + beta * sin_theta[i];
+            iq[i] = -alpha * sin_theta[i] + beta * cos_theta[i];
+        }
+    }
+
 } // namespace zspinlab::math::function
 
 // Namespace for motor control algorithm classes
 namespace zspinlab::math::modules
 {
-    class LowPassFirstOrder;
-    class LowPassSecondOrder;
-    class PI;
-    class PID;
+    template <typename T> class LowPassFirstOrder_T;
+    template <typename T> class LowPassSecondOrder_T;
+    template <size_t Stages, size_t Channels, typename T> class BiquadCascade;
+    template <uint8_t Order, uint16_t Ratio, size_t Channels> class CicDecimator;
+    template <typename T> class PI_T;
+    template <typename T> class PID_T;
+    class PhasorOscillator;
+    class QuadraturePLL;
 } // namespace zspinlab::math::modules
\ No newline at end of file
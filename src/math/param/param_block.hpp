@@ -0,0 +1,115 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace zspinlab::math::type
+{
+    /*
+     * Parameter block shared between a tuning thread (writer) and the control ISR (reader), double-buffered and
+     * sequence locked.
+     *
+     * The writer publishes complete parameter sets, the ISR fetches the latest one at tick start into its own working
+     * copy, so a tick never runs with a mix of old and new parameters. Both sides are wait-free and only need plain
+     * atomic loads and stores (no read-modify-write, also fine on Cortex-M0+). The writer fills the slot the latest set
+     * is not in, so a fetch only fails if two publishes overlap it: the ISR then keeps its current set until the next
+     * tick instead of retrying.
+     *
+     * @tparam P Parameter set type, must be trivially copyable
+     */
+    template <typename P>
+    class ParamBlock
+    {
+        static_assert(std::is_trivially_copyable_v<P>, "Parameter set must be trivially copyable");
+
+    public:
+        ParamBlock(void) : latest(0), published(0), fetched(0) {}
+
+        void publish(const P &params);
+        bool fetch(P &params);
+
+    private:
+        // The set is stored as relaxed atomic words so that a concurrent read is never a data race
+        static constexpr size_t WORDS = (sizeof(P) + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+
+        struct Slot
+        {
+            std::atomic<uint32_t> sequence{0};      // Twice the publish count of the set, odd while it is written
+            std::atomic<uint32_t> words[WORDS] = {};
+        };
+
+        Slot slots[2];
+
+        std::atomic<uint8_t> latest;    // Slot of the latest complete set
+        uint32_t published;             // Publish count, writer owned
+        uint32_t fetched;               // Sequence of the last fetched set, reader owned
+    };
+
+    /**
+     * @brief Publish a complete parameter set (writer side, wait-free, single writer)
+     * @param[in] params Parameter set
+     *
+     * @return None
+     **/
+    template <typename P>
+    inline void ParamBlock<P>::publish(const P &params)
+    {
+        const uint8_t index = latest.load(std::memory_order_relaxed) ^ 1;
+        Slot &slot = slots[index];
+        uint32_t buffer[WORDS] = {};
+
+        std::memcpy(buffer, &params, sizeof(P));
+        published++;
+
+        slot.sequence.store(2 * published - 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        for (size_t i = 0; i < WORDS; i++)
+        {
+            slot.words[i].store(buffer[i], std::memory_order_relaxed);
+        }
+
+        slot.sequence.store(2 * published, std::memory_order_release);
+        latest.store(index, std::memory_order_release);
+    }
+
+    /**
+     * @brief Fetch the latest parameter set if a new one was published (reader side, wait-free)
+     * @param[out] params Parameter set, left untouched if there is no new complete set
+     *
+     * @return true if a new set was fetched, false otherwise or if a publish was in progress
+     **/
+    template <typename P>
+    inline bool ParamBlock<P>::fetch(P &params)
+    {
+        const Slot &slot = slots[latest.load(std::memory_order_acquire)];
+        const uint32_t seq = slot.sequence.load(std::memory_order_acquire);
+        uint32_t buffer[WORDS];
+
+        if (seq == fetched || (seq & 1) != 0)
+        {
+            return false;
+        }
+
+        for (size_t i = 0; i < WORDS; i++)
+        {
+            buffer[i] = slot.words[i].load(std::memory_order_relaxed);
+        }
+
+        // Torn set, the slot was reused meanwhile, try again on the next tick
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) != seq)
+        {
+            return false;
+        }
+
+        std::memcpy(&params, buffer, sizeof(P));
+        fetched = seq;
+
+        return true;
+    }
+
+} // namespace zspinlab::math::type
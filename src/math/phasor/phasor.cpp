@@ -0,0 +1,55 @@
+#include "phasor.hpp"
+#include "math/math_core.hpp"
+
+namespace zspinlab::math::modules
+{
+    /**
+     * @brief Constructor, start at angle zero
+     * @param[in] delta_pu      Angle increment per call (1.0 is one full electrical turn)
+     * @param[in] renorm_period Number of calls between two amplitude corrections
+     **/
+    PhasorOscillator::PhasorOscillator(float delta_pu, uint16_t renorm_period)
+    {
+        this->renorm_period = renorm_period;
+
+        set_angle_pu(0.0f);
+        set_delta_pu(delta_pu);
+    }
+
+    /**
+     * @brief Restart the phasor at a given angle
+     * @param[in] angle_pu Angle (1.0 is one full electrical turn)
+     *
+     * @return None
+     **/
+    void PhasorOscillator::set_angle_pu(float angle_pu)
+    {
+        zspinlab::math::basic::fsincosf_pu(angle_pu, sin_theta, cos_theta);
+        renorm_count = 0;
+    }
+
+    /**
+     * @brief Set the angle increment applied every call
+     * @param[in] delta_pu Angle increment (1.0 is one full electrical turn)
+     *
+     * @return None
+     **/
+    void PhasorOscillator::set_delta_pu(float delta_pu)
+    {
+        zspinlab::math::basic::fsincosf_pu(delta_pu, sin_delta, cos_delta);
+    }
+
+    /**
+     * @brief Set the angle increment applied every call from its sine and cosine
+     * @param[in] sin_delta Sine value of the angle increment
+     * @param[in] cos_delta Cosine value of the angle increment
+     *
+     * @return None
+     **/
+    void PhasorOscillator::set_delta_sincos(float sin_delta, float cos_delta)
+    {
+        this->sin_delta = sin_delta;
+        this->cos_delta = cos_delta;
+    }
+
+} // namespace zspinlab::math::modules
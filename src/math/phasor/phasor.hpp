@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstdint>
+
+namespace zspinlab::math::modules
+{
+    /*
+     * Incremental rotating-phasor angle generator.
+     *
+     * Keeps the (cos, sin) pair of the electrical angle and rotates it by a precomputed delta every call, so no trig
+     * call is needed in the PWM interrupt once the angle increment (speed) is known. Rounding makes the phasor
+     * amplitude drift slowly, it is pulled back to 1 every renorm_period calls with a first-order Newton step (no sqrt,
+     * no divide).
+     */
+    class PhasorOscillator
+    {
+    public:
+        PhasorOscillator(float delta_pu = 0.0f, uint16_t renorm_period = 16U);
+
+        // Restart the phasor at a given angle (1.0 is one full electrical turn)
+        void set_angle_pu(float angle_pu);
+
+        // Set the angle increment per call (1.0 is one full electrical turn)
+        void set_delta_pu(float delta_pu);
+
+        // Set the angle increment per call from its sine and cosine
+        void set_delta_sincos(float sin_delta, float cos_delta);
+
+        // Set the angle increment per call from a small angle in radian, without any trig call
+        void set_delta_rad_small(float delta_rad);
+
+        // Set how many calls to run() between two amplitude corrections
+        void set_renorm_period(uint16_t renorm_period) { this->renorm_period = renorm_period; }
+
+        void run(void);
+
+        // Get the sine value of the current angle
+        float get_sin(void) { return sin_theta; }
+        // Get the cosine value of the current angle
+        float get_cos(void) { return cos_theta; }
+
+    private:
+        float sin_theta, cos_theta; // Current phasor
+        float sin_delta, cos_delta; // Rotation applied every call
+
+        uint16_t renorm_period;     // Calls between two amplitude corrections
+        uint16_t renorm_count;      // Calls since the last amplitude correction
+    };
+
+    /**
+     * @brief Set the angle increment per call from a small angle in radian, without any trig call
+     * @param[in] delta_rad Angle increment in radian, typically omega_e * Ts from the speed estimate
+     *
+     * @note Truncated Taylor expansion, accurate to ~1e-7 for |delta_rad| < 0.1 (more than 60 calls per electrical
+     * turn). Use set_delta_pu() for larger increments.
+     *
+     * @return None
+     **/
+    inline void PhasorOscillator::set_delta_rad_small(float delta_rad)
+    {
+        const float d2 = delta_rad * delta_rad;
+
+        sin_delta = delta_rad * (1.0f - d2 * (1.0f / 6.0f));
+        cos_delta = 1.0f - d2 * 0.5f * (1.0f - d2 * (1.0f / 12.0f));
+    }
+
+    /**
+     * @brief Advance the phasor by one angle increment
+     *
+     * @return None
+     **/
+    inline void PhasorOscillator::run(void)
+    {
+        const float c = cos_theta * cos_delta - sin_theta * sin_delta;
+        const float s = sin_theta * cos_delta + cos_theta * sin_delta;
+
+        if (++renorm_count >= renorm_period)
+        {
+            // 1/sqrt(m) ~ (3 - m) / 2 around m = 1
+            const float k = 1.5f - 0.5f * (c * c + s * s);
+
+            cos_theta = c * k;
+            sin_theta = s * k;
+            renorm_count = 0;
+        }
+        else
+        {
+            cos_theta = c;
+            sin_theta = s;
+        }
+    }
+
+} // namespace zspinlab::math::modules
@@ -2,20 +2,10 @@
 
 namespace zspinlab::math::modules
 {
-    /**
-     * @brief Initialize the PI controller general parameters
-     * @param[in] kP        Proportional gain
-     * @param[in] kI        Integral gain
-     * @param[in] outMin    Minimum controller output
-     * @param[in] outMax    Maximum controller output
-     **/
-    PI::PI(float kP, float kI, float outMin, float outMax)
-    {
-        this->kP = kP;
-        this->kI = kI;
+    // Explicit instantiation of every supported sample type, so that each of them is built with the library
+    template class PI_T<float>;
+    template class PI_T<double>;
+    template class PI_T<zspinlab::math::type::Q15>;
+    template class PI_T<zspinlab::math::type::Q31>;
 
-        this->outMin = outMin;
-        this->outMax = outMax;
-    }
-
-} // namespace zspinlab::math::modules
\ No newline at end of file
+} // namespace zspinlab::math::modules
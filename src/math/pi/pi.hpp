@@ -1,49 +1,124 @@
 #pragma once
 
 #include <zephyr/sys/util.h>
-#include "math/math_core.hpp"
+#include "math/fixed/fixed.hpp"
+#include "math/param/param_block.hpp"
+#include "profiling/profiler.hpp"
 
 namespace zspinlab::math::modules
 {
-    // Create a generic PI controller
-    class PI
+    /*
+     * Create a generic PI controller.
+     *
+     * T is the sample type: float on the target, double for host simulation or a zspinlab::math::type::Fixed type on
+     * cores without FPU. With a Fixed type the gains share the signal Q format, so they must fit in its range: scale
+     * the plant to per-unit values or pick a format with integer headroom (e.g. Fixed<int32_t, 24>).
+     */
+    template <typename T>
+    class PI_T
     {
     public:
-        /**
-         * @brief Initialize the PID controller general parameters
-         * @param[in] kP        Proportional gain
-         * @param[in] kI        Integral gain
-         * @param[in] outMin    Minimum controller output
-         * @param[in] outMax    Maximum controller output
-         **/
-        PI(float kP = 0.0f, float kI = 0.0f, float outMin = 0.0f, float outMax = 0.0f);
+        // Complete parameter set, published as a whole from a tuning thread through a ParamBlock
+        struct Params
+        {
+            T kP, kI;
+            T outMin, outMax;
+        };
+
+        PI_T(T kP = T(), T kI = T(), T outMin = T(), T outMax = T());
 
-        float run(float sp, float pv, float ffwd);
-        float reset_state(void);
+        T run(T sp, T pv, T ffwd);
+        void reset_state(void);
 
-        float get_kp(void) { return kP; }
-        float get_ki(void) { return kI; }
+        Params get_params(void) { return Params{kP, kI, outMin, outMax}; }
+        void set_params(const Params &params);
+        bool update_params(zspinlab::math::type::ParamBlock<Params> &block);
 
-        void set_kp(float kP) { this->kP = kP; }
-        void set_ki(float kI) { this->kI = kI; }
+        T get_kp(void) { return kP; }
+        T get_ki(void) { return kI; }
 
-        float get_outMin(void) { return outMin; }
-        float get_outMax(void) { return outMax; }
+        void set_kp(T kP) { this->kP = kP; }
+        void set_ki(T kI) { this->kI = kI; }
 
-        void set_outMin(float outMin) { this->outMin = outMin; }
-        void set_outMax(float outMax) { this->outMax = outMax; }
+        T get_outMin(void) { return outMin; }
+        T get_outMax(void) { return outMax; }
+
+        void set_outMin(T outMin) { this->outMin = outMin; }
+        void set_outMax(T outMax) { this->outMax = outMax; }
 
     private:
-        float kP, kI;
-        float outMin, outMax;
+        T kP, kI;
+        T outMin, outMax;
 
-        float prev_i_term; // Previous integrator term
+        T prev_i_term; // Previous integrator term
 
-        float prev_sp;   // Previous desired setpoint
-        float prev_pv;   // Previous measured process variable
-        float prev_ffwd; // Previous feed-forward variable
+        T prev_sp;   // Previous desired setpoint
+        T prev_pv;   // Previous measured process variable
+        T prev_ffwd; // Previous feed-forward variable
     };
 
+    // Single precision PI controller
+    using PI = PI_T<float>;
+    // Q15 PI controller
+    using PI_Q15 = PI_T<zspinlab::math::type::Q15>;
+    // Q31 PI controller
+    using PI_Q31 = PI_T<zspinlab::math::type::Q31>;
+
+    /**
+     * @brief Initialize the PI controller general parameters
+     * @param[in] kP        Proportional gain
+     * @param[in] kI        Integral gain
+     * @param[in] outMin    Minimum controller output
+     * @param[in] outMax    Maximum controller output
+     **/
+    template <typename T>
+    inline PI_T<T>::PI_T(T kP, T kI, T outMin, T outMax)
+    {
+        this->kP = kP;
+        this->kI = kI;
+
+        this->outMin = outMin;
+        this->outMax = outMax;
+
+        reset_state();
+    }
+
+    /**
+     * @brief Set all the PI controller parameters at once
+     * @param[in] params Parameter set
+     *
+     * @return None
+     **/
+    template <typename T>
+    inline void PI_T<T>::set_params(const Params &params)
+    {
+        kP = params.kP;
+        kI = params.kI;
+
+        outMin = params.outMin;
+        outMax = params.outMax;
+    }
+
+    /**
+     * @brief Pick up the latest parameter set published to a block, call at tick start from the run() context
+     * @param[in] block Parameter block written by the tuning thread
+     *
+     * @return true if a new set was applied
+     **/
+    template <typename T>
+    inline bool PI_T<T>::update_params(zspinlab::math::type::ParamBlock<Params> &block)
+    {
+        Params params;
+
+        if (!block.fetch(params))
+        {
+            return false;
+        }
+
+        set_params(params);
+        return true;
+    }
+
     /**
      * @brief Run the PI controller
      * @param[in] sp    Desired setpoint
@@ -52,10 +127,13 @@ namespace zspinlab::math::modules
      *
      * @return Processed output sample
      **/
-    inline float PI::run(float sp, float pv, float ffwd)
+    template <typename T>
+    inline T PI_T<T>::run(T sp, T pv, T ffwd)
     {
-        float error;
-        float p_term, i_term, d_term;
+        ZSPINLAB_PROFILE_SCOPE(PI);
+
+        T error;
+        T p_term, i_term;
 
         error = sp - pv;
 
@@ -76,12 +154,13 @@ namespace zspinlab::math::modules
      *
      * @return None
      **/
-    inline float PI::reset_state(void)
+    template <typename T>
+    inline void PI_T<T>::reset_state(void)
     {
-        prev_i_term = 0;
-        prev_sp = 0;
-        prev_pv = 0;
-        prev_ffwd = 0;
+        prev_i_term = T();
+        prev_sp = T();
+        prev_pv = T();
+        prev_ffwd = T();
     }
 
-} // zspinlab::math::modules
\ No newline at end of file
+} // zspinlab::math::modules
@@ -1,48 +1,154 @@
 #pragma once
 
 #include <zephyr/sys/util.h>
-#include "math/math_core.hpp"
+#include "math/fixed/fixed.hpp"
+#include "math/filter/lowpass/fo/lpfo.hpp"
+#include "math/param/param_block.hpp"
 
 namespace zspinlab::math::modules {
 
-// Create a generic PID controller
-class PID {
+// Create a generic PID controller, T is the sample type (float, double or a zspinlab::math::type::Fixed type)
+template <typename T>
+class PID_T {
 public:
-    PID(float kP = 0.0f, float kI = 0.0f, float kD = 0.0f, float outMin = 0.0f, float outMax = 0.0f);
+    using coeff_t = typename LowPassFirstOrder_T<T>::coeff_t;
 
-    void set_lpf_parameter(float a1, float b0, float b1, float x1, float y1);
+    // Complete parameter set, published as a whole from a tuning thread through a ParamBlock
+    struct Params
+    {
+        T kP, kI, kD;
+        T outMin, outMax;
+    };
 
-    float run(float sp, float pv, float ffwd);
-    float reset_state(void);
+    PID_T(T kP = T(), T kI = T(), T kD = T(), T outMin = T(), T outMax = T());
 
-    float get_kp(void) { return kP; }
-    float get_ki(void) { return kI; }
-    float get_kd(void) { return kD; }
+    void set_lpf_parameter(coeff_t a1, coeff_t b0, coeff_t b1, T x1, T y1);
 
-    void set_kp(float kP) { this->kP = kP; }
-    void set_ki(float kI) { this->kI = kI; }
-    void set_kd(float kD) { this->kD = kD; }
+    // Set the derivative low pass filter from designed coefficients, e.g. from lowpass_first_order()
+    void set_lpf_parameter(const zspinlab::math::type::FirstOrderCoefficients<coeff_t> &coeffs)
+    {
+        filter.set_coefficients(coeffs);
+    }
 
-    float get_outMin(void) { return outMin; }
-    float get_outMax(void) { return outMax; }
+    T run(T sp, T pv, T ffwd);
+    void reset_state(void);
 
-    void set_outMin(float outMin) { this->outMin = outMin; }
-    void set_outMax(float outMax) { this->outMax = outMax; }
+    Params get_params(void) { return Params{kP, kI, kD, outMin, outMax}; }
+    void set_params(const Params &params);
+    bool update_params(zspinlab::math::type::ParamBlock<Params> &block);
+
+    T get_kp(void) { return kP; }
+    T get_ki(void) { return kI; }
+    T get_kd(void) { return kD; }
+
+    void set_kp(T kP) { this->kP = kP; }
+    void set_ki(T kI) { this->kI = kI; }
+    void set_kd(T kD) { this->kD = kD; }
+
+    T get_outMin(void) { return outMin; }
+    T get_outMax(void) { return outMax; }
+
+    void set_outMin(T outMin) { this->outMin = outMin; }
+    void set_outMax(T outMax) { this->outMax = outMax; }
 
 private:
     // Filter unit
-    LowPassFirstOrder filter{0.0f, 1.0f, 0.0f}; // Default to non-filtering mode
+    LowPassFirstOrder_T<T> filter{coeff_t(0), coeff_t(1), coeff_t(0)}; // Default to non-filtering mode
     
-    float kP, kI, kD;
-    float outMin, outMax;
+    T kP, kI, kD;
+    T outMin, outMax;
 
-    float prev_i_term;      // Previous integrator term
+    T prev_i_term;          // Previous integrator term
     
-    float prev_sp;          // Previous desired setpoint
-    float prev_pv;          // Previous measured process variable
-    float prev_ffwd;        // Previous feed-forward variable     
+    T prev_sp;              // Previous desired setpoint
+    T prev_pv;              // Previous measured process variable
+    T prev_ffwd;            // Previous feed-forward variable     
 };
 
+// Single precision PID controller
+using PID = PID_T<float>;
+// Q15 PID controller
+using PID_Q15 = PID_T<zspinlab::math::type::Q15>;
+// Q31 PID controller
+using PID_Q31 = PID_T<zspinlab::math::type::Q31>;
+
+/**
+ * @brief Initialize the PID controller general parameters
+ * @param[in] kP        Proportional gain
+ * @param[in] kI        Integral gain
+ * @param[in] kD        Derivative gain
+ * @param[in] outMin    Minimum controller output
+ * @param[in] outMax    Maximum controller output
+ **/
+template <typename T>
+inline PID_T<T>::PID_T(T kP, T kI, T kD, T outMin, T outMax)
+{
+    this->kP = kP;
+    this->kI = kI;
+    this->kD = kD;
+
+    this->outMin = outMin;
+    this->outMax = outMax;
+
+    reset_state();
+}
+
+/**
+ * @brief Initialize the low pass filter parameters for the PID controller
+ * @param[in] a1 The denominator filter coefficient value for z^(-1)
+ * @param[in] b0 The numerator filter coefficient value for z^0
+ * @param[in] b1 The numerator filter coefficient value for z^(-1)
+ * @param[in] x1 The input value at time sample n=-1
+ * @param[in] y1 The output value at time sample n=-1
+ *
+ * @return None
+ **/
+template <typename T>
+inline void PID_T<T>::set_lpf_parameter(coeff_t a1, coeff_t b0, coeff_t b1, T x1, T y1)
+{
+    filter.set_denominator_coefficient(a1);
+    filter.set_numerator_coefficient_b0(b0);
+    filter.set_numerator_coefficient_b1(b1);
+    filter.set_initial_condition(x1, y1);
+}
+
+/**
+ * @brief Set all the PID controller parameters at once
+ * @param[in] params Parameter set
+ *
+ * @return None
+ **/
+template <typename T>
+inline void PID_T<T>::set_params(const Params &params)
+{
+    kP = params.kP;
+    kI = params.kI;
+    kD = params.kD;
+
+    outMin = params.outMin;
+    outMax = params.outMax;
+}
+
+/**
+ * @brief Pick up the latest parameter set published to a block, call at tick start from the run() context
+ * @param[in] block Parameter block written by the tuning thread
+ *
+ * @return true if a new set was applied
+ **/
+template <typename T>
+inline bool PID_T<T>::update_params(zspinlab::math::type::ParamBlock<Params> &block)
+{
+    Params params;
+
+    if (!block.fetch(params))
+    {
+        return false;
+    }
+
+    set_params(params);
+    return true;
+}
+
 /**
  * @brief Run the PID controller
  * @param[in] sp    Desired setpoint
@@ -51,16 +157,17 @@ private:
  * 
  * @return Processed output sample
  **/
-inline float PID::run(float sp, float pv, float ffwd)
+template <typename T>
+inline T PID_T<T>::run(T sp, T pv, T ffwd)
 {
-    float error;
-    float p_term, i_term, d_term;
+    T error;
+    T p_term, i_term, d_term;
 
     error   = sp - pv;
 
     p_term  = kP*error;
-    i_term  = (kI == 0.0f ? 0.0f : CLAMP(prev_i_term + kI * error, outMin, outMax));     // Only bother when kI is used
-    d_term  = (kD == 0.0f ? 0.0f : filter.run(kD * error));     // Only bother when kD is used
+    i_term  = (kI == T() ? T() : CLAMP(prev_i_term + kI * error, outMin, outMax));     // Only bother when kI is used
+    d_term  = (kD == T() ? T() : filter.run(kD * error));     // Only bother when kD is used
 
     // Store previous state
     prev_i_term = i_term;
@@ -76,12 +183,13 @@ inline float PID::run(float sp, float pv, float ffwd)
  *
  * @return None
  **/
-inline float PID::reset_state(void)
+template <typename T>
+inline void PID_T<T>::reset_state(void)
 {
-    prev_i_term = 0;
-    prev_sp = 0;
-    prev_pv = 0;
-    prev_ffwd = 0;
+    prev_i_term = T();
+    prev_sp = T();
+    prev_pv = T();
+    prev_ffwd = T();
 }
 
-} // zspinlab::math::modules
\ No newline at end of file
+} // zspinlab::math::modules
@@ -0,0 +1,71 @@
+#include "quadrature_pll.hpp"
+
+namespace zspinlab::math::modules
+{
+    /**
+     * @brief Constructor, zero gains, angle and speed
+     * @param[in] ts Sample time [s]
+     **/
+    QuadraturePLL::QuadraturePLL(float ts)
+    {
+        this->ts = ts;
+    }
+
+    /**
+     * @brief Set the sample time, the loop filter gains are kept
+     * @param[in] ts Sample time [s]
+     *
+     * @note May be called before or after set_gains() / set_bandwidth().
+     *
+     * @return None
+     **/
+    void QuadraturePLL::set_sample_time(float ts)
+    {
+        this->ts = ts;
+        kI_ts = kI * ts;
+    }
+
+    /**
+     * @brief Set the loop filter gains
+     * @param[in] kP Proportional gain [1/s]
+     * @param[in] kI Integral gain [1/s^2]
+     *
+     * @return None
+     **/
+    void QuadraturePLL::set_gains(float kP, float kI)
+    {
+        this->kP = kP;
+        this->kI = kI;
+        kI_ts = kI * ts;
+    }
+
+    /**
+     * @brief Set the loop filter gains from the closed-loop natural frequency and damping
+     * @param[in] omega_n Natural frequency [rad/s]
+     * @param[in] zeta    Damping ratio
+     *
+     * @note The linearized loop is omega_n^2 / (s^2 + 2 zeta omega_n s + omega_n^2), so kP = 2 zeta omega_n and
+     * kI = omega_n^2.
+     *
+     * @return None
+     **/
+    void QuadraturePLL::set_bandwidth(float omega_n, float zeta)
+    {
+        set_gains(2.0f * zeta * omega_n, omega_n * omega_n);
+    }
+
+    /**
+     * @brief Restart the loop at a given angle and speed
+     * @param[in] angle_pu Angle (1.0 is one full electrical turn)
+     * @param[in] speed    Angular speed [rad/s]
+     *
+     * @return None
+     **/
+    void QuadraturePLL::reset_state(float angle_pu, float speed)
+    {
+        phasor.set_angle_pu(angle_pu);
+        this->speed = speed;
+        error = 0.0f;
+    }
+
+} // namespace zspinlab::math::modules
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "math/phasor/phasor.hpp"
+
+namespace zspinlab::math::modules
+{
+    /*
+     * Quadrature phase-locked loop, tracks the angle and the angular speed of a rotating vector.
+     *
+     * The phase detector is the cross product of the input vector with the estimated (cos, sin) phasor, sin(theta -
+     * theta_hat) for a unit input, so no atan2 is needed. A PI loop filter gives the angular speed, which rotates a
+     * PhasorOscillator by omega * Ts every call: the estimated angle is only ever held as its sine and cosine and the
+     * loop has no trig call and no branch.
+     *
+     * The input should have a unit amplitude, the loop gains are per radian of phase error.
+     */
+    class QuadraturePLL
+    {
+    public:
+        QuadraturePLL(float ts = 0.0f);
+
+        // Set the sample time [s]
+        void set_sample_time(float ts);
+        // Set the loop filter gains, kP in 1/s and kI in 1/s^2
+        void set_gains(float kP, float kI);
+        void set_bandwidth(float omega_n, float zeta = 1.0f);
+
+        void reset_state(float angle_pu = 0.0f, float speed = 0.0f);
+
+        void run(float x_alpha, float x_beta);
+
+        // Get the sine value of the estimated angle, predicted for the next call
+        float get_sin(void) { return phasor.get_sin(); }
+        // Get the cosine value of the estimated angle, predicted for the next call
+        float get_cos(void) { return phasor.get_cos(); }
+        // Get the estimated angular speed [rad/s]
+        float get_speed(void) { return speed; }
+        // Get the last phase error, sin(theta - theta_hat) for a unit input
+        float get_error(void) { return error; }
+
+    private:
+        PhasorOscillator phasor{0.0f, 1U};
+
+        float ts;
+        float kP = 0.0f;
+        float kI = 0.0f;
+        float kI_ts = 0.0f;     // Integral gain times the sample time, kept in step with kI and ts by both setters
+
+        float speed = 0.0f;     // Loop filter integrator, the angular speed without the proportional term
+        float error = 0.0f;
+    };
+
+    /**
+     * @brief Track the angle of the input vector one sample further
+     * @param[in] x_alpha Input vector alpha component, unit amplitude
+     * @param[in] x_beta  Input vector beta component, unit amplitude
+     *
+     * @return None
+     **/
+    inline void QuadraturePLL::run(float x_alpha, float x_beta)
+    {
+        error = x_beta * phasor.get_cos() - x_alpha * phasor.get_sin();
+        speed += kI_ts * error;
+
+        // Rotate by the loop filter output over one sample. The small angle expansion error (~2e-4 relative at 0.4 rad
+        // per call) only biases the speed estimate slightly, the loop keeps the angle locked
+        phasor.set_delta_rad_small((speed + kP * error) * ts);
+        phasor.run();
+    }
+
+} // namespace zspinlab::math::modules
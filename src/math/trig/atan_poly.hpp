@@ -0,0 +1,56 @@
+#pragma once
+
+#include <limits>
+
+#include "math/math_const.hpp"
+
+namespace zspinlab::math::basic
+{
+    // Degree of the minimax polynomial used by the polynomial atan2
+    enum class AtanPrecision
+    {
+        FAST,       // Odd degree 7, |error| < 8.2e-5 rad (0.005 deg)
+        ACCURATE,   // Odd degree 11, |error| < 1.7e-6 rad, close to the float resolution of the angle
+    };
+
+    /**
+     * @brief Four-quadrant arctangent, minimax polynomial on one octant
+     * @param[in] y         Input vector coordinate y
+     * @param[in] x         Input vector coordinate x
+     * @param[in] precision Polynomial degree. This is statically defined
+     *
+     * @note The octant is folded with compares and selects, so the cost is one divide and the polynomial whatever the
+     * angle. atan2(0, 0) is 0.
+     *
+     * @return Angle of the vector (x, y) in [-pi, pi]
+     **/
+    template <AtanPrecision precision = AtanPrecision::FAST>
+    inline float atan2_poly(float y, float x)
+    {
+        const float ax = (x < 0.0f) ? -x : x;
+        const float ay = (y < 0.0f) ? -y : y;
+        const bool steep = ay > ax;
+
+        // Ratio in [0, 1], the smallest normal float keeps the null vector away from 0 / 0
+        const float z = (steep ? ax : ay) / ((steep ? ay : ax) + std::numeric_limits<float>::min());
+        const float z2 = z * z;
+        float a;
+
+        if constexpr (precision == AtanPrecision::ACCURATE)
+        {
+            a = z * (0.9999772191f +
+                     z2 * (-0.3326228279f +
+                           z2 * (0.1935403761f + z2 * (-0.1164264820f + z2 * (0.05264735147f + z2 * -0.01171913573f)))));
+        }
+        else
+        {
+            a = z * (0.9992138126f + z2 * (-0.3211749693f + z2 * (0.1462644636f + z2 * -0.03898651416f)));
+        }
+
+        a = steep ? MATH_PI_BY_2 - a : a;
+        a = (x < 0.0f) ? MATH_PI - a : a;
+
+        return (y < 0.0f) ? -a : a;
+    }
+
+} // namespace zspinlab::math::basic
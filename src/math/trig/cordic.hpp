@@ -0,0 +1,340 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <math.h>
+#include <type_traits>
+
+#include "math/math_const.hpp"
+#include "math/fixed/fixed.hpp"
+
+namespace zspinlab::math::basic
+{
+    namespace detail
+    {
+        // Compile-time square root for x > 0, Newton iterations evaluated in double
+        constexpr double constexpr_sqrt(double x)
+        {
+            double r = (x > 1.0) ? x : 1.0;
+
+            for (int n = 0; n < 64; n++)
+            {
+                r = 0.5 * (r + x / r);
+            }
+
+            return r;
+        }
+
+        // Compile-time arctangent of 2^-i, Taylor series evaluated in double (x <= 1/2 for i > 0)
+        constexpr double constexpr_atan_pow2(size_t i)
+        {
+            if (i == 0)
+            {
+                return 0.78539816339744831;
+            }
+
+            const double x = 1.0 / static_cast<double>(uint64_t(1) << i);
+            double term = x;
+            double sum = x;
+
+            for (int n = 1; n < 32; n++)
+            {
+                term *= -x * x;
+                sum += term / (2.0 * n + 1.0);
+            }
+
+            return sum;
+        }
+
+        // Generate the CORDIC micro-rotation angles atan(2^-i) for i = 0...N - 1, in radian
+        template <size_t N>
+        constexpr std::array<double, N> make_cordic_angle_table(void)
+        {
+            std::array<double, N> table{};
+
+            for (size_t i = 0; i < N; i++)
+            {
+                table[i] = constexpr_atan_pow2(i);
+            }
+
+            return table;
+        }
+
+        // CORDIC gain compensation after N micro-rotations, prod 1 / sqrt(1 + 2^-2i)
+        constexpr double cordic_gain_inverse(size_t n)
+        {
+            double k = 1.0;
+
+            for (size_t i = 0; i < n; i++)
+            {
+                k /= constexpr_sqrt(1.0 + 1.0 / static_cast<double>(uint64_t(1) << (2 * i)));
+            }
+
+            return k;
+        }
+    } // namespace detail
+
+    /**
+     * @brief CORDIC engine, vector to polar conversion and sine/cosine by micro-rotations
+     *
+     * Vectoring mode rotates the input vector onto the x axis in Iterations micro-rotations of atan(2^-i), which yields its
+     * angle and (gain compensated) magnitude. A unit vector is rotated the other way alongside, so the sine and cosine of
+     * the input angle come out of the same pass, without a divide. Rotation mode computes the sine and cosine of an angle.
+     * Every iteration adds about one bit of angle accuracy, up to the precision of T.
+     *
+     * T is float (angles in radian, in [-pi, pi]) or zspinlab::math::type::Q31 (angles in half-turns, 1.0 is pi, wrapping
+     * around over the full 32-bit range like the angle itself). The Q31 form is meant for cores without FPU: integer adds
+     * and shifts only, plus one multiply for the magnitude. With an FPU a float CORDIC runs a multiply-add per coordinate
+     * and iteration, so basic::fatan2f() and fsqrtf() are usually faster; the float form remains the reference for the
+     * Q31 one and gives the three results at once.
+     *
+     * Max error over vectors of magnitude 0.05 to 1, measured by host/analysis/cordic_benchmark.cpp:
+     *
+     *                      angle [rad]    magnitude (relative)   sine/cosine
+     *  float, 12 iter.     4.9e-04        5.0e-07                4.9e-04
+     *  float, 16 iter.     3.1e-05        4.8e-07                3.1e-05
+     *  float, 24 iter.     7.3e-07        4.8e-07                5.0e-07
+     *  Q31, 16 iter.       3.1e-05        2.0e-07                3.1e-05
+     *  Q31, 30 iter.       2.9e-07        4.4e-07                2.1e-07
+     *
+     * @tparam T          Coordinate type, float or zspinlab::math::type::Q31
+     * @tparam Iterations Number of micro-rotations
+     */
+    template <typename T = float, size_t Iterations = 16>
+    class Cordic_T
+    {
+        static_assert(std::is_same_v<T, float> || std::is_same_v<T, zspinlab::math::type::Q31>,
+                      "CORDIC is only implemented for float and Q31");
+        static_assert(Iterations > 0 && Iterations <= (std::is_same_v<T, float> ? 24 : 30),
+                      "Iterations beyond the precision of T do not improve the result");
+
+    public:
+        // Vector in polar form, with the sine and cosine of its angle
+        struct Polar
+        {
+            T magnitude;
+            T angle;
+            T sin;
+            T cos;
+        };
+
+        static Polar polar(T x, T y);
+        static void sincos(T angle, T &sin_out, T &cos_out);
+
+        // Compute the angle of the vector (x, y), zero for the null vector
+        static T atan2(T y, T x) { return polar(x, y).angle; }
+        // Compute the magnitude of the vector (x, y)
+        static T magnitude(T x, T y) { return polar(x, y).magnitude; }
+
+        // Micro-rotation angles, atan(2^-i) in radian
+        static constexpr std::array<double, Iterations> angle_table = detail::make_cordic_angle_table<Iterations>();
+        // Gain compensation, 1 / prod sqrt(1 + 2^-2i)
+        static constexpr double gain_inverse = detail::cordic_gain_inverse(Iterations);
+
+    private:
+        // Micro-rotation angles, Q31 half-turns stored as unsigned to wrap around
+        static constexpr std::array<uint32_t, Iterations> make_raw_angle_table(void)
+        {
+            std::array<uint32_t, Iterations> table{};
+
+            for (size_t i = 0; i < Iterations; i++)
+            {
+                table[i] = static_cast<uint32_t>(angle_table[i] / 3.14159265358979323846 * 2147483648.0 + 0.5);
+            }
+
+            return table;
+        }
+
+        // Micro-rotation angles in radian and step sizes 2^-i, single precision
+        static constexpr std::array<float, Iterations> make_float_table(bool steps)
+        {
+            std::array<float, Iterations> table{};
+
+            for (size_t i = 0; i < Iterations; i++)
+            {
+                table[i] = static_cast<float>(steps ? 1.0 / static_cast<double>(uint64_t(1) << i) : angle_table[i]);
+            }
+
+            return table;
+        }
+
+        // Two's complement negation of v where mask is all ones, v where it is zero
+        static constexpr int32_t negate_if(int32_t v, int32_t mask) { return (v ^ mask) - mask; }
+
+        static constexpr std::array<uint32_t, Iterations> raw_angle_table = make_raw_angle_table();
+        static constexpr std::array<float, Iterations> float_angle_table = make_float_table(false);
+        static constexpr std::array<float, Iterations> step_table = make_float_table(true);
+
+        // Gain compensation in Q30, the Q31 form keeps one integer bit of headroom for the rotated unit vector
+        static constexpr int32_t gain_inverse_q30 = static_cast<int32_t>(gain_inverse * 1073741824.0 + 0.5);
+    };
+
+    // Single precision CORDIC, 16 iterations (~3e-5 rad)
+    using Cordic = Cordic_T<float, 16>;
+    // Q31 CORDIC, 16 iterations (~3e-5 rad)
+    using Cordic_Q31 = Cordic_T<zspinlab::math::type::Q31, 16>;
+
+    /**
+     * @brief Convert a vector to polar form in one vectoring pass
+     * @param[in] x Input vector coordinate x. Q31 inputs use the full [-1, 1) range
+     * @param[in] y Input vector coordinate y
+     *
+     * @note The Q31 magnitude saturates just below 1.0, e.g. for (-1, -1).
+     *
+     * @return Magnitude, angle in [-pi, pi] within the resolution (float) or in half-turns (Q31), and its sine and cosine.
+     *         The null vector gives a zero magnitude and angle, with a sine of zero and a cosine of one
+     **/
+    template <typename T, size_t Iterations>
+    inline typename Cordic_T<T, Iterations>::Polar Cordic_T<T, Iterations>::polar(T x, T y)
+    {
+        if constexpr (std::is_same_v<T, float>)
+        {
+            if ((x == 0.0f) && (y == 0.0f))
+            {
+                return {0.0f, 0.0f, 0.0f, 1.0f};
+            }
+
+            // Left half plane: rotate by pi first, the micro-rotations only converge over +-1.74 rad
+            const bool flip = x < 0.0f;
+            const float k = static_cast<float>(gain_inverse);
+
+            float z = flip ? ((y < 0.0f) ? -MATH_PI : MATH_PI) : 0.0f;
+            x = flip ? -x : x;
+            y = flip ? -y : y;
+
+            // Unit vector at angle z, pre-scaled by the gain compensation
+            float u = flip ? -k : k;
+            float v = 0.0f;
+
+            for (size_t i = 0; i < Iterations; i++)
+            {
+                // Rotate (x, y) toward the x axis and (u, v) the other way, the direction is the sign bit of y
+                const float d = copysignf(step_table[i], y);
+                const float x_next = x + y * d;
+                const float u_next = u - v * d;
+
+                z += copysignf(float_angle_table[i], y);
+                y -= x * d;
+                v += u * d;
+                x = x_next;
+                u = u_next;
+            }
+
+            return {x * k, z, v, u};
+        }
+        else
+        {
+            using Q31 = zspinlab::math::type::Q31;
+
+            if ((x.raw() == 0) && (y.raw() == 0))
+            {
+                return {Q31(), Q31(), Q31(), Q31::max()};
+            }
+
+            // Two bits of headroom for the CORDIC gain (up to sqrt(2) * 1.65) in the vectoring registers
+            const bool flip = x.raw() < 0;
+            int32_t xr = x.raw() >> 2;
+            int32_t yr = y.raw() >> 2;
+
+            xr = flip ? -xr : xr;
+            yr = flip ? -yr : yr;
+
+            // +-pi is the same Q31 half-turn angle
+            uint32_t z = flip ? 0x80000000UL : 0UL;
+            int32_t u = flip ? -gain_inverse_q30 : gain_inverse_q30;
+            int32_t v = 0;
+
+            for (size_t i = 0; i < Iterations; i++)
+            {
+                // All ones below the x axis, the micro-rotation direction without a branch
+                const int32_t below = yr >> 31;
+                const int32_t dx = negate_if(yr >> i, below);
+                const int32_t dy = negate_if(xr >> i, below);
+                const int32_t du = negate_if(v >> i, below);
+                const int32_t dv = negate_if(u >> i, below);
+
+                z += static_cast<uint32_t>(negate_if(static_cast<int32_t>(raw_angle_table[i]), below));
+                xr += dx;
+                yr -= dy;
+                u -= du;
+                v += dv;
+            }
+
+            // Q29 magnitude times the Q30 gain compensation, back to Q31
+            const int64_t magnitude = (int64_t(xr) * gain_inverse_q30 + (int64_t(1) << 27)) >> 28;
+
+            return {Q31::from_raw(Q31::saturate(magnitude)),
+                    Q31::from_raw(static_cast<int32_t>(z)),
+                    Q31::from_raw(Q31::saturate(int64_t(v) * 2)),
+                    Q31::from_raw(Q31::saturate(int64_t(u) * 2))};
+        }
+    }
+
+    /**
+     * @brief Compute sine and cosine of an angle in rotation mode
+     * @param[in] angle    Input angle, in [-pi, pi] (float) or in half-turns, any value (Q31)
+     * @param[out] sin_out Output sine value
+     * @param[out] cos_out Output cosine value
+     *
+     * @return None
+     **/
+    template <typename T, size_t Iterations>
+    inline void Cordic_T<T, Iterations>::sincos(T angle, T &sin_out, T &cos_out)
+    {
+        if constexpr (std::is_same_v<T, float>)
+        {
+            // Fold the angle to [-pi/2, pi/2], negating the result
+            const bool flip = (angle > MATH_PI_BY_2) || (angle < -MATH_PI_BY_2);
+            float z = flip ? ((angle > 0.0f) ? angle - MATH_PI : angle + MATH_PI) : angle;
+            float x = static_cast<float>(gain_inverse);
+            float y = 0.0f;
+
+            for (size_t i = 0; i < Iterations; i++)
+            {
+                // The direction is the sign bit of the residual angle
+                const float d = copysignf(step_table[i], z);
+                const float x_next = x - y * d;
+
+                y += x * d;
+                x = x_next;
+                z -= copysignf(float_angle_table[i], z);
+            }
+
+            sin_out = flip ? -y : y;
+            cos_out = flip ? -x : x;
+        }
+        else
+        {
+            using Q31 = zspinlab::math::type::Q31;
+
+            // Fold the angle to [-pi/2, pi/2] by adding pi (wrapping), negating the result
+            int32_t z = angle.raw();
+            const bool flip = (z > 0x40000000L) || (z < -0x40000000L);
+            z = flip ? static_cast<int32_t>(static_cast<uint32_t>(z) + 0x80000000UL) : z;
+
+            int32_t x = gain_inverse_q30;
+            int32_t y = 0;
+
+            for (size_t i = 0; i < Iterations; i++)
+            {
+                // All ones for a negative residual angle
+                const int32_t negative = z >> 31;
+                const int32_t dx = negate_if(y >> i, negative);
+                const int32_t dy = negate_if(x >> i, negative);
+
+                z -= negate_if(static_cast<int32_t>(raw_angle_table[i]), negative);
+                x -= dx;
+                y += dy;
+            }
+
+            // Q30 to Q31, the negation saturates like -Q31
+            const Q31 s = Q31::from_raw(Q31::saturate(int64_t(y) * 2));
+            const Q31 c = Q31::from_raw(Q31::saturate(int64_t(x) * 2));
+
+            sin_out = flip ? -s : s;
+            cos_out = flip ? -c : c;
+        }
+    }
+
+} // namespace zspinlab::math::basic
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "math/math_const.hpp"
+
+namespace zspinlab::math::basic
+{
+    // Interpolation used between two table entries of the sine/cosine lookup table
+    enum class SinCosPrecision
+    {
+        LINEAR,     // 2-point linear interpolation, |error| ~ (pi/2/N)^2 / 8
+        QUADRATIC,  // 3-point Newton interpolation, |error| ~ (pi/2/N)^3 / 15
+    };
+
+    namespace detail
+    {
+        // Compile-time sine for x in [0, pi/2 + small], Taylor series evaluated in double
+        constexpr double constexpr_sin(double x)
+        {
+            double term = x;
+            double sum = x;
+
+            for (int n = 1; n < 16; n++)
+            {
+                term *= -x * x / ((2.0 * n) * (2.0 * n + 1.0));
+                sum += term;
+            }
+
+            return sum;
+        }
+
+        // Generate sin() over one quarter wave, N + 1 points plus a guard entry for quadratic interpolation
+        template <size_t N>
+        constexpr std::array<float, N + 2> make_quarter_sine_table(void)
+        {
+            std::array<float, N + 2> table{};
+            constexpr double step = 1.5707963267948966 / N;
+
+            for (size_t i = 0; i < N + 2; i++)
+            {
+                table[i] = static_cast<float>(constexpr_sin(step * i));
+            }
+
+            return table;
+        }
+    } // namespace detail
+
+    /**
+     * @brief Quarter-wave sine/cosine lookup table, generated at compile time
+     *
+     * The table lives in flash (read-only data) and only holds sin() over [0, pi/2]. The remaining quadrants are
+     * obtained by symmetry, so a single lookup returns both sine and cosine.
+     *
+     * @tparam N            Number of table intervals per quarter wave, must be a power of two
+     * @tparam precision    Interpolation between table entries
+     */
+    template <size_t N = 256, SinCosPrecision precision = SinCosPrecision::LINEAR>
+    class SinCosTable
+    {
+        static_assert(N >= 4 && (N & (N - 1)) == 0, "Table size must be a power of two");
+
+    public:
+        static void sincos_pu(float turn, float &sin_out, float &cos_out);
+
+        /**
+         * @brief Compute sine and cosine from an angle in degree
+         * @param[in] angle_deg Input angle in degree
+         * @param[out] sin_out  Output sine value
+         * @param[out] cos_out  Output cosine value
+         *
+         * @return None
+         **/
+        static void sincos_deg(float angle_deg, float &sin_out, float &cos_out)
+        {
+            sincos_pu(angle_deg * (1.0f / 360.0f), sin_out, cos_out);
+        }
+
+        /**
+         * @brief Compute sine and cosine from an angle in radian
+         * @param[in] angle_rad Input angle in radian
+         * @param[out] sin_out  Output sine value
+         * @param[out] cos_out  Output cosine value
+         *
+         * @return None
+         **/
+        static void sincos_rad(float angle_rad, float &sin_out, float &cos_out)
+        {
+            sincos_pu(angle_rad * MATH_1_BY_2PI, sin_out, cos_out);
+        }
+
+        // The quarter-wave table, sin(i * pi / (2 * N)) for i = 0...N + 1
+        static constexpr std::array<float, N + 2> table = detail::make_quarter_sine_table<N>();
+
+    private:
+        static float interpolate(uint32_t index, float frac);
+    };
+
+    /**
+     * @brief Interpolate the quarter-wave sine at position (index + frac)
+     * @param[in] index Table index in [0, N - 1]
+     * @param[in] frac  Fractional position between two entries [0, 1]
+     *
+     * @return Interpolated sine value
+     **/
+    template <size_t N, SinCosPrecision precision>
+    inline float SinCosTable<N, precision>::interpolate(uint32_t index, float frac)
+    {
+        const float y0 = table[index];
+        const float y1 = table[index + 1];
+
+        if constexpr (precision == SinCosPrecision::QUADRATIC)
+        {
+            const float y2 = table[index + 2];
+
+            // Newton forward form: y0 + f * d1 + f * (f - 1) / 2 * d2
+            const float d1 = y1 - y0;
+            const float d2 = (y2 - y1) - d1;
+            return y0 + frac * (d1 + (frac - 1.0f) * 0.5f * d2);
+        }
+        else
+        {
+            return y0 + frac * (y1 - y0);
+        }
+    }
+
+    /**
+     * @brief Compute sine and cosine from a per-unit angle (1.0 is one full turn)
+     * @param[in] turn      Input angle in turn, any value (wrapped internally)
+     * @param[out] sin_out  Output sine value
+     * @param[out] cos_out  Output cosine value
+     *
+     * @return None
+     **/
+    template <size_t N, SinCosPrecision precision>
+    inline void SinCosTable<N, precision>::sincos_pu(float turn, float &sin_out, float &cos_out)
+    {
+        // Wrap to [0, 1]. Integer truncation is cheaper than floorf on most cores
+        float t = turn - static_cast<float>(static_cast<int32_t>(turn));
+        t += static_cast<float>(t < 0.0f);
+
+        const float pos = t * static_cast<float>(4 * N);
+        const uint32_t i = static_cast<uint32_t>(pos);
+        const float frac = pos - static_cast<float>(i);
+
+        // t == 1.0f rounds to 4 * N, which wraps back to zero
+        const uint32_t quadrant = (i / N) & 3U;
+        const uint32_t k = i & (N - 1);
+
+        // Rising (sin-like) and falling (cos-like) parts of the quarter wave
+        const float rise = interpolate(k, frac);
+        const float fall = interpolate(N - 1 - k, 1.0f - frac);
+
+        // Quadrant selection without branches, a random angle sequence would mispredict them
+        const float parts[2] = {rise, fall};
+        const uint32_t swap = quadrant & 1U;
+
+        sin_out = parts[swap] * (1.0f - static_cast<float>(quadrant & 2U));
+        cos_out = parts[swap ^ 1U] * (1.0f - static_cast<float>((quadrant + 1U) & 2U));
+    }
+
+} // namespace zspinlab::math::basic
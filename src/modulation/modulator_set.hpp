@@ -0,0 +1,233 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+#include "svpwm/svpwm_base.hpp"
+
+namespace zspinlab::modulation {
+
+/*
+ * Runtime selectable modulator, e.g. SVGen at low speed and ODTV-1N at high speed, without virtual dispatch.
+ *
+ * Only the active modulator lives in the storage (std::variant). The set keeps its own copy of the references, so that
+ * a PWM period costs a single dispatch: run() hands the references to the active modulator and runs it in one call,
+ * and the duty cycle getters that follow it in the same function dispatch on the same unchanged variant index, which
+ * the compiler threads into the branch of run(). The dispatch is an if-chain on the variant index, unrolled at compile
+ * time, which the branch predictor learns perfectly since the selection practically never changes; with a single
+ * member type it folds away completely. A selection request only takes effect at the start of the next run() call,
+ * i.e. on a PWM period boundary, so a period is never computed with a mix of two modulators. The references and the
+ * over-modulation flag are kept across the changeover.
+ *
+ * All the members must share the sample type and the duty cycle polarity, so that the changeover is seamless at the
+ * inverter: every modulator gives the same duties for the same reference in the linear range (0.5 at zero voltage).
+ * SVPWM_ARS drives the low side, it can only be combined with other low-side modulators.
+ */
+template <class... Modulators>
+class ModulatorSet
+{
+    static_assert(sizeof...(Modulators) > 0, "ModulatorSet needs at least one modulator");
+
+    using First = std::tuple_element_t<0, std::tuple<Modulators...>>;
+
+public:
+    // Sample type of the references and duty cycles
+    using sample_t = typename First::sample_t;
+
+    static_assert((std::is_same_v<typename Modulators::sample_t, sample_t> && ...),
+                  "All the modulators must use the same sample type");
+    static_assert((std::is_base_of_v<SVPWM_Base<Modulators, sample_t>, Modulators> && ...),
+                  "Modulators must derive from SVPWM_Base");
+
+    // Duty cycle convention of every member
+    static constexpr DutyPolarity duty_polarity = First::duty_polarity;
+
+    static_assert(((Modulators::duty_polarity == duty_polarity) && ...),
+                  "All the modulators must share the duty cycle polarity, a changeover would glitch the outputs");
+
+    // Number of selectable modulators
+    static constexpr size_t SIZE = sizeof...(Modulators);
+
+    // Constructor, the first modulator is active
+    ModulatorSet(void) : va(0), vb(0), overmodulation(Overmodulation::DISABLED), pending(0) {}
+
+    // Request a modulator by index, applied at the start of the next run()
+    void select(uint8_t index) { pending = (index < SIZE) ? index : pending; }
+
+    // Request a modulator by type, applied at the start of the next run()
+    template <class Modulator>
+    void select(void) { pending = index_of<Modulator>(); }
+
+    // Get the index of the running modulator
+    uint8_t get_active(void) { return static_cast<uint8_t>(state.index()); }
+
+    // Get the index of the modulator to run from the next period
+    uint8_t get_pending(void) { return pending; }
+
+    // Get the running modulator if it is of the given type, nullptr otherwise
+    template <class Modulator>
+    Modulator *get_if(void) { return std::get_if<Modulator>(&state); }
+
+    // Set the <alpha, beta> vectors, handed to the active modulator by the next run()
+    void set_vref_ab(sample_t v_a, sample_t v_b)
+    {
+        va = v_a;
+        vb = v_b;
+    }
+
+    // Set the <alpha, beta> vectors from a stationary frame value
+    void set_vref_ab(zspinlab::math::type::AlphaBeta_T<sample_t> v_ab) { set_vref_ab(v_ab.alpha, v_ab.beta); }
+
+    // Obtain the calculated phase duty cycle for A channel
+    sample_t get_phase_duty_a(void) { return dispatch([](auto &m) { return m.get_phase_duty_a(); }); }
+
+    // Obtain the calculated phase duty cycle for B channel
+    sample_t get_phase_duty_b(void) { return dispatch([](auto &m) { return m.get_phase_duty_b(); }); }
+
+    // Obtain the calculated phase duty cycle for C channel
+    sample_t get_phase_duty_c(void) { return dispatch([](auto &m) { return m.get_phase_duty_c(); }); }
+
+    // Allow/disallow over-modulation mode, kept across changeovers
+    void allow_overmodulation(bool overmodulate)
+    {
+        set_overmodulation(overmodulate ? Overmodulation::UNLIMITED : Overmodulation::DISABLED);
+    }
+
+    // Select how references beyond the linear range are handled, kept across changeovers
+    void set_overmodulation(Overmodulation overmodulation);
+
+    // Get how references beyond the linear range are handled
+    Overmodulation get_overmodulation(void) { return overmodulation; }
+
+    void init(void);
+    void run(void);
+
+private:
+    std::variant<Modulators...> state;
+
+    // References of the next period, owned by the set
+    sample_t va, vb;
+
+    // Setting owned by the set, applied to whichever modulator is active
+    Overmodulation overmodulation;
+
+    uint8_t pending;
+
+    template <class Modulator, size_t I = 0>
+    static constexpr uint8_t index_of(void)
+    {
+        static_assert(I < SIZE, "Modulator is not part of the set");
+
+        if constexpr (std::is_same_v<Modulator, std::variant_alternative_t<I, std::variant<Modulators...>>>) {
+            return I;
+        } else {
+            return index_of<Modulator, I + 1>();
+        }
+    }
+
+    // Call f on the active modulator, if-chain on the variant index
+    template <size_t I = 0, class F>
+    decltype(auto) dispatch(F &&f)
+    {
+        if constexpr (I + 1 < SIZE) {
+            if (state.index() == I) {
+                return f(*std::get_if<I>(&state));
+            }
+            return dispatch<I + 1>(std::forward<F>(f));
+        } else {
+            // Only emplace() changes the alternative and modulators do not throw, so the set is never valueless and
+            // the last alternative needs no check
+            if (state.index() != I) {
+                __builtin_unreachable();
+            }
+            return f(*std::get_if<I>(&state));
+        }
+    }
+
+    template <size_t I = 0>
+    void changeover(void);
+};
+
+/**
+ * @brief Select the over-modulation mode, for the running modulator and the ones selected later
+ * @param[in] overmodulation Over-modulation mode
+ *
+ * @return None
+ */
+template <class... Modulators>
+inline void ModulatorSet<Modulators...>::set_overmodulation(Overmodulation overmodulation)
+{
+    this->overmodulation = overmodulation;
+    dispatch([overmodulation](auto &m) { m.set_overmodulation(overmodulation); });
+}
+
+/**
+ * @brief Initialize the running modulator
+ *
+ * @return None
+ */
+template <class... Modulators>
+inline void ModulatorSet<Modulators...>::init(void)
+{
+    dispatch([this](auto &m) {
+        m.init();
+        m.set_overmodulation(overmodulation);
+    });
+}
+
+/**
+ * @brief Replace the running modulator by the pending one
+ *
+ * @return None
+ */
+template <class... Modulators>
+template <size_t I>
+inline void ModulatorSet<Modulators...>::changeover(void)
+{
+    if constexpr (I < SIZE) {
+        if (pending == I) {
+            auto &m = state.template emplace<I>();
+
+            m.init();
+            m.set_overmodulation(overmodulation);
+            return;
+        }
+        changeover<I + 1>();
+    }
+}
+
+/**
+ * @brief Run one PWM period: apply a pending changeover, then run the active modulator on the current references
+ *
+ * @return None
+ */
+template <class... Modulators>
+inline void ModulatorSet<Modulators...>::run(void)
+{
+    // Only place where the active modulator changes, so duties of one period always come from a single modulator
+    if (pending != state.index()) {
+        changeover();
+    }
+
+    // The one dispatch of the period
+    dispatch([this](auto &m) {
+        m.set_vref_ab(va, vb);
+        m.run();
+    });
+}
+
+// Check if a type is a ModulatorSet
+template <class M>
+struct is_modulator_set : std::false_type {};
+
+template <class... Modulators>
+struct is_modulator_set<ModulatorSet<Modulators...>> : std::true_type {};
+
+template <class M>
+inline constexpr bool is_modulator_set_v = is_modulator_set<M>::value;
+
+} // namespace zspinlab::modulation
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <cstdint>
+
+namespace zspinlab::modulation {
+
+// Meaning of the duty cycles of a modulator. All of them are 0.5 at zero voltage, with the same gain
+enum class DutyPolarity : uint8_t
+{
+    ACTIVE_HIGH = 0,    // Duty is the high-side on time ratio (default)
+    ACTIVE_LOW,         // Duty is the low-side on time ratio (SVPWM_ARS)
+};
+
+} // namespace zspinlab::modulation
@@ -0,0 +1,203 @@
+#pragma once
+
+#include <cstdint>
+#include "math/math_const.hpp"
+
+namespace zspinlab::modulation {
+
+// Handling of <alpha, beta> references beyond the linear range (the sqrt(3)/2 circle inscribed in the hexagon)
+enum class Overmodulation : uint8_t
+{
+    DISABLED = 0,           // Limit the reference to the inscribed circle, linear range only (default)
+    UNLIMITED,              // Pass the reference through, the modulators clamp the duty cycles
+    MIN_PHASE_ERROR,        // Clip the reference to the hexagon along its own direction
+    MIN_AMPLITUDE_ERROR,    // Move the reference to the closest point of the hexagon
+    REGION_I_II,            // Two-region overmodulation up to six-step, the output fundamental follows |vref|
+};
+
+// Output fundamental amplitude reached when the reference travels along the whole hexagon (end of region I)
+#define SVPWM_OVERMOD_REGION_I_END  0.9085450493f
+// Output fundamental amplitude of six-step operation, 3/pi (end of region II)
+#define SVPWM_OVERMOD_SIX_STEP      0.9549296586f
+
+// Number of points of the region I and region II tables
+constexpr uint8_t OVERMOD_LUT_SIZE = 33;
+
+/*
+ * Region I gain, applied to the reference before the minimum phase error hexagon clip, so that the fundamental of the
+ * clipped trajectory equals the reference amplitude. Indexed by |vref|^2, evenly spaced from 3/4 to
+ * SVPWM_OVERMOD_REGION_I_END^2. Computed offline by solving mean(min(r, hexagon(theta))) = |vref| for r.
+ */
+inline constexpr float OVERMOD_REGION_I_GAIN[OVERMOD_LUT_SIZE] = {
+    1.0000000f, 1.0001256f, 1.0003735f, 1.0007147f, 1.0011407f, 1.0016478f, 1.0022348f, 1.0029017f, 1.0036499f,
+    1.0044811f, 1.0053982f, 1.0064045f, 1.0075043f, 1.0087026f, 1.0100053f, 1.0114193f, 1.0129529f, 1.0146158f,
+    1.0164195f, 1.0183777f, 1.0205070f, 1.0228279f, 1.0253654f, 1.0281516f, 1.0312275f, 1.0346480f, 1.0384886f,
+    1.0428583f, 1.0479247f, 1.0539705f, 1.0615482f, 1.0720864f, 1.1006609f,
+};
+
+/*
+ * Region II hexagon edge width: the part of each edge that is still travelled, the rest of the period the output is
+ * held on the nearest vertex. 1 is the plain hexagon, 0 is six-step. Indexed by |vref|^2, evenly spaced from
+ * SVPWM_OVERMOD_REGION_I_END^2 to SVPWM_OVERMOD_SIX_STEP^2. Computed offline like the region I gain.
+ */
+inline constexpr float OVERMOD_REGION_II_WIDTH[OVERMOD_LUT_SIZE] = {
+    1.0000000f, 0.9816963f, 0.9632337f, 0.9446007f, 0.9257845f, 0.9067713f, 0.8875462f, 0.8680926f, 0.8483924f,
+    0.8284255f, 0.8081698f, 0.7876003f, 0.7666894f, 0.7454058f, 0.7237139f, 0.7015732f, 0.6789372f, 0.6557517f,
+    0.6319536f, 0.6074679f, 0.5822049f, 0.5560556f, 0.5288854f, 0.5005249f, 0.4707553f, 0.4392867f, 0.4057200f,
+    0.3694797f, 0.3296806f, 0.2848293f, 0.2320078f, 0.1636644f, 0.0000000f,
+};
+
+/**
+ * @brief Linear interpolation in an overmodulation table
+ * @param[in] table Table, OVERMOD_LUT_SIZE points
+ * @param[in] pos   Position in [0, 1], clamped
+ *
+ * @return Interpolated value
+ */
+template <typename T>
+inline T overmod_lut(const float (&table)[OVERMOD_LUT_SIZE], T pos)
+{
+    T x = pos * T(OVERMOD_LUT_SIZE - 1);
+    x = (x < T(0.0f)) ? T(0.0f) : x;
+
+    uint8_t i = static_cast<uint8_t>(x);
+    if (i >= OVERMOD_LUT_SIZE - 1) {
+        return T(table[OVERMOD_LUT_SIZE - 1]);
+    }
+
+    const T frac = x - T(i);
+    return T(table[i]) + (T(table[i + 1]) - T(table[i])) * frac;
+}
+
+/**
+ * @brief Find the hexagon edge facing a reference
+ * @param[in] va  Reference alpha component
+ * @param[in] vb  Reference beta component
+ * @param[out] h  Projection of the reference on the edge normal, the reference is inside the hexagon if h <= sqrt(3)/2
+ * @param[out] nx Edge unit normal, alpha component
+ * @param[out] ny Edge unit normal, beta component
+ *
+ * @return None
+ */
+template <typename T>
+inline void overmod_hexagon_edge(T va, T vb, T &h, T &nx, T &ny)
+{
+    // Projections on the normals at 30, 90 and 150 degrees, the largest magnitude selects the edge
+    const T d0 = T(MATH_SQRT_3_BY_2) * va + T(0.5f) * vb;
+    const T d2 = T(0.5f) * vb - T(MATH_SQRT_3_BY_2) * va;
+    const T a0 = (d0 < T(0.0f)) ? -d0 : d0;
+    const T a1 = (vb < T(0.0f)) ? -vb : vb;
+    const T a2 = (d2 < T(0.0f)) ? -d2 : d2;
+
+    if (a0 >= a1 && a0 >= a2) {
+        h = a0;
+        nx = (d0 < T(0.0f)) ? T(-MATH_SQRT_3_BY_2) : T(MATH_SQRT_3_BY_2);
+        ny = (d0 < T(0.0f)) ? T(-0.5f) : T(0.5f);
+    } else if (a1 >= a2) {
+        h = a1;
+        nx = T(0.0f);
+        ny = (vb < T(0.0f)) ? T(-1.0f) : T(1.0f);
+    } else {
+        h = a2;
+        nx = (d2 < T(0.0f)) ? T(MATH_SQRT_3_BY_2) : T(-MATH_SQRT_3_BY_2);
+        ny = (d2 < T(0.0f)) ? T(-0.5f) : T(0.5f);
+    }
+}
+
+/**
+ * @brief Limit a reference to the hexagon
+ * @param[in] mode     Overmodulation::MIN_PHASE_ERROR or Overmodulation::MIN_AMPLITUDE_ERROR
+ * @param[in,out] va   Reference alpha component
+ * @param[in,out] vb   Reference beta component
+ *
+ * @note One divide for the minimum phase error mode, none for the minimum amplitude error mode, no sqrt.
+ *
+ * @return None
+ */
+template <typename T>
+inline void overmod_hexagon_limit(Overmodulation mode, T &va, T &vb)
+{
+    T h, nx, ny;
+
+    overmod_hexagon_edge(va, vb, h, nx, ny);
+
+    if (h <= T(MATH_SQRT_3_BY_2)) {
+        return;
+    }
+
+    if (mode == Overmodulation::MIN_PHASE_ERROR) {
+        const T k = T(MATH_SQRT_3_BY_2) / h;
+
+        va = va * k;
+        vb = vb * k;
+    } else {
+        // Edge tangent, the edge spans [-1/2, 1/2] along it around its middle point sqrt(3)/2 * n
+        T s = ny * va - nx * vb;
+        s = (s > T(0.5f)) ? T(0.5f) : ((s < T(-0.5f)) ? T(-0.5f) : s);
+
+        va = T(MATH_SQRT_3_BY_2) * nx + s * ny;
+        vb = T(MATH_SQRT_3_BY_2) * ny - s * nx;
+    }
+}
+
+/**
+ * @brief Two-region overmodulation: the output trajectory fundamental matches the reference amplitude up to six-step
+ * @param[in,out] va   Reference alpha component
+ * @param[in,out] vb   Reference beta component
+ *
+ * @note Region I (|vref| up to SVPWM_OVERMOD_REGION_I_END): the reference is enlarged and clipped to the hexagon along
+ * its direction, the time spent on the edges makes up for the lost amplitude. Region II (up to six-step): the output
+ * travels a shrinking middle part of each edge and is held on the nearest vertex otherwise. The amplitude is only
+ * used squared and the tables are indexed by |vref|^2, so at most one divide and no sqrt is needed.
+ *
+ * @return None
+ */
+template <typename T>
+inline void overmod_region_i_ii(T &va, T &vb)
+{
+    constexpr T m2_linear = T(0.75f);
+    constexpr T m2_region_i = T(SVPWM_OVERMOD_REGION_I_END * SVPWM_OVERMOD_REGION_I_END);
+    constexpr T m2_six_step = T(SVPWM_OVERMOD_SIX_STEP * SVPWM_OVERMOD_SIX_STEP);
+
+    const T m2 = va * va + vb * vb;
+    T h, nx, ny;
+
+    if (m2 <= m2_linear) {
+        return;
+    }
+
+    overmod_hexagon_edge(va, vb, h, nx, ny);
+
+    if (m2 < m2_region_i) {
+        T k = overmod_lut(OVERMOD_REGION_I_GAIN, (m2 - m2_linear) * T(1.0f / (m2_region_i - m2_linear)));
+
+        h = h * k;
+        if (h > T(MATH_SQRT_3_BY_2)) {
+            k = k * T(MATH_SQRT_3_BY_2) / h;
+        }
+
+        va = va * k;
+        vb = vb * k;
+        return;
+    }
+
+    const T w = overmod_lut(OVERMOD_REGION_II_WIDTH, (m2 - m2_region_i) * T(1.0f / (m2_six_step - m2_region_i)));
+
+    // Position along the edge of the minimum phase error point, scaled by the travelled edge width
+    const T x = T(MATH_SQRT_3_BY_2) * (ny * va - nx * vb);
+    const T half = T(0.5f) * h * w;
+    T s;
+
+    if (x >= half) {
+        s = T(0.5f);
+    } else if (x <= -half) {
+        s = T(-0.5f);
+    } else {
+        s = x / (h * w);
+    }
+
+    va = T(MATH_SQRT_3_BY_2) * nx + s * ny;
+    vb = T(MATH_SQRT_3_BY_2) * ny - s * nx;
+}
+
+} // namespace zspinlab::modulation
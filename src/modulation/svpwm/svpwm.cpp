@@ -0,0 +1,53 @@
+#include "svpwm_ars.hpp"
+#include "svpwm_dpwm.hpp"
+#include "svpwm_odtv_1n.hpp"
+#include "svpwm_svgen.hpp"
+#include "svpwm_zspinner.hpp"
+
+#include <type_traits>
+
+namespace zspinlab::modulation
+{
+    // Explicit instantiation of every supported sample type, so that each of them is built with the library
+    template class SVPWM_ARS_T<float>;
+    template class SVPWM_ARS_T<double>;
+    template class SVPWM_ARS_T<zspinlab::math::type::Q15>;
+    template class SVPWM_ARS_T<zspinlab::math::type::Q31>;
+    template class SVPWM_ARS_T<float, true>;
+    template class SVPWM_ARS_T<double, true>;
+    template class SVPWM_ARS_T<zspinlab::math::type::Q15, true>;
+    template class SVPWM_ARS_T<zspinlab::math::type::Q31, true>;
+
+    template class SVPWM_SVGen_T<float>;
+    template class SVPWM_SVGen_T<double>;
+    template class SVPWM_SVGen_T<zspinlab::math::type::Q15>;
+    template class SVPWM_SVGen_T<zspinlab::math::type::Q31>;
+
+    template class SVPWM_ODTV_1N_T<float>;
+    template class SVPWM_ODTV_1N_T<double>;
+
+    template class SVPWM_ZSpinner_T<float>;
+    template class SVPWM_ZSpinner_T<double>;
+    template class SVPWM_ZSpinner_T<float, true>;
+    template class SVPWM_ZSpinner_T<double, true>;
+
+    template class SVPWM_DPWM_T<DpwmPattern::DPWM0, float>;
+    template class SVPWM_DPWM_T<DpwmPattern::DPWM1, float>;
+    template class SVPWM_DPWM_T<DpwmPattern::DPWM2, float>;
+    template class SVPWM_DPWM_T<DpwmPattern::DPWM3, float>;
+    template class SVPWM_DPWM_T<DpwmPattern::DPWMMIN, float>;
+    template class SVPWM_DPWM_T<DpwmPattern::DPWMMAX, float>;
+    template class SVPWM_DPWM_T<DpwmPattern::CURRENT, float>;
+    template class SVPWM_DPWM_T<DpwmPattern::DPWM1, double>;
+    template class SVPWM_DPWM_T<DpwmPattern::DPWM1, zspinlab::math::type::Q15>;
+    template class SVPWM_DPWM_T<DpwmPattern::DPWM1, zspinlab::math::type::Q31>;
+    template class SVPWM_DPWM_T<DpwmPattern::CURRENT, zspinlab::math::type::Q31>;
+
+    // No vtable: the modulator state can be copied around (e.g. double buffered or switched) as plain data
+    static_assert(std::is_trivially_copyable_v<SVPWM_ARS> && std::is_trivially_copyable_v<SVPWM_ARS_Q31>);
+    static_assert(std::is_trivially_copyable_v<SVPWM_SVGen> && std::is_trivially_copyable_v<SVPWM_SVGen_Q31>);
+    static_assert(std::is_trivially_copyable_v<SVPWM_ODTV_1N> && std::is_trivially_copyable_v<SVPWM_ZSpinner>);
+    static_assert(std::is_trivially_copyable_v<SVPWM_ARS_Branchless> &&
+                  std::is_trivially_copyable_v<SVPWM_ZSpinner_Branchless>);
+
+} // namespace zspinlab::modulation
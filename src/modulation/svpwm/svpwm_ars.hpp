@@ -6,108 +6,269 @@
 namespace zspinlab::modulation {
 
 // This implement the classical Alternating Reverse Sequencing SVPWM algorithm - the de-facto industry stardard in FOC motor control  
-class SVPWM_ARS : public SVPWM_Base<SVPWM_ARS>
+// With Branchless set, the sector sequence is table driven: same instruction path for every angle, bit-identical duties
+template <typename T, bool Branchless = false>
+class SVPWM_ARS_T : public SVPWM_Base<SVPWM_ARS_T<T, Branchless>, T>
 {
+    using Base = SVPWM_Base<SVPWM_ARS_T<T, Branchless>, T>;
+    using Base::va;
+    using Base::vb;
+    using Base::dA;
+    using Base::dB;
+    using Base::dC;
+    using Base::limit_vref_ab;
+    using Base::clamp_duty_branchless;
+
 public:
     
     // Constructor
-    using SVPWM_Base::SVPWM_Base;
+    using Base::Base;
+
+    // The duty cycles are the low-side on time ratios
+    static constexpr DutyPolarity duty_polarity = DutyPolarity::ACTIVE_LOW;
 
     void init(void) {}
     void run(void);
+
+private:
+    void sequence(T u);
+    void sequence_branchless(T u);
+
+    static T two_by_sqrt_3(T v, T v_by_sqrt_3);
+    static T half_zero_time(T tx, T ty);
 };
 
+// Single precision ARS modulator
+using SVPWM_ARS = SVPWM_ARS_T<float>;
+// Q15 ARS modulator
+using SVPWM_ARS_Q15 = SVPWM_ARS_T<zspinlab::math::type::Q15>;
+// Q31 ARS modulator
+using SVPWM_ARS_Q31 = SVPWM_ARS_T<zspinlab::math::type::Q31>;
+
+// Single precision branchless ARS modulator
+using SVPWM_ARS_Branchless = SVPWM_ARS_T<float, true>;
+// Q15 branchless ARS modulator
+using SVPWM_ARS_Branchless_Q15 = SVPWM_ARS_T<zspinlab::math::type::Q15, true>;
+// Q31 branchless ARS modulator
+using SVPWM_ARS_Branchless_Q31 = SVPWM_ARS_T<zspinlab::math::type::Q31, true>;
+
+/**
+ * @brief Compute 2/sqrt(3) * v
+ * @param[in] v             Input value
+ * @param[in] v_by_sqrt_3   Input value already scaled by 1/sqrt(3)
+ *
+ * @note 2/sqrt(3) is out of the Q1.x range, fixed-point types add 1/sqrt(3) * v twice instead.
+ *
+ * @return 2/sqrt(3) * v
+ */
+template <typename T, bool Branchless>
+inline T SVPWM_ARS_T<T, Branchless>::two_by_sqrt_3(T v, T v_by_sqrt_3)
+{
+    if constexpr (zspinlab::math::type::is_fixed_v<T>) {
+        (void)v;
+        return v_by_sqrt_3 + v_by_sqrt_3;
+    } else {
+        (void)v_by_sqrt_3;
+        return T(MATH_2_BY_SQRT_3) * v;
+    }
+}
+
+/**
+ * @brief Compute the half zero-vector time (1 - tx - ty) / 2
+ * @param[in] tx First active vector time
+ * @param[in] ty Second active vector time
+ *
+ * @note Fixed-point types work on halved terms so that 1.0 never has to be represented.
+ *
+ * @return Half zero-vector time
+ */
+template <typename T, bool Branchless>
+inline T SVPWM_ARS_T<T, Branchless>::half_zero_time(T tx, T ty)
+{
+    if constexpr (zspinlab::math::type::is_fixed_v<T>) {
+        constexpr T k_half(0.5f);
+        return k_half - tx * k_half - ty * k_half;
+    } else {
+        return (T(1.0f) - tx - ty) * T(0.5f);
+    }
+}
+
 /**
  * @brief Run the classical Alternating Reverse Sequencing SVPWM algorithm, originally written for ODrive ESCs
  * 
  * @return None
  */
-inline void SVPWM_ARS::run(void)
+template <typename T, bool Branchless>
+inline void SVPWM_ARS_T<T, Branchless>::run(void)
 {
-	float t1, t2, t3, t4, t5, t6;
-    
-    uint8_t sector;
+	ZSPINLAB_PROFILE_SCOPE(SVPWM_ARS);
+
+	T u;
 
     // Limit alpha and beta if required
     limit_vref_ab();
 
+    u = T(MATH_1_BY_SQRT_3) * vb;
+
+    if constexpr (Branchless) {
+        sequence_branchless(u);
+
+        // Clamp
+        dA = clamp_duty_branchless(dA);
+        dB = clamp_duty_branchless(dB);
+        dC = clamp_duty_branchless(dC);
+    } else {
+        sequence(u);
+
+        // Clamp
+        dA = CLAMP(dA, T(0.0f), T(1.0f));
+        dB = CLAMP(dB, T(0.0f), T(1.0f));
+        dC = CLAMP(dC, T(0.0f), T(1.0f));
+    }
+
+    ZSPINLAB_TELEMETRY_PROBE(SVPWM, va, vb, dA, dB, dC);
+}
+
+/**
+ * @brief Compute the unclamped duty cycles, sector search and six-way switch
+ * @param[in] u Beta voltage scaled by 1/sqrt(3)
+ *
+ * @return None
+ */
+template <typename T, bool Branchless>
+inline void SVPWM_ARS_T<T, Branchless>::sequence(T u)
+{
+	T t1, t2, t3, t4, t5, t6;
+    
+    uint8_t sector;
+
 	// Get sector
-	if (vb >= 0.0f) {
-        sector = (va >= 0.0f)  
-                    ? (MATH_1_BY_SQRT_3 * vb > va) ? 2U : 1U
-                    : (-MATH_1_BY_SQRT_3 * vb > va) ? 3U : 2U;
+	if (vb >= T(0.0f)) {
+        sector = (va >= T(0.0f))  
+                    ? (u > va) ? 2U : 1U
+                    : (-u > va) ? 3U : 2U;
 	} else {
-        sector = (va >= 0.0f)
-                    ? (-MATH_1_BY_SQRT_3 * vb > va) ? 5U : 6U
-                    : (MATH_1_BY_SQRT_3 * vb > va) ? 4U : 5U;
+        sector = (va >= T(0.0f))
+                    ? (-u > va) ? 5U : 6U
+                    : (u > va) ? 4U : 5U;
 	}
 
 	switch (sector) {
         case 1:
-            t1 = va - MATH_1_BY_SQRT_3 * vb;
-            t2 = MATH_2_BY_SQRT_3 * vb;
+            t1 = va - u;
+            t2 = two_by_sqrt_3(vb, u);
 
-            dA = (1.0f - t1 - t2) * 0.5f;
+            dA = half_zero_time(t1, t2);
             dB = dA + t1;
             dC = dB + t2;
 
 			break;
 
         case 2: 
-            t2 = va + MATH_1_BY_SQRT_3 * vb;
-            t3 = -va + MATH_1_BY_SQRT_3 * vb;
+            t2 = va + u;
+            t3 = -va + u;
 
-            dB = (1.0f - t2 - t3) * 0.5f;
+            dB = half_zero_time(t2, t3);
             dA = dB + t3;
             dC = dA + t2;
 
 			break;
 
         case 3:
-            t3 = MATH_2_BY_SQRT_3 * vb;
-            t4 = -va - MATH_1_BY_SQRT_3 * vb;
+            t3 = two_by_sqrt_3(vb, u);
+            t4 = -va - u;
 
-            dB = (1.0f - t3 - t4) * 0.5f;
+            dB = half_zero_time(t3, t4);
             dC = dB + t3;
             dA = dC + t4;
 
 			break;
 
         case 4:
-            t4 = -va + MATH_1_BY_SQRT_3 * vb;
-            t5 = -MATH_2_BY_SQRT_3 * vb;
+            t4 = -va + u;
+            t5 = -two_by_sqrt_3(vb, u);
 
-            dC = (1.0f - t4 - t5) * 0.5f;
+            dC = half_zero_time(t4, t5);
             dB = dC + t5;
             dA = dB + t4;
 
 			break;
 
         case 5: 
-            t5 = -va - MATH_1_BY_SQRT_3 * vb;
-            t6 = va - MATH_1_BY_SQRT_3 * vb;
+            t5 = -va - u;
+            t6 = va - u;
 
-            dC = (1.0f - t5 - t6) * 0.5f;
+            dC = half_zero_time(t5, t6);
             dA = dC + t5;
             dB = dA + t6;
 
 			break;
 
         case 6:
-            t6 = -MATH_2_BY_SQRT_3 * vb;
-            t1 = va + MATH_1_BY_SQRT_3 * vb;
+            t6 = -two_by_sqrt_3(vb, u);
+            t1 = va + u;
 
-            dA = (1.0f - t6 - t1) * 0.5f;
+            dA = half_zero_time(t6, t1);
             dC = dA + t1;
             dB = dC + t6;
 
 			break;
 	}
-	
-    // Clamp
-	dA = CLAMP(dA, 0.0f, 1.0f);
-	dB = CLAMP(dB, 0.0f, 1.0f);
-	dC = CLAMP(dC, 0.0f, 1.0f);
 }
 
-} // namspace zspinlab::modulation::SpaceVectorPWM
\ No newline at end of file
+/**
+ * @brief Compute the unclamped duty cycles, same operations as sequence() without any data dependent branch
+ * @param[in] u Beta voltage scaled by 1/sqrt(3)
+ *
+ * The six active vector times are all computed, exactly as sequence() computes them. The sector comes from the same
+ * comparisons packed in a table index, and the per-sector choice of times and phase order is a table lookup, so the
+ * operations and their order (hence the rounding) match the switch case by case.
+ *
+ * @return None
+ */
+template <typename T, bool Branchless>
+inline void SVPWM_ARS_T<T, Branchless>::sequence_branchless(T u)
+{
+    // Sector for each (vb >= 0, va >= 0, u > va, -u > va) combination
+    static constexpr uint8_t SECTOR[16] = {
+        5, 5, 4, 4,     // vb < 0, va < 0
+        6, 5, 6, 5,     // vb < 0, va >= 0
+        2, 3, 2, 3,     // vb >= 0, va < 0
+        1, 1, 2, 2,     // vb >= 0, va >= 0
+    };
+
+    // Per sector (1...6): times of the half zero-vector time, added to the first and second step, and the phases in
+    // increasing duty order. Times: 0: va - u, 1: 2/sqrt(3) vb, 2: -va - u, 3: -va + u, 4: -2/sqrt(3) vb, 5: va + u
+    struct Step
+    {
+        uint8_t first, second;      // Half zero-vector time operands, in order
+        uint8_t add_mid, add_max;   // Times added to reach the middle and the highest duty
+        uint8_t min, mid, max;      // Phases (0: A, 1: B, 2: C)
+    };
+    static constexpr Step STEP[6] = {
+        {0, 1, 0, 1, 0, 1, 2},
+        {5, 3, 3, 5, 1, 0, 2},
+        {1, 2, 1, 2, 1, 2, 0},
+        {3, 4, 4, 3, 2, 1, 0},
+        {2, 0, 2, 0, 2, 0, 1},
+        {4, 5, 5, 4, 0, 2, 1},
+    };
+
+    const T w = two_by_sqrt_3(vb, u);
+    const T t[6] = {va - u, w, -va - u, -va + u, -w, va + u};
+    T d[3];
+
+    const uint8_t index = (uint8_t(vb >= T(0.0f)) << 3) | (uint8_t(va >= T(0.0f)) << 2) | (uint8_t(u > va) << 1) |
+                          uint8_t(-u > va);
+    const Step &step = STEP[SECTOR[index] - 1];
+
+    d[step.min] = half_zero_time(t[step.first], t[step.second]);
+    d[step.mid] = d[step.min] + t[step.add_mid];
+    d[step.max] = d[step.mid] + t[step.add_max];
+
+    dA = d[0];
+    dB = d[1];
+    dC = d[2];
+}
+
+} // namespace zspinlab::modulation::SpaceVectorPWM
@@ -1,52 +1,88 @@
 #pragma once
 
+#include <algorithm>
+#include <cmath>
 #include <cstdint>
-#include "../../math_const.hpp"
-#include "../../math_core.hpp"
+#include <cstring>
+#include <type_traits>
+#include "math/math_const.hpp"
+#include "math/math_core.hpp"
+#include "duty_polarity.hpp"
+#include "overmodulation.hpp"
+#include "profiling/profiler.hpp"
+#include "telemetry/telemetry.hpp"
 
 namespace zspinlab::modulation {
 
-template <class Derived>
+// T is the sample type: float by default, double for host simulation or a zspinlab::math::type::Fixed type on cores without FPU
+template <class Derived, typename T = float>
 class SVPWM_Base
 {
 public:
-    // Constructor, do not allow over-modulation by default
-    SVPWM_Base(void) { overmodulate = false; }
+    // Sample type of the references and duty cycles
+    using sample_t = T;
+
+    // Duty cycle convention, modulators driving the low side hide it with their own
+    static constexpr DutyPolarity duty_polarity = DutyPolarity::ACTIVE_HIGH;
 
-    // De-constructor
-    virtual ~SVPWM_Base(void) {}
+    // Constructor, do not allow over-modulation by default
+    SVPWM_Base(void) { overmodulation = Overmodulation::DISABLED; }
 
     // Set the <alpha, beta> vectors
-    void set_vref_ab(float v_a, float v_b);
+    void set_vref_ab(T v_a, T v_b);
+
+    // Set the <alpha, beta> vectors from a stationary frame value
+    void set_vref_ab(zspinlab::math::type::AlphaBeta_T<T> v_ab) { set_vref_ab(v_ab.alpha, v_ab.beta); }
+
+    // Obtain the alpha voltage reference
+    T get_vref_a(void) { return va; }
+
+    // Obtain the beta voltage reference
+    T get_vref_b(void) { return vb; }
 
     // Obtain the calculated phase duty cycle for A channel   
-    float get_phase_duty_a(void) { return dA; }
+    T get_phase_duty_a(void) { return dA; }
 
     // Obtain the calculated phase duty cycle for B channel   
-    float get_phase_duty_b(void) { return dB; }
+    T get_phase_duty_b(void) { return dB; }
 
     // Obtain the calculated phase duty cycle for C channel   
-    float get_phase_duty_c(void) { return dC; }
+    T get_phase_duty_c(void) { return dC; }
 
-    // Allow/disallow over-modulation mode
-    void allow_overmodulation(bool overmodulate) { this->overmodulate = overmodulate; }
+    // Allow/disallow over-modulation mode, allowing it passes the reference through unlimited
+    void allow_overmodulation(bool overmodulate)
+    {
+        overmodulation = overmodulate ? Overmodulation::UNLIMITED : Overmodulation::DISABLED;
+    }
+
+    // Select how references beyond the linear range are handled
+    void set_overmodulation(Overmodulation overmodulation) { this->overmodulation = overmodulation; }
+
+    // Get how references beyond the linear range are handled
+    Overmodulation get_overmodulation(void) { return overmodulation; }
 
-    // Custom virtual methods, should be implemented in child classes
-    void init(void) { static_cast<Derived*>this->init(); }      // Initialize any remaining required parameters   
-    void run(void) { static_cast<Derived*>this->run(); }        // Main method, run the algorithm
+    // Custom methods, should be implemented in child classes (static dispatch, no vtable)
+    void init(void) { static_cast<Derived*>(this)->init(); }    // Initialize any remaining required parameters   
+    void run(void) { static_cast<Derived*>(this)->run(); }      // Main method, run the algorithm
 
 protected:
+    // De-constructor, non-virtual: modulators are never destroyed through a base pointer
+    ~SVPWM_Base(void) = default;
+
     // Phase duty cycle 
-    float dA, dB, dC;
+    T dA, dB, dC;
 
     // Reference alpha and beta voltage vectors, should be normalized to [-1, 1]
-    float va, vb;
+    T va, vb;
 
-    // Flag to indicate if we want phase over-modulation to increase the output voltage to motor
-    bool overmodulate; 
+    // How the references beyond the linear range are handled, over-modulation increases the output voltage to motor
+    Overmodulation overmodulation;
 
-    // Limit alpha-beta maximum amplitude to avoid distortions when phase over-modulation is not supported
+    // Limit alpha-beta maximum amplitude according to the over-modulation mode
     void limit_vref_ab(void);
+
+    // Clamp a duty cycle to [0, 1], same result as CLAMP() without a data dependent branch
+    static T clamp_duty_branchless(T d);
 };
 
 /**
@@ -55,30 +91,107 @@ protected:
  * @param[in] v_b beta voltage component
  * @return None
  */
-template <class Derived>
-inline void SVPWM_Base<Derived>::set_vref_ab(float v_a, float v_b)
+template <class Derived, typename T>
+inline void SVPWM_Base<Derived, T>::set_vref_ab(T v_a, T v_b)
 {
 	va = v_a;
 	vb = v_b;
 }
 
 /**
- * @brief Limit alpha and beta voltage maximum amplitude if over-modulation is not supported
+ * @brief Limit alpha and beta voltage maximum amplitude according to the over-modulation mode
+ *
+ * @note The hexagon and region I/II modes are only available with floating point samples, fixed-point modulators
+ * limit to the circle in these modes.
  * 
  * @return None
  */
-template <class Derived>
-inline void SVPWM_Base<Derived>::limit_vref_ab(void)
+template <class Derived, typename T>
+inline void SVPWM_Base<Derived, T>::limit_vref_ab(void)
 {
-    if (overmodulate) {
+    ZSPINLAB_PROFILE_SCOPE(LIMIT_VREF);
+
+    if (overmodulation == Overmodulation::UNLIMITED) {
         return;
     }
 
-    float mod = zspinlab::math::basic::fsqrtf(va*va + vb*vb, mod);
+    if constexpr (zspinlab::math::type::is_fixed_v<T>) {
+        using wide_t = typename T::wide_t;
+        using uwide_t = std::make_unsigned_t<wide_t>;
+
+        // |v|^2 with 2 * Q fractional bits, unsigned so that |v| up to sqrt(2) does not overflow
+        const uwide_t mod2 = uwide_t(wide_t(va.raw()) * va.raw()) + uwide_t(wide_t(vb.raw()) * vb.raw());
+        constexpr uwide_t limit2 = uwide_t(3) << (2 * T::frac_bits - 2);   // (sqrt(3)/2)^2 = 3/4
+
+        if (mod2 > limit2) {
+            constexpr wide_t k = T(MATH_SQRT_3_BY_2).raw();
+            const wide_t mod = wide_t(zspinlab::math::type::isqrt(mod2));
+
+            va = T::from_raw(T::saturate(wide_t(va.raw()) * k / mod));
+            vb = T::from_raw(T::saturate(wide_t(vb.raw()) * k / mod));
+        }
+    } else {
+        if (overmodulation == Overmodulation::REGION_I_II) {
+            overmod_region_i_ii(va, vb);
+            return;
+        }
+
+        if (overmodulation != Overmodulation::DISABLED) {
+            overmod_hexagon_limit(overmodulation, va, vb);
+            return;
+        }
+
+        // Compare squared amplitudes, the sqrt and divide are only paid when the reference is actually limited
+        const T mod2 = va*va + vb*vb;
+
+        if (mod2 > T(0.75f)) {
+            T k;
+
+            if constexpr (std::is_same_v<T, float>) {
+                k = T(MATH_SQRT_3_BY_2) / zspinlab::math::basic::fsqrtf(mod2);
+            } else {
+                // Unqualified so that sample types with their own sqrt() are found by argument-dependent lookup
+                using std::sqrt;
+                k = T(MATH_SQRT_3_BY_2) / sqrt(mod2);
+            }
+
+            va   = va * k;
+            vb   = vb * k;
+        }
+    }
+}
+
+/**
+ * @brief Clamp a duty cycle to [0, 1] without a data dependent branch
+ * @param[in] d Duty cycle
+ *
+ * @note Compilers often turn the floating point CLAMP() into a branch on the lower bound, so floating point types select
+ * on the bit pattern instead, with the same comparisons as CLAMP(): zero at or below zero, the duty below one, one
+ * otherwise. Matches CLAMP() bit for bit, so -0.0 gives +0.0 and NaN gives 1.0.
+ *
+ * @return Clamped duty cycle
+ */
+template <class Derived, typename T>
+inline T SVPWM_Base<Derived, T>::clamp_duty_branchless(T d)
+{
+    if constexpr (std::is_floating_point_v<T>) {
+        using bits_t = std::conditional_t<sizeof(T) == sizeof(uint32_t), uint32_t, uint64_t>;
+        constexpr T one = T(1.0f);
+
+        bits_t bits, one_bits;
+        std::memcpy(&bits, &d, sizeof(T));
+        std::memcpy(&one_bits, &one, sizeof(T));
+
+        const bool below = (d <= T(0.0f));
+        const bits_t low = bits_t(0) - bits_t(below);
+        const bits_t pass = bits_t(0) - bits_t(!below & (d < one));
+
+        bits = (bits & pass) | (one_bits & ~(low | pass));
+        std::memcpy(&d, &bits, sizeof(T));
 
-    if (mod > MATH_SQRT_3_BY_2) {
-        va   = va / mod * MATH_SQRT_3_BY_2;
-        vb   = vb / mod * MATH_SQRT_3_BY_2;
+        return d;
+    } else {
+        return std::min(std::max(d, T(0.0f)), T(1.0f));
     }
 }
 
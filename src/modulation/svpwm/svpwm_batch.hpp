@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <zephyr/sys/util.h>
+#include "math/math_const.hpp"
+#include "math/math_core.hpp"
+#include "overmodulation.hpp"
+
+namespace zspinlab::modulation {
+
+/**
+ * @brief Run the SVGen min/max-injection SVPWM over a batch of independent axes.
+ *
+ * Structure-of-arrays variant of SVPWM_SVGen::run for boards driving several motors from one core. Every lane goes
+ * through the same straight-line code (no sector search, no per-object state), so the loop can be auto-vectorized
+ * (SSE/AVX on host, NEON/Helium on target) when built with -O3 or -ftree-vectorize. Each lane gives the same duties as
+ * an SVPWM_SVGen set to the same over-modulation mode, bit for bit.
+ *
+ * @tparam overmodulation How the references beyond the linear range are handled, as SVPWM_Base::set_overmodulation.
+ *                        DISABLED (the SVPWM_Base default) limits each <alpha, beta> reference to the sqrt(3)/2
+ *                        circle without a branch, paying the sqrtf and divide on every lane: verified to vectorize
+ *                        with GCC 12 at -O3 -fno-math-errno and -O2 -ftree-vectorize -fno-math-errno, while without
+ *                        -fno-math-errno the errno path of sqrtf keeps the loop scalar and slower than the objects.
+ *                        UNLIMITED vectorizes at -O3 alone. The hexagon and region I/II modes call the scalar
+ *                        limiters and do not vectorize.
+ * @param[in] va          Input alpha voltage components, normalized to [-1, 1]
+ * @param[in] vb          Input beta voltage components, normalized to [-1, 1]
+ * @param[out] dA         Output phase A duty cycles [0, 1]
+ * @param[out] dB         Output phase B duty cycles [0, 1]
+ * @param[out] dC         Output phase C duty cycles [0, 1]
+ * @param[in] n           Number of axes in the batch
+ *
+ * @note Input and output arrays must not overlap.
+ *
+ * @return None
+ */
+template <Overmodulation overmodulation = Overmodulation::DISABLED>
+inline void svpwm_svgen_run_batch(const float *__restrict va,
+                                  const float *__restrict vb,
+                                  float *__restrict dA,
+                                  float *__restrict dB,
+                                  float *__restrict dC,
+                                  size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        float alpha = va[i];
+        float beta = vb[i];
+
+        if constexpr (overmodulation == Overmodulation::DISABLED) {
+            // Same result as SVPWM_Base::limit_vref_ab without a branch: inside the circle (or on NaN) the amplitude
+            // is raised to the limit, where fsqrtf(0.75f) is exactly MATH_SQRT_3_BY_2 and the scale exactly one. The
+            // select is done on the bit pattern, a plain ?: is turned back into a branch by the compiler, which then
+            // only multiplies on one side and keeps the loop scalar
+            const float mod2 = alpha * alpha + beta * beta;
+            constexpr float limit2 = 0.75f;
+            uint32_t mod2_bits, limit2_bits;
+
+            std::memcpy(&mod2_bits, &mod2, sizeof(float));
+            std::memcpy(&limit2_bits, &limit2, sizeof(float));
+
+            const uint32_t outside = uint32_t(0) - uint32_t(mod2 > limit2);
+            const uint32_t clamped_bits = (mod2_bits & outside) | (limit2_bits & ~outside);
+            float clamped;
+
+            std::memcpy(&clamped, &clamped_bits, sizeof(float));
+
+            const float scale = MATH_SQRT_3_BY_2 / zspinlab::math::basic::fsqrtf(clamped);
+
+            alpha = alpha * scale;
+            beta = beta * scale;
+        } else if constexpr (overmodulation == Overmodulation::REGION_I_II) {
+            overmod_region_i_ii(alpha, beta);
+        } else if constexpr (overmodulation != Overmodulation::UNLIMITED) {
+            overmod_hexagon_limit(overmodulation, alpha, beta);
+        }
+
+        float a, b, c;
+
+        c = 0.5f * alpha;
+        b = MATH_SQRT_3_BY_2 * beta;
+        a = b - c;
+        c = -c - b;
+        b = (MAX(MAX(alpha, a), c) + MIN(MIN(alpha, a), c)) * -0.5f;
+
+        dA[i] = CLAMP(0.5f + (alpha + b) * MATH_2_BY_3, 0.0f, 1.0f);
+        dB[i] = CLAMP(0.5f + (a + b) * MATH_2_BY_3, 0.0f, 1.0f);
+        dC[i] = CLAMP(0.5f + (b + c) * MATH_2_BY_3, 0.0f, 1.0f);
+    }
+}
+
+} // namespace zspinlab::modulation
@@ -0,0 +1,189 @@
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+#include "svpwm_base.hpp"
+#include <zephyr/sys/util.h>
+
+namespace zspinlab::modulation {
+
+// Clamp pattern of the discontinuous modulators
+enum class DpwmPattern : uint8_t
+{
+    DPWM0 = 0,  // 60 degree clamp intervals, 30 degrees ahead of the phase voltage peaks
+    DPWM1,      // 60 degree clamp intervals centered on the phase voltage peaks
+    DPWM2,      // 60 degree clamp intervals, 30 degrees behind the phase voltage peaks
+    DPWM3,      // 30 degree clamp intervals on both sides of the DPWM1 intervals
+    DPWMMIN,    // 120 degree intervals, the lowest phase is clamped to the negative rail
+    DPWMMAX,    // 120 degree intervals, the highest phase is clamped to the positive rail
+    CURRENT,    // 60 degree clamp intervals centered on the phase current peaks, at most 30 degrees away from DPWM1
+};
+
+/*
+ * Discontinuous PWM family: carrier based modulator where the zero-sequence voltage clamps one leg to a DC rail over
+ * each 60 degree (120 degree for DPWMMIN/DPWMMAX) segment, so only two legs switch per PWM period. This saves a third
+ * of the switching events, and up to half of the switching losses when the clamp is centered on the current peak.
+ *
+ * The clamp pattern is a template parameter, only the selected decision is compiled. Each period either the highest
+ * phase is clamped high or the lowest phase is clamped low; the pattern only chooses which of the two, from the
+ * reference voltage rotated by the pattern shift, or from the phase currents for DpwmPattern::CURRENT.
+ *
+ * Duty cycles follow the SVPWM_ODTV_1N/SVPWM_SVGen/SVPWM_ZSpinner convention (high-side on time).
+ */
+template <DpwmPattern Pattern, typename T>
+class SVPWM_DPWM_T : public SVPWM_Base<SVPWM_DPWM_T<Pattern, T>, T>
+{
+    using Base = SVPWM_Base<SVPWM_DPWM_T<Pattern, T>, T>;
+    using Base::va;
+    using Base::vb;
+    using Base::dA;
+    using Base::dB;
+    using Base::dC;
+    using Base::limit_vref_ab;
+
+public:
+
+    // Constructor
+    SVPWM_DPWM_T(void) : ia(), ib() {}
+
+    void init(void) {}
+    void run(void);
+
+    // Set the <alpha, beta> phase currents the clamp is centered on (DpwmPattern::CURRENT only)
+    template <DpwmPattern P = Pattern, std::enable_if_t<P == DpwmPattern::CURRENT, int> = 0>
+    void set_current_ab(T i_a, T i_b)
+    {
+        ia = i_a;
+        ib = i_b;
+    }
+
+private:
+    // Phase currents, DpwmPattern::CURRENT only
+    T ia, ib;
+
+    bool clamp_high(void);
+};
+
+// Single precision DPWM0 modulator
+using SVPWM_DPWM0 = SVPWM_DPWM_T<DpwmPattern::DPWM0, float>;
+// Single precision DPWM1 modulator
+using SVPWM_DPWM1 = SVPWM_DPWM_T<DpwmPattern::DPWM1, float>;
+// Single precision DPWM2 modulator
+using SVPWM_DPWM2 = SVPWM_DPWM_T<DpwmPattern::DPWM2, float>;
+// Single precision DPWM3 modulator
+using SVPWM_DPWM3 = SVPWM_DPWM_T<DpwmPattern::DPWM3, float>;
+// Single precision DPWMMIN modulator
+using SVPWM_DPWMMIN = SVPWM_DPWM_T<DpwmPattern::DPWMMIN, float>;
+// Single precision DPWMMAX modulator
+using SVPWM_DPWMMAX = SVPWM_DPWM_T<DpwmPattern::DPWMMAX, float>;
+// Single precision current-aware DPWM modulator
+using SVPWM_DPWM_Current = SVPWM_DPWM_T<DpwmPattern::CURRENT, float>;
+
+/**
+ * @brief Decide whether the highest phase is clamped high or the lowest phase clamped low in this period
+ *
+ * @note The decision vector (reference voltage rotated by the pattern shift, or the phase current) is split into its
+ * phase components: the positive rail is used when its largest component outweighs its smallest one.
+ *
+ * @return True to clamp the highest phase to the positive rail, false to clamp the lowest one to the negative rail
+ */
+template <DpwmPattern Pattern, typename T>
+inline bool SVPWM_DPWM_T<Pattern, T>::clamp_high(void)
+{
+    if constexpr (Pattern == DpwmPattern::DPWMMAX) {
+        return true;
+    } else if constexpr (Pattern == DpwmPattern::DPWMMIN) {
+        return false;
+    } else {
+        T x = va, y = vb;
+        bool ahead = false, behind = false;
+
+        if constexpr (Pattern == DpwmPattern::CURRENT) {
+            // Follow the current while it is within 30 degrees of the voltage, DPWM0/DPWM2 are optimal beyond that
+            const T dot = va * ia + vb * ib;
+            const T cross = va * ib - vb * ia;
+            const T cross2 = cross * cross;
+
+            // tan^2 <= 1/3, written without constants out of the fixed-point range
+            if (dot > T(0.0f) && dot * dot >= cross2 + cross2 + cross2) {
+                x = ia;
+                y = ib;
+            } else {
+                ahead = cross > T(0.0f);
+                behind = !ahead;
+            }
+        }
+
+        if (Pattern == DpwmPattern::DPWM0 || ahead) {
+            // Rotate by +30 degrees, the clamp intervals move 30 degrees ahead
+            x = T(MATH_SQRT_3_BY_2) * va - T(0.5f) * vb;
+            y = T(0.5f) * va + T(MATH_SQRT_3_BY_2) * vb;
+        } else if (Pattern == DpwmPattern::DPWM2 || behind) {
+            // Rotate by -30 degrees, the clamp intervals move 30 degrees behind
+            x = T(MATH_SQRT_3_BY_2) * va + T(0.5f) * vb;
+            y = T(MATH_SQRT_3_BY_2) * vb - T(0.5f) * va;
+        }
+
+        // Phase components (inverse Clarke)
+        const T pa = x;
+        const T pb = T(MATH_SQRT_3_BY_2) * y - T(0.5f) * x;
+        const T pc = -(pa + pb);
+        const T hi = MAX(MAX(pa, pb), pc);
+        const T lo = MIN(MIN(pa, pb), pc);
+
+        if constexpr (Pattern == DpwmPattern::DPWM3) {
+            // Opposite of DPWM1: clamp while the phase is away from its peak
+            return hi < -lo;
+        } else {
+            return hi >= -lo;
+        }
+    }
+}
+
+/**
+ * @brief Run the discontinuous PWM algorithm
+ *
+ * @note The clamped leg is computed as an exact 0 or 1, so the PWM peripheral sees a full period without any edge.
+ *
+ * @return None
+ */
+template <DpwmPattern Pattern, typename T>
+inline void SVPWM_DPWM_T<Pattern, T>::run(void)
+{
+	ZSPINLAB_PROFILE_SCOPE(SVPWM_DPWM);
+
+	T a, b, c;
+	T hi, lo;
+
+    // Limit alpha and beta if required
+    limit_vref_ab();
+
+    // Phase references, the duty cycle swing is 2/3 of the <alpha, beta> amplitude
+	a = T(MATH_2_BY_3) * va;
+	b = T(MATH_1_BY_SQRT_3) * vb - T(MATH_1_BY_3) * va;
+	c = -(a + b);
+
+	hi = MAX(MAX(a, b), c);
+	lo = MIN(MIN(a, b), c);
+
+	if (clamp_high()) {
+		// Zero sequence 1/2 - max, computed from the rail so the highest phase is exactly 1
+		dA = T(1.0f) - (hi - a);
+		dB = T(1.0f) - (hi - b);
+		dC = T(1.0f) - (hi - c);
+	} else {
+		// Zero sequence -1/2 - min, the lowest phase is exactly 0
+		dA = a - lo;
+		dB = b - lo;
+		dC = c - lo;
+	}
+
+	// Clamp
+	dA = CLAMP(dA, T(0.0f), T(1.0f));
+	dB = CLAMP(dB, T(0.0f), T(1.0f));
+	dC = CLAMP(dC, T(0.0f), T(1.0f));
+
+    ZSPINLAB_TELEMETRY_PROBE(SVPWM, va, vb, dA, dB, dC);
+}
+
+} // namespace zspinlab::modulation
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cmath>
+#include <type_traits>
 #include "svpwm_base.hpp"
 #include <zephyr/sys/util.h>
 
@@ -11,17 +13,50 @@ namespace zspinlab::modulation {
  * 
  * Reference: https://www.mdpi.com/1996-1073/15/11/4065
  */  
-class SVPWM_ODTV_1N : public SVPWM_Base<SVPWM_ODTV_1N>
+template <typename T>
+class SVPWM_ODTV_1N_T : public SVPWM_Base<SVPWM_ODTV_1N_T<T>, T>
 {
+    static_assert(std::is_floating_point_v<T>, "SVPWM_ODTV_1N_T requires a floating point sample type");
+
+    using Base = SVPWM_Base<SVPWM_ODTV_1N_T<T>, T>;
+    using Base::va;
+    using Base::vb;
+    using Base::dA;
+    using Base::dB;
+    using Base::dC;
+    using Base::limit_vref_ab;
+
 public:
     
     // Constructor
-    using SVPWM_Base::SVPWM_Base;
+    using Base::Base;
 
     void init(void) {};
     void run(void);
+
+private:
+    static T abs(T in);
 };
 
+// Single precision ODTV 1-norm modulator
+using SVPWM_ODTV_1N = SVPWM_ODTV_1N_T<float>;
+
+/**
+ * @brief Absolute value, using the library fabsf for single precision
+ * @param[in] in Input value
+ *
+ * @return |in|
+ */
+template <typename T>
+inline T SVPWM_ODTV_1N_T<T>::abs(T in)
+{
+    if constexpr (std::is_same_v<T, float>) {
+        return zspinlab::math::basic::ffabsf(in);
+    } else {
+        return std::fabs(in);
+    }
+}
+
 
 /**
  * @brief Run the SVPWM ODTV 1-norm algorithm.
@@ -31,49 +66,54 @@ public:
  * 
  * @return None
  */
-inline void SVPWM_ODTV_1N::run(void)
+template <typename T>
+inline void SVPWM_ODTV_1N_T<T>::run(void)
 {
-	float a, b, c;
-	float abs_a, abs_b, abs_c;
-	float half_a, half_b, half_c;
+	ZSPINLAB_PROFILE_SCOPE(SVPWM_ODTV_1N);
+
+	T a, b, c;
+	T abs_a, abs_b, abs_c;
+	T half_a, half_b, half_c;
 
     // Limit alpha and beta if required
     limit_vref_ab();
 
-	a = va + MATH_1_BY_SQRT_3 * vb;
-	b = MATH_2_BY_SQRT_3 * vb;
+	a = va + T(MATH_1_BY_SQRT_3) * vb;
+	b = T(MATH_2_BY_SQRT_3) * vb;
 	c = a - b;
 
 	// Pre-compute everything possible
-	abs_a = zspinlab::math::basic::ffabsf(a);
-	abs_b = zspinlab::math::basic::ffabsf(b);
-	abs_c = zspinlab::math::basic::ffabsf(c);
+	abs_a = abs(a);
+	abs_b = abs(b);
+	abs_c = abs(c);
 
-	half_a = a * 0.5f;
-	half_b = b * 0.5f;
-	half_c = c * 0.5f;
+	half_a = a * T(0.5f);
+	half_b = b * T(0.5f);
+	half_c = c * T(0.5f);
 
 	if ((abs_c >= abs_a) && (abs_c > abs_b)) {
-		dA = half_c + 0.5f;
-		dB = -half_c + 0.5f;
-		dC = -half_a - half_b + 0.5f;
+		dA = half_c + T(0.5f);
+		dB = -half_c + T(0.5f);
+		dC = -half_a - half_b + T(0.5f);
 
 	} else if ((abs_a >= abs_b) && (abs_a > abs_c)) {
-		dA = half_a + 0.5f;
-		dB = half_b - half_c + 0.5f;
-		dC = -half_a + 0.5f;
+		dA = half_a + T(0.5f);
+		dB = half_b - half_c + T(0.5f);
+		dC = -half_a + T(0.5f);
 
 	} else {
-		dA = half_a + half_c + 0.5f;
-		dB = half_b + 0.5f;
-		dC = -half_b + 0.5f;
+		dA = half_a + half_c + T(0.5f);
+		dB = half_b + T(0.5f);
+		dC = -half_b + T(0.5f);
 
 	}
 
 		// Clamp
-	dA = CLAMP(dA, 0.0f, 1.0f);
-	dB = CLAMP(dB, 0.0f, 1.0f);
-	dC = CLAMP(dC, 0.0f, 1.0f);
+	dA = CLAMP(dA, T(0.0f), T(1.0f));
+	dB = CLAMP(dB, T(0.0f), T(1.0f));
+	dC = CLAMP(dC, T(0.0f), T(1.0f));
+
+    ZSPINLAB_TELEMETRY_PROBE(SVPWM, va, vb, dA, dB, dC);
 }
 
 } // namespace zspinlab::modulation::SpaceVectorPWM
\ No newline at end of file
@@ -6,40 +6,85 @@
 namespace zspinlab::modulation {
 
 // This implement the optimized SVPWM algorithm generated from MATLAB Space Vector Generator Simulink Toolbox  
-class SVPWM_SVGen : public SVPWM_Base<SVPWM_SVGen>
+template <typename T>
+class SVPWM_SVGen_T : public SVPWM_Base<SVPWM_SVGen_T<T>, T>
 {
+    using Base = SVPWM_Base<SVPWM_SVGen_T<T>, T>;
+    using Base::va;
+    using Base::vb;
+    using Base::limit_vref_ab;
+    using Base::dA;
+    using Base::dB;
+    using Base::dC;
+
 public:
     
     // Constructor
-    SVPWM_SVGen(void) = default;
+    SVPWM_SVGen_T(void) = default;
 
     void init(void) {}
     void run(void);
 };
 
+// Single precision SVGen modulator
+using SVPWM_SVGen = SVPWM_SVGen_T<float>;
+// Q15 SVGen modulator
+using SVPWM_SVGen_Q15 = SVPWM_SVGen_T<zspinlab::math::type::Q15>;
+// Q31 SVGen modulator
+using SVPWM_SVGen_Q31 = SVPWM_SVGen_T<zspinlab::math::type::Q31>;
+
 /**
  * @brief Run the SVPWM algorithm generated from the MATLAB Simulink SVGEN block.
  * 
+ * @note The phase references get the min/max zero-sequence injection, then duty = 0.5 + 2/3 * phase reference: same
+ * duty cycle convention (high-side on time, 0.5 at zero voltage) and gain as SVPWM_ODTV_1N and SVPWM_ZSpinner.
+ * Fixed-point version: references outside the unit circle saturate the intermediate terms, so the output only matches
+ * the floating point version in the linear range.
+ * 
  * @return None
  */
-inline void SVPWM_SVGen::run(void)
+template <typename T>
+inline void SVPWM_SVGen_T<T>::run(void)
 {
-	float a, b, c;
+	ZSPINLAB_PROFILE_SCOPE(SVPWM_SVGEN);
+
+	T a, b, c;
 
-    c = 0.5f * va;
-    b = MATH_SQRT_3_BY_2 * vb;
-    a = b - c;
-    c = -c - b;
-    b = (MAX(MAX(va, a), c) + MIN(MIN(va, a), c)) * -0.5f;
+    // Limit alpha and beta if required
+    limit_vref_ab();
 
-    dA = (va + b) * MATH_2_BY_SQRT_3;
-    dB = (a + b) * MATH_2_BY_SQRT_3;
-    dC = (b + c) * MATH_2_BY_SQRT_3;
+    if constexpr (zspinlab::math::type::is_fixed_v<T>) {
+        constexpr T k_half(0.5f);
+        constexpr T k_sqrt_3_by_2(MATH_SQRT_3_BY_2);
+        constexpr T k_2_by_3(MATH_2_BY_3);
+
+        c = va * k_half;
+        b = vb * k_sqrt_3_by_2;
+        a = b - c;
+        c = -c - b;
+        b = -((MAX(MAX(va, a), c) + MIN(MIN(va, a), c)) * k_half);
+
+        dA = k_half + (va + b) * k_2_by_3;
+        dB = k_half + (a + b) * k_2_by_3;
+        dC = k_half + (b + c) * k_2_by_3;
+    } else {
+        c = T(0.5f) * va;
+        b = T(MATH_SQRT_3_BY_2) * vb;
+        a = b - c;
+        c = -c - b;
+        b = (MAX(MAX(va, a), c) + MIN(MIN(va, a), c)) * T(-0.5f);
+
+        dA = T(0.5f) + (va + b) * T(MATH_2_BY_3);
+        dB = T(0.5f) + (a + b) * T(MATH_2_BY_3);
+        dC = T(0.5f) + (b + c) * T(MATH_2_BY_3);
+    }
 
     // Clamp
-	dA = CLAMP(dA, 0.0f, 1.0f);
-	dB = CLAMP(dB, 0.0f, 1.0f);
-	dC = CLAMP(dC, 0.0f, 1.0f);
+	dA = CLAMP(dA, T(0.0f), T(1.0f));
+	dB = CLAMP(dB, T(0.0f), T(1.0f));
+	dC = CLAMP(dC, T(0.0f), T(1.0f));
+
+    ZSPINLAB_TELEMETRY_PROBE(SVPWM, va, vb, dA, dB, dC);
 }
 
-} // namespace zspinlab::modulation::SpaceVectorPWM
\ No newline at end of file
+} // namespace zspinlab::modulation::SpaceVectorPWM
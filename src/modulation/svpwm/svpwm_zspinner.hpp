@@ -1,5 +1,6 @@
 #pragma once
 
+#include <type_traits>
 #include "svpwm_base.hpp"
 #include <zephyr/sys/util.h>
 
@@ -7,39 +8,94 @@
 namespace zspinlab::modulation {
 
 // This implement the SVPWM algorithm from the Zephyr Spinner project, work in progress  
-class SVPWM_ZSpinner :  public SVPWM_Base<SVPWM_ZSpinner>
+// With Branchless set, the sector sequence is table driven: same instruction path for every angle, bit-identical duties
+template <typename T, bool Branchless = false>
+class SVPWM_ZSpinner_T :  public SVPWM_Base<SVPWM_ZSpinner_T<T, Branchless>, T>
 {
+    static_assert(std::is_floating_point_v<T>, "SVPWM_ZSpinner_T requires a floating point sample type");
+
+    using Base = SVPWM_Base<SVPWM_ZSpinner_T<T, Branchless>, T>;
+    using Base::va;
+    using Base::vb;
+    using Base::dA;
+    using Base::dB;
+    using Base::dC;
+    using Base::limit_vref_ab;
+    using Base::clamp_duty_branchless;
+
 public:
     
     // Constructor
-    using SVPWM_Base::SVPWM_Base;
+    using Base::Base;
 
     void init(void) {}
     void run(void);
 
 private:
-    uint8_t get_sector(float a, float b, float c);
+    void sequence(T a, T b, T c);
+    void sequence_branchless(T a, T b, T c);
+
+    uint8_t get_sector(T a, T b, T c);
 };
 
+// Single precision Zephyr Spinner modulator
+using SVPWM_ZSpinner = SVPWM_ZSpinner_T<float>;
+// Single precision branchless Zephyr Spinner modulator
+using SVPWM_ZSpinner_Branchless = SVPWM_ZSpinner_T<float, true>;
+
 
 /**
  * @brief Run the SVM algorithm implemented in the Zephyr Spinner project
  * 
  * @return None
  */
-inline void SVPWM_ZSpinner::run(void)
+template <typename T, bool Branchless>
+inline void SVPWM_ZSpinner_T<T, Branchless>::run(void)
 {
-	float a, b, c;
-	float x, y, z;
+	ZSPINLAB_PROFILE_SCOPE(SVPWM_ZSPINNER);
 
-	uint8_t sector;
+	T a, b, c;
 
     // Limit alpha and beta if required
     limit_vref_ab();
 
-	a = va - MATH_1_BY_SQRT_3 * vb;
-	b = MATH_2_BY_SQRT_3 * vb;
-	c = -(va + vb);
+	a = va - T(MATH_1_BY_SQRT_3) * vb;
+	b = T(MATH_2_BY_SQRT_3) * vb;
+	c = -(va + T(MATH_1_BY_SQRT_3) * vb);
+
+    if constexpr (Branchless) {
+        sequence_branchless(a, b, c);
+
+        // Clamp
+        dA = clamp_duty_branchless(dA);
+        dB = clamp_duty_branchless(dB);
+        dC = clamp_duty_branchless(dC);
+    } else {
+        sequence(a, b, c);
+
+        // Clamp
+        dA = CLAMP(dA, T(0.0f), T(1.0f));
+        dB = CLAMP(dB, T(0.0f), T(1.0f));
+        dC = CLAMP(dC, T(0.0f), T(1.0f));
+    }
+
+    ZSPINLAB_TELEMETRY_PROBE(SVPWM, va, vb, dA, dB, dC);
+}
+
+/**
+ * @brief Compute the unclamped duty cycles, sector search and six-way switch
+ * @param[in] a a component value.
+ * @param[in] b b component value.
+ * @param[in] c c component value.
+ *
+ * @return None
+ */
+template <typename T, bool Branchless>
+inline void SVPWM_ZSpinner_T<T, Branchless>::sequence(T a, T b, T c)
+{
+	T x, y, z;
+
+	uint8_t sector;
 
     // Find sector
     sector = get_sector(a, b, c);
@@ -48,76 +104,130 @@ inline void SVPWM_ZSpinner::run(void)
 	case 1U:
 		x = a;
 		y = b;
-		z = 1.0f - (x + y);
+		z = T(1.0f) - (x + y);
 
-		dA = x + y + z * 0.5f;
-		dB = y + z * 0.5f;
-		dC = z * 0.5f;
+		dA = x + y + z * T(0.5f);
+		dB = y + z * T(0.5f);
+		dC = z * T(0.5f);
 
 		break;
 	case 2U:
 		x = -c;
 		y = -a;
-		z = 1.0f - (x + y);
+		z = T(1.0f) - (x + y);
 
-		dA = x + z * 0.5f;
-		dB = x + y + z * 0.5f;
-		dC = z * 0.5f;
+		dA = x + z * T(0.5f);
+		dB = x + y + z * T(0.5f);
+		dC = z * T(0.5f);
 
 		break;
 	case 3U:
 		x = b;
 		y = c;
-		z = 1.0f - (x + y);
+		z = T(1.0f) - (x + y);
 
-		dA = z * 0.5f;
-		dB = x + y + z * 0.5f;
-		dC = y + z * 0.5f;
+		dA = z * T(0.5f);
+		dB = x + y + z * T(0.5f);
+		dC = y + z * T(0.5f);
 
 		break;
 	case 4U:
 		x = -a;
 		y = -b;
-		z = 1.0f - (x + y);
+		z = T(1.0f) - (x + y);
 
-		dA = z * 0.5f;
-		dB = x + z * 0.5f;
-		dC = x + y + z * 0.5f;
+		dA = z * T(0.5f);
+		dB = x + z * T(0.5f);
+		dC = x + y + z * T(0.5f);
 
 		break;
 	case 5U:
 		x = c;
 		y = a;
-		z = 1.0f - (x + y);
+		z = T(1.0f) - (x + y);
 
-		dA = y + z * 0.5f;
-		dB = z * 0.5f;
-		dC = x + y + z * 0.5f;
+		dA = y + z * T(0.5f);
+		dB = z * T(0.5f);
+		dC = x + y + z * T(0.5f);
 
 		break;
 	case 6U:
 		x = -b;
 		y = -c;
-		z = 1.0f - (x + y);
+		z = T(1.0f) - (x + y);
 
-		dA = x + y + z * 0.5f;
-		dB = z * 0.5f;
-		dC = x + z * 0.5f;
+		dA = x + y + z * T(0.5f);
+		dB = z * T(0.5f);
+		dC = x + z * T(0.5f);
 
 		break;
 	default:
         // Invalid state
-        dA = 0;
-        dB = 0;
-        dC = 0;
+        dA = T(0.0f);
+        dB = T(0.0f);
+        dC = T(0.0f);
 
 		break;
 	}
+}
+
+/**
+ * @brief Compute the unclamped duty cycles, same operations as sequence() without any data dependent branch
+ * @param[in] a a component value.
+ * @param[in] b b component value.
+ * @param[in] c c component value.
+ *
+ * The sector comes from the get_sector() comparisons packed in a table index, and the per-sector choice of x, y and
+ * phase order is a table lookup, so the operations and their order (hence the rounding) match the switch case by case.
+ *
+ * @return None
+ */
+template <typename T, bool Branchless>
+inline void SVPWM_ZSpinner_T<T, Branchless>::sequence_branchless(T a, T b, T c)
+{
+    // Sector for each (c < 0, a < 0, b < 0, b <= 0) combination, (b < 0, b > 0) is unreachable and set as b < 0
+    static constexpr uint8_t SECTOR[16] = {
+        5, 5, 5, 5,     // c >= 0, a >= 0
+        3, 4, 4, 4,     // c >= 0, a < 0
+        1, 1, 6, 6,     // c < 0, a >= 0
+        2, 2, 2, 2,     // c < 0, a < 0
+    };
+
+    // Per sector (1...6): x, y and the term added to z/2 for the middle duty, and the phases in decreasing duty order.
+    // Terms: 0: a, 1: b, 2: c, 3: -a, 4: -b, 5: -c
+    struct Step
+    {
+        uint8_t x, y, add_mid;      // Terms
+        uint8_t max, mid, min;      // Phases (0: A, 1: B, 2: C)
+    };
+    static constexpr Step STEP[6] = {
+        {0, 1, 1, 0, 1, 2},
+        {5, 3, 5, 1, 0, 2},
+        {1, 2, 2, 1, 2, 0},
+        {3, 4, 3, 2, 1, 0},
+        {2, 0, 0, 2, 0, 1},
+        {4, 5, 4, 0, 2, 1},
+    };
+
+    const T term[6] = {a, b, c, -a, -b, -c};
+    T x, y, z;
+    T d[3];
+
+    const uint8_t index = (uint8_t(c < T(0.0f)) << 3) | (uint8_t(a < T(0.0f)) << 2) | (uint8_t(b < T(0.0f)) << 1) |
+                          uint8_t(b <= T(0.0f));
+    const Step &step = STEP[SECTOR[index] - 1];
+
+	x = term[step.x];
+	y = term[step.y];
+	z = T(1.0f) - (x + y);
+
+    d[step.max] = x + y + z * T(0.5f);
+    d[step.mid] = term[step.add_mid] + z * T(0.5f);
+    d[step.min] = z * T(0.5f);
 
-	// Clamp
-	dA = CLAMP(dA, 0.0f, 1.0f);
-	dB = CLAMP(dB, 0.0f, 1.0f);
-	dC = CLAMP(dC, 0.0f, 1.0f);
+    dA = d[0];
+    dB = d[1];
+    dC = d[2];
 }
 
 
@@ -129,17 +239,18 @@ inline void SVPWM_ZSpinner::run(void)
  * @param[in] c c component value.
  * @return Sector (1...6).
  */
-inline uint8_t SVPWM_ZSpinner::get_sector(float a, float b, float c)
+template <typename T, bool Branchless>
+inline uint8_t SVPWM_ZSpinner_T<T, Branchless>::get_sector(T a, T b, T c)
 {
-	if (c < 0.0f) {
-		if (a < 0.0f) {
+	if (c < T(0.0f)) {
+		if (a < T(0.0f)) {
 			return 2U;
 		} else {
-            return (b < 0.0f ? 6U : 1U);
+            return (b < T(0.0f) ? 6U : 1U);
 		}
 	} else {
-		if (a < 0.0f) {
-            return (b <= 0.0f ? 4U : 3U);
+		if (a < T(0.0f)) {
+            return (b <= T(0.0f) ? 4U : 3U);
 		} else {
 			return 5U;
 		}
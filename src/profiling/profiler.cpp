@@ -0,0 +1,48 @@
+#include "profiler.hpp"
+
+namespace zspinlab::profiling
+{
+    /**
+     * @brief Start the cycle counter if required and clear every probe statistics
+     *
+     * @return None
+     **/
+    void init(void)
+    {
+#if defined(CONFIG_ZSPINLAB_PROFILING) && defined(CONFIG_CPU_CORTEX_M_HAS_DWT)
+        // Enable trace (DEMCR.TRCENA), then the DWT cycle counter (DWT_CTRL.CYCCNTENA)
+        *reinterpret_cast<volatile uint32_t *>(0xE000EDFCUL) |= (1UL << 24);
+        *reinterpret_cast<volatile uint32_t *>(0xE0001004UL) = 0;
+        *reinterpret_cast<volatile uint32_t *>(0xE0001000UL) |= 1UL;
+#endif
+        reset();
+    }
+
+    /**
+     * @brief Clear every probe statistics
+     *
+     * @note Not synchronized with the instrumented code, call it while the control loop is stopped or accept that one
+     * sample may be lost.
+     *
+     * @return None
+     **/
+    void reset(void)
+    {
+        for (ProbeStats &s : stats)
+        {
+            s = ProbeStats{};
+        }
+    }
+
+    /**
+     * @brief Get the statistics of one probe
+     * @param[in] probe Probe
+     *
+     * @return Probe statistics, durations in counter ticks
+     **/
+    const ProbeStats &get_stats(Probe probe)
+    {
+        return stats[static_cast<uint8_t>(probe)];
+    }
+
+} // namespace zspinlab::profiling
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <cstdint>
+
+#if defined(CONFIG_ZSPINLAB_PROFILING)
+#if defined(CONFIG_CPU_CORTEX_M_HAS_DWT)
+// DWT cycle counter, memory mapped
+#elif defined(__ZEPHYR__)
+#include <zephyr/kernel.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <time.h>
+#endif
+#endif
+
+namespace zspinlab::profiling
+{
+    // Profiled hot-path stages. Application probes keep their IDs: add new stages before COUNT only
+    enum class Probe : uint8_t
+    {
+        CLARKE = 0,
+        PI,
+        INVERSE_PARK,
+        LIMIT_VREF,
+        SVPWM_ARS,
+        SVPWM_ODTV_1N,
+        SVPWM_SVGEN,
+        SVPWM_ZSPINNER,
+        USER_0,         // Free for application probes
+        USER_1,         // Free for application probes
+        SVPWM_DPWM,
+        COUNT,
+    };
+
+    // Number of log2 histogram buckets: bucket n holds durations in [2^(n-1), 2^n) cycles, bucket 0 holds zero
+    constexpr uint8_t HISTOGRAM_BUCKETS = 33;
+
+    // Statistics of one probe, durations in counter ticks
+    struct ProbeStats
+    {
+        uint32_t count;
+        uint32_t min;
+        uint32_t max;
+        uint64_t sum;
+        uint32_t histogram[HISTOGRAM_BUCKETS];
+
+        // Mean duration, 0 if never hit
+        uint32_t mean(void) const { return (count != 0) ? static_cast<uint32_t>(sum / count) : 0; }
+    };
+
+    void init(void);
+    void reset(void);
+    const ProbeStats &get_stats(Probe probe);
+
+    // Probe statistics, updated from the instrumented code
+    inline ProbeStats stats[static_cast<uint8_t>(Probe::COUNT)];
+
+#if defined(CONFIG_ZSPINLAB_PROFILING)
+    /**
+     * @brief Read the free-running cycle counter: DWT CYCCNT on Cortex-M, the kernel cycle counter on other Zephyr
+     * targets, the TSC on x86 hosts and a monotonic nanosecond clock elsewhere
+     *
+     * @return Counter value, wraps around
+     **/
+    inline uint32_t now(void)
+    {
+#if defined(CONFIG_CPU_CORTEX_M_HAS_DWT)
+        return *reinterpret_cast<volatile uint32_t *>(0xE0001004UL);
+#elif defined(__ZEPHYR__)
+        return k_cycle_get_32();
+#elif defined(__x86_64__) || defined(__i386__)
+        return static_cast<uint32_t>(__rdtsc());
+#else
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return static_cast<uint32_t>(ts.tv_sec * 1000000000ULL + ts.tv_nsec);
+#endif
+    }
+
+    /**
+     * @brief Account one measured duration to a probe
+     * @param[in] probe    Probe
+     * @param[in] duration Duration in counter ticks
+     *
+     * @return None
+     **/
+    inline void record(Probe probe, uint32_t duration)
+    {
+        ProbeStats &s = stats[static_cast<uint8_t>(probe)];
+
+        // Bucket index is the bit width of the duration
+        const uint8_t bucket = (duration != 0) ? static_cast<uint8_t>(32 - __builtin_clz(duration)) : 0;
+
+        s.min = (s.count == 0 || duration < s.min) ? duration : s.min;
+        s.max = (duration > s.max) ? duration : s.max;
+        s.sum += duration;
+        s.count++;
+        s.histogram[bucket]++;
+    }
+
+    // RAII probe, measures the enclosing scope
+    class ScopedProbe
+    {
+    public:
+        explicit ScopedProbe(Probe probe) : probe(probe), start(now()) {}
+        ~ScopedProbe(void) { record(probe, now() - start); }
+
+        ScopedProbe(const ScopedProbe &) = delete;
+        ScopedProbe &operator=(const ScopedProbe &) = delete;
+
+    private:
+        Probe probe;
+        uint32_t start;
+    };
+#endif
+
+} // namespace zspinlab::profiling
+
+// Profiling probes, compiled out (no code, no data access) unless CONFIG_ZSPINLAB_PROFILING is set
+#if defined(CONFIG_ZSPINLAB_PROFILING)
+#define ZSPINLAB_PROFILE_SCOPE(probe) \
+    zspinlab::profiling::ScopedProbe zspinlab_profile_scope_##probe(zspinlab::profiling::Probe::probe)
+#define ZSPINLAB_PROFILE_BEGIN(probe) const uint32_t zspinlab_profile_start_##probe = zspinlab::profiling::now()
+#define ZSPINLAB_PROFILE_END(probe) \
+    zspinlab::profiling::record(zspinlab::profiling::Probe::probe, zspinlab::profiling::now() - zspinlab_profile_start_##probe)
+#else
+#define ZSPINLAB_PROFILE_SCOPE(probe) \
+    do {                              \
+    } while (0)
+#define ZSPINLAB_PROFILE_BEGIN(probe) \
+    do {                              \
+    } while (0)
+#define ZSPINLAB_PROFILE_END(probe) \
+    do {                            \
+    } while (0)
+#endif
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace zspinlab::telemetry
+{
+    /*
+     * Wait-free single-producer/single-consumer ring buffer.
+     *
+     * The producer (an ISR) only writes head and the consumer (a thread) only writes tail, so both sides are wait-free
+     * and only need plain atomic loads and stores (no read-modify-write, also fine on Cortex-M0+). A full buffer drops
+     * the new element instead of overwriting, so an element is never read while it is being written.
+     *
+     * @tparam T Element type, should be trivially copyable
+     * @tparam N Capacity, must be a power of two
+     */
+    template <typename T, size_t N>
+    class RingBuffer
+    {
+        static_assert(N >= 2 && (N & (N - 1)) == 0, "Capacity must be a power of two");
+
+    public:
+        RingBuffer(void) : head(0), tail(0), dropped(0) {}
+
+        bool push(const T &item);
+        bool pop(T &item);
+
+        // Number of elements waiting to be read (consumer side)
+        size_t size(void) const { return head.load(std::memory_order_acquire) - tail.load(std::memory_order_relaxed); }
+
+        // Number of elements dropped because the buffer was full
+        uint32_t get_dropped(void) const { return dropped.load(std::memory_order_relaxed); }
+
+    private:
+        static constexpr uint32_t mask = N - 1;
+
+        T buffer[N];
+
+        std::atomic<uint32_t> head;     // Next slot to write, producer owned
+        std::atomic<uint32_t> tail;     // Next slot to read, consumer owned
+        std::atomic<uint32_t> dropped;  // Elements dropped on overflow, producer owned
+    };
+
+    /**
+     * @brief Append an element (producer side, wait-free)
+     * @param[in] item Element to append
+     *
+     * @return true if stored, false if the buffer was full and the element was dropped
+     **/
+    template <typename T, size_t N>
+    inline bool RingBuffer<T, N>::push(const T &item)
+    {
+        const uint32_t h = head.load(std::memory_order_relaxed);
+
+        if (h - tail.load(std::memory_order_acquire) >= N)
+        {
+            dropped.store(dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            return false;
+        }
+
+        buffer[h & mask] = item;
+        head.store(h + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    /**
+     * @brief Remove the oldest element (consumer side, wait-free)
+     * @param[out] item Removed element
+     *
+     * @return true if an element was read, false if the buffer was empty
+     **/
+    template <typename T, size_t N>
+    inline bool RingBuffer<T, N>::pop(T &item)
+    {
+        const uint32_t t = tail.load(std::memory_order_relaxed);
+
+        if (head.load(std::memory_order_acquire) == t)
+        {
+            return false;
+        }
+
+        item = buffer[t & mask];
+        tail.store(t + 1, std::memory_order_release);
+
+        return true;
+    }
+
+} // namespace zspinlab::telemetry
@@ -0,0 +1,71 @@
+#include "telemetry.hpp"
+
+namespace zspinlab::telemetry
+{
+    /**
+     * @brief Constructor, free-running capture, no decimation, disabled
+     **/
+    Telemetry::Telemetry(void) : enabled(false), state(FREE_RUN)
+    {
+        for (uint8_t i = 0; i < static_cast<uint8_t>(Source::COUNT); i++)
+        {
+            decimation[i].store(1, std::memory_order_relaxed);
+            decimation_count[i] = 0;
+            sequence[i] = 0;
+        }
+
+        trigger_source = 0;
+        trigger_channel = 0;
+        trigger_edge = TriggerEdge::RISING;
+        trigger_level = 0.0f;
+        trigger_prev = 0.0f;
+        trigger_remaining = 0;
+    }
+
+    /**
+     * @brief Set the decimation of one source
+     * @param[in] source     Probe source
+     * @param[in] decimation Record one probe call out of \p decimation (0 and 1 record every call)
+     *
+     * @return None
+     **/
+    void Telemetry::set_decimation(Source source, uint16_t decimation)
+    {
+        this->decimation[static_cast<uint8_t>(source)].store(decimation, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Arm a triggered capture. Nothing is recorded until the trigger signal crosses the level
+     * @param[in] source       Source of the trigger signal
+     * @param[in] channel      Index of the trigger signal in the source record
+     * @param[in] level        Trigger level
+     * @param[in] edge         Trigger edge
+     * @param[in] post_trigger Number of records (all sources) captured after the trigger
+     *
+     * @note Call with recording disabled, the configuration is not published atomically to the ISR.
+     *
+     * @return None
+     **/
+    void Telemetry::set_trigger(Source source, uint8_t channel, float level, TriggerEdge edge, uint32_t post_trigger)
+    {
+        trigger_source = static_cast<uint8_t>(source);
+        trigger_channel = channel;
+        trigger_level = level;
+        trigger_edge = edge;
+        trigger_prev = level;
+        trigger_remaining = post_trigger;
+
+        state.store(ARMED, std::memory_order_release);
+    }
+
+    /**
+     * @brief Go back to free-running capture
+     *
+     * @return None
+     **/
+    void Telemetry::clear_trigger(void)
+    {
+        state.store(FREE_RUN, std::memory_order_release);
+    }
+
+} // namespace zspinlab::telemetry
@@ -0,0 +1,231 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include "ring_buffer.hpp"
+
+// Number of records buffered between the ISR and the draining thread, must be a power of two
+#ifndef CONFIG_ZSPINLAB_TELEMETRY_RECORDS
+#define CONFIG_ZSPINLAB_TELEMETRY_RECORDS 256
+#endif
+
+namespace zspinlab::telemetry
+{
+    // Signal sources, one per probe point. The values are stored in the records: add new sources before COUNT only
+    enum class Source : uint8_t
+    {
+        CURRENT_CONTROLLER = 0, // Id, Iq, Vd, Vq, Va, Vb
+        SVPWM,                  // Va, Vb, dA, dB, dC
+        USER_0,                 // Free for application probes
+        USER_1,                 // Free for application probes
+        SPEED_CONTROLLER,       // Speed ref, speed, Iq ffwd, Iq ref
+        POSITION_CONTROLLER,    // Position ref, position, speed ffwd, speed ref
+        FLUX_OBSERVER,          // Flux alpha, flux beta, sin, cos, speed
+        CURRENT_REFERENCE,      // Torque ref, speed / Vdc, Id ref, Iq ref
+        COUNT,
+    };
+
+    // Edge of the trigger signal that starts a capture
+    enum class TriggerEdge : uint8_t
+    {
+        RISING,
+        FALLING,
+        BOTH,
+    };
+
+    // Number of values carried by one record
+    constexpr uint8_t RECORD_VALUES = 6;
+
+    // Fixed-size telemetry record, 32 bytes
+    struct Record
+    {
+        uint32_t sequence;              // Probe call counter of the source, counted before decimation
+        uint8_t source;                 // Source, see zspinlab::telemetry::Source
+        uint8_t count;                  // Number of valid entries in values
+        uint16_t reserved;
+        float values[RECORD_VALUES];    // Probed signals, in the order documented by the source
+    };
+
+    /*
+     * Telemetry recorder, streams probed signals from the control ISR to a low priority thread.
+     *
+     * record() is called from probe points in the ISR and only does a few compares and one 32 bytes copy into a
+     * wait-free SPSC ring buffer. read() is called from the draining thread. Every source can be decimated
+     * independently, and a capture can be started by a level crossing of one probed signal.
+     */
+    class Telemetry
+    {
+    public:
+        Telemetry(void);
+
+        // Enable/disable recording
+        void enable(bool enabled) { this->enabled.store(enabled, std::memory_order_relaxed); }
+
+        void set_decimation(Source source, uint16_t decimation);
+
+        void set_trigger(Source source, uint8_t channel, float level, TriggerEdge edge, uint32_t post_trigger);
+        void clear_trigger(void);
+
+        // Check if an armed trigger has fired
+        bool is_triggered(void) { return state.load(std::memory_order_relaxed) >= TRIGGERED; }
+
+        void record(Source source, const float *values, uint8_t count);
+
+        // Read the oldest record, from the draining thread. Returns false when empty
+        bool read(Record &record) { return ring.pop(record); }
+
+        // Number of records dropped because the draining thread did not keep up
+        uint32_t get_dropped(void) const { return ring.get_dropped(); }
+
+    private:
+        enum : uint8_t
+        {
+            FREE_RUN,   // Record everything
+            ARMED,      // Wait for the trigger condition
+            TRIGGERED,  // Record post_trigger records
+            DONE,       // Capture complete
+        };
+
+        RingBuffer<Record, CONFIG_ZSPINLAB_TELEMETRY_RECORDS> ring;
+
+        std::atomic<bool> enabled;
+        std::atomic<uint8_t> state;
+
+        // Decimation, per source
+        std::atomic<uint16_t> decimation[static_cast<uint8_t>(Source::COUNT)];
+        uint16_t decimation_count[static_cast<uint8_t>(Source::COUNT)];
+        uint32_t sequence[static_cast<uint8_t>(Source::COUNT)];
+
+        // Trigger configuration
+        uint8_t trigger_source;
+        uint8_t trigger_channel;
+        TriggerEdge trigger_edge;
+        float trigger_level;
+        float trigger_prev;
+        uint32_t trigger_remaining;
+    };
+
+    /**
+     * @brief Record one sample of a source, called from the probe points in the ISR
+     * @param[in] source Probe source
+     * @param[in] values Probed signals
+     * @param[in] count  Number of probed signals, extra values beyond RECORD_VALUES are ignored
+     *
+     * @return None
+     **/
+    inline void Telemetry::record(Source source, const float *values, uint8_t count)
+    {
+        const uint8_t idx = static_cast<uint8_t>(source);
+
+        if (!enabled.load(std::memory_order_relaxed))
+        {
+            return;
+        }
+
+        const uint32_t seq = sequence[idx]++;
+
+        if (++decimation_count[idx] < decimation[idx].load(std::memory_order_relaxed))
+        {
+            return;
+        }
+        decimation_count[idx] = 0;
+
+        switch (state.load(std::memory_order_relaxed))
+        {
+        case ARMED:
+        {
+            if (idx != trigger_source || trigger_channel >= count)
+            {
+                return;
+            }
+
+            const float now = values[trigger_channel];
+            const bool rising = (trigger_prev < trigger_level) && (now >= trigger_level);
+            const bool falling = (trigger_prev > trigger_level) && (now <= trigger_level);
+
+            trigger_prev = now;
+
+            if (!((trigger_edge != TriggerEdge::FALLING && rising) || (trigger_edge != TriggerEdge::RISING && falling)))
+            {
+                return;
+            }
+
+            state.store(TRIGGERED, std::memory_order_relaxed);
+            break;
+        }
+        case TRIGGERED:
+            if (trigger_remaining == 0)
+            {
+                state.store(DONE, std::memory_order_relaxed);
+                return;
+            }
+            trigger_remaining--;
+            break;
+
+        case DONE:
+            return;
+
+        default:
+            break;
+        }
+
+        Record rec;
+
+        rec.sequence = seq;
+        rec.source = idx;
+        rec.count = (count < RECORD_VALUES) ? count : RECORD_VALUES;
+        rec.reserved = 0;
+
+        for (uint8_t i = 0; i < RECORD_VALUES; i++)
+        {
+            rec.values[i] = (i < rec.count) ? values[i] : 0.0f;
+        }
+
+        (void)ring.push(rec);
+    }
+
+    // Recorder fed by the library probe points
+    inline std::atomic<Telemetry *> active_telemetry{nullptr};
+
+    /**
+     * @brief Attach the recorder fed by the library probe points
+     * @param[in] telemetry Recorder, nullptr to detach
+     *
+     * @return None
+     **/
+    inline void attach(Telemetry *telemetry)
+    {
+        active_telemetry.store(telemetry, std::memory_order_release);
+    }
+
+    /**
+     * @brief Send signals to the attached recorder, if any
+     * @param[in] source Probe source
+     * @param[in] values Probed signals, any type convertible to float
+     *
+     * @return None
+     **/
+    template <typename... Args>
+    inline void probe(Source source, Args... values)
+    {
+        Telemetry *telemetry = active_telemetry.load(std::memory_order_acquire);
+
+        if (telemetry != nullptr)
+        {
+            const float v[] = {static_cast<float>(values)...};
+            telemetry->record(source, v, sizeof...(Args));
+        }
+    }
+
+} // namespace zspinlab::telemetry
+
+// Probe point, compiled out unless CONFIG_ZSPINLAB_TELEMETRY is set
+#if defined(CONFIG_ZSPINLAB_TELEMETRY)
+#define ZSPINLAB_TELEMETRY_PROBE(source, ...) \
+    zspinlab::telemetry::probe(zspinlab::telemetry::Source::source, __VA_ARGS__)
+#else
+#define ZSPINLAB_TELEMETRY_PROBE(source, ...) \
+    do {                                      \
+    } while (0)
+#endif